@@ -0,0 +1,82 @@
+//
+// Copyright 2020 WebAssembly Community Group participants
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//     http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+//
+
+#include "bench/alloc_counter.h"
+
+#include <atomic>
+#include <cstddef>
+#include <cstdlib>
+#include <new>
+
+namespace wasp::bench {
+
+namespace {
+
+// The size of each block is stored in a header in front of it, so that
+// operator delete can track the number of live bytes.
+constexpr size_t kHeaderSize = alignof(std::max_align_t);
+
+std::atomic<u64> g_allocations{0};
+std::atomic<u64> g_live_bytes{0};
+std::atomic<u64> g_peak_bytes{0};
+
+}  // namespace
+
+u64 GetAllocationCount() {
+  return g_allocations;
+}
+
+u64 GetLiveBytes() {
+  return g_live_bytes;
+}
+
+u64 GetPeakBytes() {
+  return g_peak_bytes;
+}
+
+void ResetPeakBytes() {
+  g_peak_bytes = g_live_bytes.load();
+}
+
+}  // namespace wasp::bench
+
+using namespace ::wasp::bench;
+
+void* operator new(size_t size) {
+  auto* block = static_cast<char*>(std::malloc(size + kHeaderSize));
+  if (!block) {
+    throw std::bad_alloc{};
+  }
+  *reinterpret_cast<size_t*>(block) = size;
+  ++g_allocations;
+  wasp::u64 live = g_live_bytes += size;
+  wasp::u64 peak = g_peak_bytes.load();
+  while (live > peak && !g_peak_bytes.compare_exchange_weak(peak, live)) {
+  }
+  return block + kHeaderSize;
+}
+
+void operator delete(void* ptr) noexcept {
+  if (ptr) {
+    auto* block = static_cast<char*>(ptr) - kHeaderSize;
+    g_live_bytes -= *reinterpret_cast<size_t*>(block);
+    std::free(block);
+  }
+}
+
+void operator delete(void* ptr, size_t) noexcept {
+  operator delete(ptr);
+}
@@ -0,0 +1,47 @@
+//
+// Copyright 2020 WebAssembly Community Group participants
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//     http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+//
+
+#ifndef WASP_BENCH_ALLOC_COUNTER_H_
+#define WASP_BENCH_ALLOC_COUNTER_H_
+
+#include "wasp/base/types.h"
+
+namespace wasp::bench {
+
+// Linking alloc_counter.cc into a benchmark replaces the global operator new
+// and operator delete with versions that keep these counters.
+u64 GetAllocationCount();
+u64 GetLiveBytes();
+u64 GetPeakBytes();
+void ResetPeakBytes();
+
+struct AllocStats {
+  u64 allocations;
+  u64 peak_bytes;  // Above what was live when counting started.
+};
+
+template <typename F>
+AllocStats CountAllocs(F&& func) {
+  u64 base = GetLiveBytes();
+  u64 allocations = GetAllocationCount();
+  ResetPeakBytes();
+  func();
+  return AllocStats{GetAllocationCount() - allocations, GetPeakBytes() - base};
+}
+
+}  // namespace wasp::bench
+
+#endif  // WASP_BENCH_ALLOC_COUNTER_H_
@@ -0,0 +1,75 @@
+//
+// Copyright 2020 WebAssembly Community Group participants
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//     http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+//
+
+#ifndef WASP_BENCH_BENCH_UTILS_H_
+#define WASP_BENCH_BENCH_UTILS_H_
+
+#include <chrono>
+
+#include "absl/strings/str_format.h"
+
+#include "wasp/base/span.h"
+#include "wasp/base/string_view.h"
+#include "wasp/base/types.h"
+
+namespace wasp::bench {
+
+using Seconds = std::chrono::duration<double>;
+
+// Prevents the compiler from optimizing away a computed value.
+template <typename T>
+void DoNotOptimize(const T& value) {
+#if defined(__GNUC__) || defined(__clang__)
+  asm volatile("" : : "g"(&value) : "memory");
+#else
+  static const void* volatile sink;
+  sink = &value;
+#endif
+}
+
+// Calls `func` repeatedly for at least `min_time`, and returns the mean time
+// of a single call.
+template <typename F>
+Seconds TimeIt(F&& func, Seconds min_time = Seconds{0.5}) {
+  using Clock = std::chrono::steady_clock;
+  func();  // Warm up.
+
+  u64 iterations = 0;
+  auto start = Clock::now();
+  Seconds elapsed{};
+  do {
+    func();
+    ++iterations;
+    elapsed = Clock::now() - start;
+  } while (elapsed < min_time);
+  return elapsed / iterations;
+}
+
+// Prints one line of results: the time per call, the time per item, and the
+// throughput in MB/s.
+inline void Report(string_view name,
+                   Seconds time,
+                   u64 items,
+                   string_view item_name,
+                   u64 bytes) {
+  absl::PrintF("%-40s %10.3f ms %8.2f ns/%s %8.1f MB/s\n", name,
+               time.count() * 1e3, time.count() * 1e9 / items, item_name,
+               bytes / time.count() / 1e6);
+}
+
+}  // namespace wasp::bench
+
+#endif  // WASP_BENCH_BENCH_UTILS_H_
@@ -0,0 +1,119 @@
+//
+// Copyright 2020 WebAssembly Community Group participants
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//     http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+//
+
+// Measures converting a text module to binary with convert::ToBinary, and
+// back to text with convert::ToText: the time taken and the number of heap
+// allocations.
+//
+// Usage: wasp_convert_bench [<filenames...>]
+//
+// With no arguments, a synthetic module with 100000 imports, exports and
+// data segments is converted instead.
+
+#include <string>
+
+#include "bench/alloc_counter.h"
+#include "bench/bench_utils.h"
+#include "wasp/base/errors_nop.h"
+#include "wasp/base/features.h"
+#include "wasp/base/file.h"
+#include "wasp/convert/to_binary.h"
+#include "wasp/convert/to_text.h"
+#include "wasp/text/desugar.h"
+#include "wasp/text/read.h"
+#include "wasp/text/read/read_ctx.h"
+#include "wasp/text/read/tokenizer.h"
+#include "wasp/text/resolve.h"
+
+using namespace ::wasp;
+using namespace ::wasp::bench;
+
+namespace {
+
+// Every import comes from the same module, and every function is exported
+// under its own name, so there are many short (and some repeated) names.
+std::string MakeModuleText(Index count) {
+  std::string text = "(module\n";
+  for (Index i = 0; i < count; ++i) {
+    absl::StrAppendFormat(
+        &text, "  (import \"env\" \"imported_function_%u\" (func))\n", i);
+  }
+  text += "  (memory 1)\n";
+  for (Index i = 0; i < count; ++i) {
+    absl::StrAppendFormat(&text,
+                          "  (func (export \"exported_function_%u\"))\n"
+                          "  (data (i32.const %u) \"segment\\%02x\")\n",
+                          i, i, i & 0xff);
+  }
+  text += ")\n";
+  return text;
+}
+
+template <typename F>
+void Run(const std::string& name, size_t size, F&& convert) {
+  auto time = TimeIt(convert);
+  auto stats = CountAllocs(convert);
+  absl::PrintF("%-40s %10.3f ms %8.1f MB/s %10u allocs\n", name,
+               time.count() * 1e3, size / time.count() / 1e6,
+               stats.allocations);
+}
+
+void Compare(const std::string& name, SpanU8 data) {
+  Features features;
+  ErrorsNop errors;
+
+  text::Tokenizer tokenizer{data};
+  text::ReadCtx read_ctx{features, errors};
+  auto text_module =
+      text::ReadSingleModule(tokenizer, read_ctx).value_or(text::Module{});
+  text::Resolve(text_module, errors);
+  text::Desugar(text_module);
+
+  Run(name + " (ToBinary)", data.size(), [&]() {
+    convert::BinCtx ctx{features};
+    auto module = convert::ToBinary(ctx, text_module);
+    DoNotOptimize(module);
+  });
+
+  convert::BinCtx bin_ctx{features};
+  auto binary_module = convert::ToBinary(bin_ctx, text_module);
+  Run(name + " (ToText)", data.size(), [&]() {
+    convert::TextCtx ctx;
+    auto module = convert::ToText(ctx, binary_module);
+    DoNotOptimize(module);
+  });
+}
+
+}  // namespace
+
+int main(int argc, char** argv) {
+  if (argc <= 1) {
+    auto text = MakeModuleText(100000);
+    Compare("synthetic module", SpanU8{reinterpret_cast<const u8*>(text.data()),
+                                       text.size()});
+    return 0;
+  }
+
+  for (int i = 1; i < argc; ++i) {
+    auto optbuf = ReadFile(argv[i]);
+    if (!optbuf) {
+      absl::FPrintF(stderr, "Error reading file %s.\n", argv[i]);
+      continue;
+    }
+    Compare(argv[i], *optbuf);
+  }
+  return 0;
+}
@@ -0,0 +1,145 @@
+//
+// Copyright 2020 WebAssembly Community Group participants
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//     http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+//
+
+// Measures the throughput of the text lexer.
+//
+// Usage: wasp_lex_bench [<filenames...>]
+//
+// With no arguments, a large synthetic module and a long run of instructions
+// are lexed. Otherwise, each of the given .wat or .wast files is lexed, e.g.
+// the spec testsuite:
+//
+//   wasp_lex_bench third_party/testsuite/*.wast
+//
+// To compare the two ways of recognizing keywords, build once with each
+// setting of WASP_PERFECT_HASH_KEYWORDS.
+
+#include <iterator>
+#include <random>
+#include <string>
+
+#include "bench/bench_utils.h"
+#include "wasp/base/file.h"
+#include "wasp/text/read/lex.h"
+
+using namespace ::wasp;
+using namespace ::wasp::bench;
+
+namespace {
+
+// A module in the style of a generated .wat file: indented function bodies
+// with comments, and data segments with long string literals.
+std::string MakeModuleText(Index count) {
+  std::mt19937 rng{0};
+  std::string text = "(module\n";
+  for (Index i = 0; i < count; ++i) {
+    absl::StrAppendFormat(&text,
+                          "  ;; Function %u.\n"
+                          "  (func $f%u (param $p i32) (result i32)\n"
+                          "    (local $l i32)\n"
+                          "    local.get $p\n"
+                          "    i32.const %u\n"
+                          "    i32.add\n"
+                          "    (; spill ;) local.tee $l\n"
+                          "    call $f%u)\n",
+                          i, i, rng(), rng() % count);
+    if (i % 8 == 0) {
+      absl::StrAppendFormat(&text, "  (data (i32.const %u) \"", i * 64);
+      for (int j = 0; j < 64; ++j) {
+        u32 c = rng() % 128;
+        if (c < 32 || c == '"' || c == '\\' || c == 127) {
+          absl::StrAppendFormat(&text, "\\%02x", c);
+        } else {
+          text += static_cast<char>(c);
+        }
+      }
+      text += "\")\n";
+    }
+  }
+  text += ")\n";
+  return text;
+}
+
+// A single function body made of plain instructions, mostly keywords.
+std::string MakeInstructionText(Index count) {
+  static const char* const kInstructions[] = {
+      "local.get 0",     "local.set 1",       "local.tee 2",
+      "global.get 0",    "i32.const 1",       "i64.const 2",
+      "f32.const 1.5",   "i32.add",           "i32.sub",
+      "i32.mul",         "i32.and",           "i32.shl",
+      "i32.eqz",         "i32.lt_u",          "i64.add",
+      "i64.extend_i32_u", "f64.mul",          "f32.convert_i32_s",
+      "i32.load offset=4", "i32.store offset=8 align=4", "i64.load8_u",
+      "call 3",          "br_if 0",           "br 1",
+      "block",           "loop",              "end",
+      "drop",            "select",            "return",
+      "memory.size",     "v128.load",         "i32x4.add",
+      "i8x16.shuffle 0 1 2 3 4 5 6 7 8 9 10 11 12 13 14 15",
+  };
+  std::mt19937 rng{0};
+  std::string text = "(func\n";
+  for (Index i = 0; i < count; ++i) {
+    text += "  ";
+    text += kInstructions[rng() % std::size(kInstructions)];
+    text += "\n";
+  }
+  text += ")\n";
+  return text;
+}
+
+u64 LexAll(SpanU8 data) {
+  u64 count = 0;
+  while (true) {
+    auto token = text::Lex(&data);
+    if (token.type == text::TokenType::Eof) {
+      break;
+    }
+    DoNotOptimize(token);
+    ++count;
+  }
+  return count;
+}
+
+void Run(string_view name, SpanU8 data) {
+  u64 count = 0;
+  auto time = TimeIt([&]() { count = LexAll(data); });
+  Report(name, time, count, "token", data.size());
+}
+
+}  // namespace
+
+int main(int argc, char** argv) {
+  if (argc <= 1) {
+    auto text = MakeModuleText(100000);
+    Run("synthetic module",
+        SpanU8{reinterpret_cast<const u8*>(text.data()), text.size()});
+
+    text = MakeInstructionText(1000000);
+    Run("synthetic instructions",
+        SpanU8{reinterpret_cast<const u8*>(text.data()), text.size()});
+    return 0;
+  }
+
+  for (int i = 1; i < argc; ++i) {
+    auto optbuf = ReadFile(argv[i]);
+    if (!optbuf) {
+      absl::FPrintF(stderr, "Error reading file %s.\n", argv[i]);
+      continue;
+    }
+    Run(argv[i], *optbuf);
+  }
+  return 0;
+}
@@ -0,0 +1,138 @@
+//
+// Copyright 2020 WebAssembly Community Group participants
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//     http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+//
+
+// Measures how long it takes to parse float literals.
+//
+// Usage: wasp_numeric_bench [<filenames...>]
+//
+// With no arguments, synthetic sets of literals are parsed. Otherwise, the
+// float literals in each of the given .wat or .wast files are parsed, as both
+// f32 and f64.
+
+#include <random>
+#include <string>
+#include <vector>
+
+#include "bench/bench_utils.h"
+#include "wasp/base/file.h"
+#include "wasp/text/numeric.h"
+#include "wasp/text/read/lex.h"
+
+using namespace ::wasp;
+using namespace ::wasp::text;
+using namespace ::wasp::bench;
+
+namespace {
+
+struct Literal {
+  LiteralInfo info;
+  SpanU8 span;
+};
+
+template <typename T>
+void Run(string_view name, const std::vector<Literal>& literals) {
+  u64 bytes = 0;
+  for (auto&& literal : literals) {
+    bytes += literal.span.size();
+  }
+  auto time = TimeIt([&]() {
+    for (auto&& literal : literals) {
+      auto value = StrToFloat<T>(literal.info, literal.span);
+      DoNotOptimize(value);
+    }
+  });
+  Report(name, time, literals.size(), "literal", bytes);
+}
+
+// Lexes `data` and keeps the Float tokens, e.g. from f32.const or from the
+// lanes of v128.const.
+std::vector<Literal> LexFloats(SpanU8 data) {
+  std::vector<Literal> literals;
+  while (true) {
+    auto token = Lex(&data);
+    if (token.type == TokenType::Eof) {
+      break;
+    }
+    if (token.type == TokenType::Float) {
+      literals.push_back({token.literal_info(), token.span_u8()});
+    }
+  }
+  return literals;
+}
+
+// Space-separated decimal literals, e.g. "%#.9g". The format must always
+// include a '.' or exponent, so the literals are lexed as floats.
+std::string MakeDecimals(Index count, const char* format) {
+  std::mt19937_64 rng{0};
+  std::uniform_real_distribution<f64> dist{-1e6, 1e6};
+  std::string text;
+  for (Index i = 0; i < count; ++i) {
+    absl::StrAppendFormat(&text, format, dist(rng));
+    text += ' ';
+  }
+  return text;
+}
+
+std::string MakeHexes(Index count) {
+  std::mt19937_64 rng{0};
+  std::uniform_real_distribution<f64> dist{-1e6, 1e6};
+  std::string text;
+  for (Index i = 0; i < count; ++i) {
+    text += FloatToStr(dist(rng), Base::Hex);
+    text += ' ';
+  }
+  return text;
+}
+
+SpanU8 ToSpanU8(const std::string& str) {
+  return SpanU8{reinterpret_cast<const u8*>(str.data()), str.size()};
+}
+
+}  // namespace
+
+int main(int argc, char** argv) {
+  if (argc <= 1) {
+    auto text = MakeDecimals(100000, "%.2f");
+    auto literals = LexFloats(ToSpanU8(text));
+    Run<f32>("short decimals (f32)", literals);
+    Run<f64>("short decimals (f64)", literals);
+
+    text = MakeDecimals(100000, "%#.9g");
+    Run<f32>("9-digit decimals (f32)", LexFloats(ToSpanU8(text)));
+
+    text = MakeDecimals(100000, "%#.17g");
+    Run<f64>("17-digit decimals (f64)", LexFloats(ToSpanU8(text)));
+
+    text = MakeDecimals(100000, "%.30e");
+    Run<f64>("31-digit decimals (f64)", LexFloats(ToSpanU8(text)));
+
+    text = MakeHexes(100000);
+    Run<f64>("hex (f64)", LexFloats(ToSpanU8(text)));
+    return 0;
+  }
+
+  for (int i = 1; i < argc; ++i) {
+    auto optbuf = ReadFile(argv[i]);
+    if (!optbuf) {
+      absl::FPrintF(stderr, "Error reading file %s.\n", argv[i]);
+      continue;
+    }
+    auto literals = LexFloats(*optbuf);
+    Run<f32>(absl::StrFormat("%s (f32)", argv[i]), literals);
+    Run<f64>(absl::StrFormat("%s (f64)", argv[i]), literals);
+  }
+  return 0;
+}
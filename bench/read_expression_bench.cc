@@ -0,0 +1,146 @@
+//
+// Copyright 2020 WebAssembly Community Group participants
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//     http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+//
+
+// Measures how long it takes to decode instructions with ReadExpression and
+// ReadPackedExpression.
+//
+// Usage: wasp_read_expression_bench [<filenames...>]
+//
+// With no arguments, a sequence of LEB128 values and a synthetic function
+// body are decoded. Otherwise, every
+// function body in the given modules is decoded.
+
+#include <random>
+#include <vector>
+
+#include "bench/bench_utils.h"
+#include "bench/synthetic.h"
+#include "wasp/base/buffer.h"
+#include "wasp/base/errors_nop.h"
+#include "wasp/base/features.h"
+#include "wasp/base/file.h"
+#include "wasp/binary/lazy_expression.h"
+#include "wasp/binary/lazy_module.h"
+#include "wasp/binary/packed_expression.h"
+#include "wasp/binary/read.h"
+#include "wasp/binary/read/read_ctx.h"
+#include "wasp/binary/sections.h"
+
+using namespace ::wasp;
+using namespace ::wasp::binary;
+using namespace ::wasp::bench;
+
+namespace {
+
+// A sequence of u32 LEB128 values with a mix of encoded lengths.
+Buffer MakeVarInts(Index count) {
+  std::mt19937 rng{0};
+  Buffer buffer;
+  for (Index i = 0; i < count; ++i) {
+    AppendU32(buffer, rng() >> (rng() % 32));
+  }
+  return buffer;
+}
+
+u64 DecodeVarInts(SpanU8 data, ReadCtx& ctx) {
+  u64 count = 0;
+  while (!data.empty()) {
+    auto value = Read<u32>(&data, ctx);
+    DoNotOptimize(value);
+    ++count;
+  }
+  return count;
+}
+
+u64 DecodeExpression(SpanU8 data, ReadCtx& ctx) {
+  u64 count = 0;
+  for (const auto& instr : ReadExpression(data, ctx)) {
+    DoNotOptimize(instr);
+    ++count;
+  }
+  return count;
+}
+
+u64 DecodePackedExpression(SpanU8 data,
+                           ReadCtx& ctx,
+                           PackedExpression& expr) {
+  ReadPackedExpression(data, ctx, &expr);
+  DoNotOptimize(expr);
+  return expr.instructions.size();
+}
+
+u64 DecodeModule(SpanU8 data,
+                 const Features& features,
+                 Errors& errors,
+                 PackedExpression* packed) {
+  u64 count = 0;
+  auto module = ReadLazyModule(data, features, errors);
+  for (auto section : module.sections) {
+    if (section->is_known() && section->known()->id == SectionId::Code) {
+      auto sec = ReadCodeSection(section->known(), module.ctx);
+      for (const auto& code : sec.sequence) {
+        count += packed ? DecodePackedExpression(code->body->data, module.ctx,
+                                                 *packed)
+                        : DecodeExpression(code->body->data, module.ctx);
+      }
+    }
+  }
+  return count;
+}
+
+}  // namespace
+
+int main(int argc, char** argv) {
+  Features features;
+  ErrorsNop errors;
+
+  if (argc <= 1) {
+    ReadCtx ctx{features, errors};
+    u64 count = 0;
+
+    auto varints = MakeVarInts(1000000);
+    auto time = TimeIt([&]() { count = DecodeVarInts(varints, ctx); });
+    Report("u32 varints", time, count, "value", varints.size());
+
+    auto expr = MakeExpression(1000000);
+    time = TimeIt([&]() { count = DecodeExpression(expr, ctx); });
+    Report("synthetic expression", time, count, "instr", expr.size());
+
+    PackedExpression packed;
+    time = TimeIt([&]() { count = DecodePackedExpression(expr, ctx, packed); });
+    Report("synthetic expression (packed)", time, count, "instr", expr.size());
+    return 0;
+  }
+
+  for (int i = 1; i < argc; ++i) {
+    auto optbuf = ReadFile(argv[i]);
+    if (!optbuf) {
+      absl::FPrintF(stderr, "Error reading file %s.\n", argv[i]);
+      continue;
+    }
+    u64 count = 0;
+    auto time = TimeIt(
+        [&]() { count = DecodeModule(*optbuf, features, errors, nullptr); });
+    Report(argv[i], time, count, "instr", optbuf->size());
+
+    PackedExpression packed;
+    time = TimeIt(
+        [&]() { count = DecodeModule(*optbuf, features, errors, &packed); });
+    Report(absl::StrFormat("%s (packed)", argv[i]), time, count, "instr",
+           optbuf->size());
+  }
+  return 0;
+}
@@ -0,0 +1,94 @@
+//
+// Copyright 2020 WebAssembly Community Group participants
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//     http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+//
+
+// Compares reading a whole module with ReadModule (on one and four threads)
+// and ReadPackedModule: the time to read and destroy it, the number of heap
+// allocations, and the peak number of live heap bytes.
+//
+// Usage: wasp_read_module_bench [<filenames...>]
+//
+// With no arguments, a synthetic module is read instead.
+
+#include <string>
+
+#include "bench/alloc_counter.h"
+#include "bench/bench_utils.h"
+#include "bench/synthetic.h"
+#include "wasp/base/buffer.h"
+#include "wasp/base/errors_nop.h"
+#include "wasp/base/features.h"
+#include "wasp/base/file.h"
+#include "wasp/binary/packed_module.h"
+#include "wasp/binary/read.h"
+#include "wasp/binary/read/read_ctx.h"
+
+using namespace ::wasp;
+using namespace ::wasp::binary;
+using namespace ::wasp::bench;
+
+namespace {
+
+template <typename F>
+void Run(const std::string& name, SpanU8 data, F&& read) {
+  auto time = TimeIt(read);
+  auto stats = CountAllocs(read);
+  absl::PrintF("%-40s %10.3f ms %8.1f MB/s %10u allocs %8.1f MiB peak heap\n",
+               name, time.count() * 1e3, data.size() / time.count() / 1e6,
+               stats.allocations, stats.peak_bytes / (1024.0 * 1024.0));
+}
+
+void Compare(const std::string& name, SpanU8 data) {
+  Features features;
+  ErrorsNop errors;
+
+  Run(name + " (ReadModule)", data, [&]() {
+    ReadCtx ctx{features, errors};
+    auto module = ReadModule(data, ctx);
+    DoNotOptimize(module);
+  });
+
+  Run(name + " (ReadModule, 4 threads)", data, [&]() {
+    ReadCtx ctx{features, errors};
+    auto module = ReadModule(data, ctx, 4);
+    DoNotOptimize(module);
+  });
+
+  Run(name + " (ReadPackedModule)", data, [&]() {
+    ReadCtx ctx{features, errors};
+    auto module = ReadPackedModule(data, ctx);
+    DoNotOptimize(module);
+  });
+}
+
+}  // namespace
+
+int main(int argc, char** argv) {
+  if (argc <= 1) {
+    auto module = MakeModule(2000, 500);
+    Compare("synthetic module", module);
+    return 0;
+  }
+
+  for (int i = 1; i < argc; ++i) {
+    auto optbuf = ReadFile(argv[i]);
+    if (!optbuf) {
+      absl::FPrintF(stderr, "Error reading file %s.\n", argv[i]);
+      continue;
+    }
+    Compare(argv[i], *optbuf);
+  }
+  return 0;
+}
@@ -0,0 +1,103 @@
+//
+// Copyright 2020 WebAssembly Community Group participants
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//     http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+//
+
+// Measures how long it takes to resolve the names in a text module.
+//
+// Usage: wasp_resolve_bench [<filenames...>]
+//
+// With no arguments, a synthetic module with 100000 functions and 100000
+// globals, all referenced by name, is resolved instead.
+
+#include <random>
+#include <string>
+
+#include "bench/bench_utils.h"
+#include "wasp/base/errors_nop.h"
+#include "wasp/base/features.h"
+#include "wasp/base/file.h"
+#include "wasp/text/read.h"
+#include "wasp/text/read/read_ctx.h"
+#include "wasp/text/read/tokenizer.h"
+#include "wasp/text/resolve.h"
+
+using namespace ::wasp;
+using namespace ::wasp::bench;
+
+namespace {
+
+// Each function reads a random global and calls a random function, by name.
+std::string MakeModuleText(Index count) {
+  std::mt19937 rng{0};
+  std::string text = "(module\n";
+  for (Index i = 0; i < count; ++i) {
+    absl::StrAppendFormat(&text, "  (global $g%u i32 (i32.const %u))\n", i, i);
+  }
+  for (Index i = 0; i < count; ++i) {
+    absl::StrAppendFormat(&text,
+                          "  (func $f%u (param $p i32) (result i32)\n"
+                          "    local.get $p\n"
+                          "    global.get $g%u\n"
+                          "    call $f%u\n"
+                          "    i32.add)\n",
+                          i, rng() % count, rng() % count);
+  }
+  text += ")\n";
+  return text;
+}
+
+void Run(const std::string& name, SpanU8 data) {
+  Features features;
+  ErrorsNop errors;
+
+  auto read = [&]() {
+    text::Tokenizer tokenizer{data};
+    text::ReadCtx ctx{features, errors};
+    return text::ReadSingleModule(tokenizer, ctx).value_or(text::Module{});
+  };
+
+  auto module = read();
+  auto time = TimeIt([&]() {
+    auto copy = module;
+    text::Resolve(copy, errors);
+    DoNotOptimize(copy);
+  });
+  auto copy_time = TimeIt([&]() {
+    auto copy = module;
+    DoNotOptimize(copy);
+  });
+  Report(name, time - copy_time, module.size(), "item", data.size());
+}
+
+}  // namespace
+
+int main(int argc, char** argv) {
+  if (argc <= 1) {
+    auto text = MakeModuleText(100000);
+    Run("synthetic module",
+        SpanU8{reinterpret_cast<const u8*>(text.data()), text.size()});
+    return 0;
+  }
+
+  for (int i = 1; i < argc; ++i) {
+    auto optbuf = ReadFile(argv[i]);
+    if (!optbuf) {
+      absl::FPrintF(stderr, "Error reading file %s.\n", argv[i]);
+      continue;
+    }
+    Run(argv[i], *optbuf);
+  }
+  return 0;
+}
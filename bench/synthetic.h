@@ -0,0 +1,132 @@
+//
+// Copyright 2020 WebAssembly Community Group participants
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//     http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+//
+
+#ifndef WASP_BENCH_SYNTHETIC_H_
+#define WASP_BENCH_SYNTHETIC_H_
+
+#include <random>
+
+#include "wasp/base/buffer.h"
+#include "wasp/base/span.h"
+#include "wasp/base/types.h"
+
+namespace wasp::bench {
+
+inline void AppendU32(Buffer& buffer, u32 value) {
+  do {
+    u8 byte = value & 0x7f;
+    value >>= 7;
+    buffer.push_back(byte | (value ? 0x80 : 0));
+  } while (value);
+}
+
+inline void AppendS32(Buffer& buffer, s32 value) {
+  for (bool more = true; more;) {
+    u8 byte = value & 0x7f;
+    value >>= 7;
+    more = !((value == 0 && !(byte & 0x40)) || (value == -1 && (byte & 0x40)));
+    buffer.push_back(byte | (more ? 0x80 : 0));
+  }
+}
+
+inline void AppendBytes(Buffer& buffer, SpanU8 bytes) {
+  buffer.insert(buffer.end(), bytes.begin(), bytes.end());
+}
+
+// A straight-line function body with a typical mix of instructions and
+// immediate sizes. The body is well-formed, but not necessarily valid.
+inline Buffer MakeExpression(Index count, u32 seed = 0) {
+  std::mt19937 rng{seed};
+  Buffer buffer;
+  for (Index i = 0; i < count; ++i) {
+    switch (rng() % 6) {
+      case 0:  // local.get
+        buffer.push_back(0x20);
+        AppendU32(buffer, rng() % 8);
+        break;
+
+      case 1:  // local.set
+        buffer.push_back(0x21);
+        AppendU32(buffer, rng() % 200);
+        break;
+
+      case 2:  // i32.const
+        buffer.push_back(0x41);
+        AppendS32(buffer, static_cast<s32>(rng() >> (rng() % 32)));
+        break;
+
+      case 3:  // i32.add
+        buffer.push_back(0x6a);
+        break;
+
+      case 4:  // i32.load
+        buffer.push_back(0x28);
+        AppendU32(buffer, 2);
+        AppendU32(buffer, rng() % 5000);
+        break;
+
+      case 5:  // call
+        buffer.push_back(0x10);
+        AppendU32(buffer, rng() % 20000);
+        break;
+    }
+  }
+  buffer.push_back(0x0b);  // end
+  return buffer;
+}
+
+inline void AppendSection(Buffer& buffer, u8 id, const Buffer& contents) {
+  buffer.push_back(id);
+  AppendU32(buffer, static_cast<u32>(contents.size()));
+  AppendBytes(buffer, contents);
+}
+
+// A module with `function_count` functions of type [] -> [], each with one
+// group of locals and a MakeExpression body of `instr_count` instructions.
+inline Buffer MakeModule(Index function_count, Index instr_count) {
+  Buffer module;
+  AppendBytes(module, SpanU8{reinterpret_cast<const u8*>("\0asm\1\0\0\0"), 8});
+
+  Buffer types;
+  AppendU32(types, 1);
+  AppendBytes(types, SpanU8{reinterpret_cast<const u8*>("\x60\0\0"), 3});
+  AppendSection(module, 1, types);
+
+  Buffer functions;
+  AppendU32(functions, function_count);
+  for (Index i = 0; i < function_count; ++i) {
+    AppendU32(functions, 0);
+  }
+  AppendSection(module, 3, functions);
+
+  Buffer codes;
+  AppendU32(codes, function_count);
+  for (Index i = 0; i < function_count; ++i) {
+    Buffer body;
+    AppendU32(body, 1);    // One group of locals...
+    AppendU32(body, 200);  // ...with 200...
+    body.push_back(0x7f);  // ...i32s.
+    AppendBytes(body, MakeExpression(instr_count, i));
+    AppendU32(codes, static_cast<u32>(body.size()));
+    AppendBytes(codes, body);
+  }
+  AppendSection(module, 10, codes);
+  return module;
+}
+
+}  // namespace wasp::bench
+
+#endif  // WASP_BENCH_SYNTHETIC_H_
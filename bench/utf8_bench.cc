@@ -0,0 +1,143 @@
+//
+// Copyright 2020 WebAssembly Community Group participants
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//     http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+//
+
+// Measures how long it takes to validate names with each UTF-8 validator.
+//
+// Usage: wasp_utf8_bench [<filenames...>]
+//
+// With no arguments, synthetic sets of mangled names are validated. Otherwise,
+// the function names from the import, export and name sections of the given
+// modules are validated.
+
+#include <iterator>
+#include <random>
+#include <string>
+#include <vector>
+
+#include "bench/bench_utils.h"
+#include "wasp/base/errors_nop.h"
+#include "wasp/base/features.h"
+#include "wasp/base/file.h"
+#include "wasp/base/utf8.h"
+#include "wasp/binary/lazy_module.h"
+#include "wasp/binary/lazy_module_utils.h"
+
+using namespace ::wasp;
+using namespace ::wasp::binary;
+using namespace ::wasp::bench;
+
+namespace {
+
+// Names like those in the name section of a Rust or C++ build, e.g.
+// `_ZN4core3fmt9Formatter3pad17h5f4c3a1d2e6b7a89E`. When `non_ascii` is set,
+// some of the identifiers use non-ASCII characters.
+std::vector<std::string> MakeNames(Index count, bool non_ascii) {
+  static const char* const kAscii[] = {"core", "fmt", "Formatter", "pad",
+                                       "alloc", "vec", "Vec", "push", "iter",
+                                       "map", "closure", "std", "io"};
+  static const char* const kNonAscii[] = {
+      "\xc3\xa9t\xc3\xa9", "\xe6\x97\xa5\xe6\x9c\xac", "\xce\xbb",
+      "na\xc3\xafve", "\xf0\x9f\xa6\x80"};
+  std::mt19937 rng{0};
+  std::vector<std::string> names;
+  for (Index i = 0; i < count; ++i) {
+    std::string name = "_ZN";
+    for (u32 parts = 2 + rng() % 6; parts > 0; --parts) {
+      std::string part = non_ascii && rng() % 4 == 0
+                             ? kNonAscii[rng() % std::size(kNonAscii)]
+                             : kAscii[rng() % std::size(kAscii)];
+      name += std::to_string(part.size()) + part;
+    }
+    name += absl::StrFormat("17h%016xE", u64{rng()} << 32 | rng());
+    names.push_back(std::move(name));
+  }
+  return names;
+}
+
+template <typename F>
+void Run(string_view name,
+         const std::vector<string_view>& names,
+         F&& validate) {
+  u64 bytes = 0;
+  for (auto s : names) {
+    bytes += s.size();
+  }
+  u64 valid = 0;
+  auto time = TimeIt([&]() {
+    valid = 0;
+    for (auto s : names) {
+      valid += validate(s);
+    }
+    DoNotOptimize(valid);
+  });
+  Report(name, time, names.size(), "name", bytes);
+}
+
+void RunAll(string_view name, const std::vector<string_view>& names) {
+  Run(absl::StrFormat("%s (IsValidUtf8)", name), names,
+      [](string_view s) { return IsValidUtf8(s); });
+
+  struct {
+    Utf8Validator validator;
+    const char* name;
+  } const validators[] = {
+      {Utf8Validator::Portable, "portable"},
+      {Utf8Validator::Sse41, "sse4.1"},
+      {Utf8Validator::Avx2, "avx2"},
+  };
+  for (auto [validator, validator_name] : validators) {
+    if (IsSupported(validator)) {
+      Run(absl::StrFormat("%s (%s)", name, validator_name), names,
+          [validator = validator](string_view s) {
+            return IsValidUtf8(s, validator);
+          });
+    }
+  }
+}
+
+std::vector<string_view> ToStringViews(const std::vector<std::string>& v) {
+  return std::vector<string_view>(v.begin(), v.end());
+}
+
+}  // namespace
+
+int main(int argc, char** argv) {
+  if (argc <= 1) {
+    auto ascii = MakeNames(100000, false);
+    RunAll("ascii names", ToStringViews(ascii));
+
+    auto non_ascii = MakeNames(100000, true);
+    RunAll("non-ascii names", ToStringViews(non_ascii));
+    return 0;
+  }
+
+  Features features;
+  ErrorsNop errors;
+  for (int i = 1; i < argc; ++i) {
+    auto optbuf = ReadFile(argv[i]);
+    if (!optbuf) {
+      absl::FPrintF(stderr, "Error reading file %s.\n", argv[i]);
+      continue;
+    }
+    auto module = ReadLazyModule(*optbuf, features, errors);
+    std::vector<string_view> names;
+    ForEachFunctionName(module, [&](const IndexNamePair& pair) {
+      names.push_back(pair.second);
+    });
+    RunAll(argv[i], names);
+  }
+  return 0;
+}
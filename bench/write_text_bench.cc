@@ -0,0 +1,101 @@
+//
+// Copyright 2020 WebAssembly Community Group participants
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//     http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+//
+
+// Measures the throughput of text::Write, writing a disassembled module to a
+// Buffer with std::back_inserter and with text::BufferInserter.
+//
+// Usage: wasp_write_text_bench [<filenames...>]
+//
+// The files are binary modules, which are converted to text before timing.
+// With no arguments, a synthetic module is written instead.
+
+#include <iterator>
+#include <string>
+
+#include "bench/bench_utils.h"
+#include "bench/synthetic.h"
+#include "wasp/base/buffer.h"
+#include "wasp/base/errors_nop.h"
+#include "wasp/base/features.h"
+#include "wasp/base/file.h"
+#include "wasp/binary/read.h"
+#include "wasp/binary/read/read_ctx.h"
+#include "wasp/convert/to_text.h"
+#include "wasp/text/formatters.h"
+#include "wasp/text/write.h"
+
+using namespace ::wasp;
+using namespace ::wasp::bench;
+
+namespace {
+
+template <typename F>
+void Run(const std::string& name, F&& write) {
+  size_t size = 0;
+  auto time = TimeIt([&]() { size = write(); });
+  absl::PrintF("%-50s %10.3f ms %8.1f MB/s\n", name, time.count() * 1e3,
+               size / time.count() / 1e6);
+}
+
+void Compare(const std::string& name, SpanU8 data) {
+  Features features;
+  features.EnableAll();
+  ErrorsNop errors;
+  binary::ReadCtx read_ctx{features, errors};
+  auto binary_module = binary::ReadModule(data, read_ctx);
+  if (!binary_module) {
+    absl::FPrintF(stderr, "Error reading module %s.\n", name);
+    return;
+  }
+  convert::TextCtx convert_ctx;
+  auto module = convert::ToText(convert_ctx, *binary_module);
+
+  Run(name + " (std::back_inserter)", [&]() {
+    text::WriteCtx ctx;
+    Buffer buffer;
+    text::Write(ctx, *module, std::back_inserter(buffer));
+    DoNotOptimize(buffer);
+    return buffer.size();
+  });
+
+  Run(name + " (text::BufferInserter)", [&]() {
+    text::WriteCtx ctx;
+    Buffer buffer;
+    text::Write(ctx, *module, text::BufferInserter{buffer});
+    DoNotOptimize(buffer);
+    return buffer.size();
+  });
+}
+
+}  // namespace
+
+int main(int argc, char** argv) {
+  if (argc <= 1) {
+    auto module = MakeModule(2000, 500);
+    Compare("synthetic module", module);
+    return 0;
+  }
+
+  for (int i = 1; i < argc; ++i) {
+    auto optbuf = ReadFile(argv[i]);
+    if (!optbuf) {
+      absl::FPrintF(stderr, "Error reading file %s.\n", argv[i]);
+      continue;
+    }
+    Compare(argv[i], *optbuf);
+  }
+  return 0;
+}
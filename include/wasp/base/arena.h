@@ -0,0 +1,78 @@
+//
+// Copyright 2020 WebAssembly Community Group participants
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//     http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+//
+
+#ifndef WASP_BASE_ARENA_H_
+#define WASP_BASE_ARENA_H_
+
+#include <cstddef>
+#include <memory>
+#include <vector>
+
+#include "wasp/base/hashmap.h"
+#include "wasp/base/span.h"
+#include "wasp/base/string_view.h"
+#include "wasp/base/types.h"
+
+namespace wasp {
+
+// Stores copies of strings and byte buffers back to back in large chunks, so
+// each copy doesn't need its own allocation. A copy keeps its address until
+// the arena is cleared or destroyed, so string_views and spans into it stay
+// valid when more copies are added.
+class Arena {
+ public:
+  static constexpr size_t kDefaultChunkSize = 64 * 1024;
+
+  Arena();
+  explicit Arena(size_t chunk_size);
+
+  Arena(const Arena&) = delete;
+  Arena& operator=(const Arena&) = delete;
+  // Copies stay where they are, in the chunks now owned by the new arena. The
+  // moved-from arena is left empty.
+  Arena(Arena&&) noexcept;
+  Arena& operator=(Arena&&) noexcept;
+
+  SpanU8 Add(SpanU8);
+  string_view Add(string_view);
+
+  // Like Add, but if an equal string has already been interned, returns that
+  // copy instead of making a new one. Useful for names, which are often
+  // repeated (e.g. the module name of every import).
+  string_view Intern(string_view);
+
+  // Frees everything but one chunk, which is reused for the next copies.
+  void Clear();
+
+  // The number of bytes copied into the arena.
+  size_t size() const { return size_; }
+  size_t chunk_count() const { return chunks_.size(); }
+
+ private:
+  u8* Allocate(size_t);
+
+  size_t chunk_size_;
+  std::vector<std::unique_ptr<u8[]>> chunks_;
+  u8* chunk_ = nullptr;  // The chunk that next_ points into.
+  u8* next_ = nullptr;
+  u8* end_ = nullptr;
+  size_t size_ = 0;
+  flat_hash_set<string_view> interned_;
+};
+
+}  // namespace wasp
+
+#endif  // WASP_BASE_ARENA_H_
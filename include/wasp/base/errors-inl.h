@@ -17,6 +17,7 @@
 namespace wasp {
 
 inline void Errors::PushContext(Location loc, string_view desc) {
+  FlushLazyContexts();
   HandlePushContext(loc, desc);
 }
 
@@ -25,6 +26,7 @@ inline void Errors::PopContext() {
 }
 
 inline void Errors::OnError(Location loc, string_view message) {
+  FlushLazyContexts();
   HandleOnError(loc, message);
 }
 
@@ -22,9 +22,15 @@
 
 namespace wasp {
 
+class ErrorsContextGuard;
+
 class Errors {
  public:
+  Errors() = default;
+  Errors(const Errors&) {}
+  Errors& operator=(const Errors&) { return *this; }
   virtual ~Errors() {}
+
   void PushContext(Location loc, string_view desc);
   void PopContext();
   void OnError(Location loc, string_view message);
@@ -35,6 +41,17 @@ class Errors {
   virtual void HandlePushContext(Location loc, string_view desc) = 0;
   virtual void HandlePopContext() = 0;
   virtual void HandleOnError(Location loc, string_view message) = 0;
+
+ private:
+  friend class ErrorsContextGuard;
+
+  // Contexts pushed by an ErrorsContextGuard are only recorded in this list
+  // at first, and are passed to HandlePushContext when they're needed, i.e.
+  // when an error occurs or another context is pushed on top of them.
+  void FlushLazyContexts();
+  void FlushLazyContexts(ErrorsContextGuard*);
+
+  ErrorsContextGuard* lazy_context_ = nullptr;
 };
 
 }  // namespace wasp
@@ -0,0 +1,63 @@
+//
+// Copyright 2020 WebAssembly Community Group participants
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//     http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+//
+
+#ifndef WASP_BASE_ERRORS_BUFFER_H_
+#define WASP_BASE_ERRORS_BUFFER_H_
+
+#include <string>
+#include <utility>
+#include <vector>
+
+#include "wasp/base/errors.h"
+#include "wasp/base/span.h"
+#include "wasp/base/string_view.h"
+
+namespace wasp {
+
+// Collects errors so they can be replayed into another Errors object later,
+// e.g. to report errors produced on worker threads in a deterministic order.
+// Only the contexts that are active when an error occurs are kept.
+class ErrorsBuffer : public Errors {
+ public:
+  bool HasError() const override { return !errors_.empty(); }
+
+  void Clear();
+  void ReplayTo(Errors&) const;
+
+ protected:
+  void HandlePushContext(Location loc, string_view desc) override;
+  void HandlePopContext() override;
+  void HandleOnError(Location loc, string_view message) override;
+
+ private:
+  struct Context {
+    Location loc;
+    std::string desc;
+  };
+
+  struct BufferedError {
+    std::vector<Context> context_stack;
+    Location loc;
+    std::string message;
+  };
+
+  std::vector<std::pair<Location, string_view>> context_stack_;
+  std::vector<BufferedError> errors_;
+};
+
+}  // namespace wasp
+
+#endif // WASP_BASE_ERRORS_BUFFER_H_
@@ -17,6 +17,8 @@
 #ifndef WASP_BASE_ERRORS_CONTEXT_GUARD_H_
 #define WASP_BASE_ERRORS_CONTEXT_GUARD_H_
 
+#include <cassert>
+
 #include "wasp/base/span.h"
 #include "wasp/base/string_view.h"
 #include "wasp/base/errors.h"
@@ -24,23 +26,40 @@
 namespace wasp {
 
 /// ---
+// Pushes a context for the lifetime of the guard. The context is pushed
+// lazily: Errors::HandlePushContext (and the matching HandlePopContext) are
+// only called if an error occurs while the guard is active, so the common
+// path costs a few stores and no virtual calls.
 class ErrorsContextGuard {
  public:
   explicit ErrorsContextGuard(Errors& errors, Location loc, string_view desc)
-      : errors_{errors} {
-    errors.PushContext(loc, desc);
+      : errors_{errors}, loc_{loc}, desc_{desc}, prev_{errors.lazy_context_} {
+    errors.lazy_context_ = this;
   }
   ~ErrorsContextGuard() { PopContext(); }
 
+  ErrorsContextGuard(const ErrorsContextGuard&) = delete;
+  ErrorsContextGuard& operator=(const ErrorsContextGuard&) = delete;
+
   void PopContext() {
     if (!popped_context_) {
-      errors_.PopContext();
+      assert(errors_.lazy_context_ == this);
+      errors_.lazy_context_ = prev_;
+      if (pushed_context_) {
+        errors_.HandlePopContext();
+      }
       popped_context_ = true;
     }
   }
 
  private:
+  friend class Errors;
+
   Errors& errors_;
+  Location loc_;
+  string_view desc_;
+  ErrorsContextGuard* prev_;
+  bool pushed_context_ = false;
   bool popped_context_ = false;
 };
 
@@ -28,6 +28,36 @@ namespace wasp {
 
 optional<Buffer> ReadFile(string_view filename);
 
+// A read-only view of a file's contents. Regular files are mapped into memory
+// so their contents can be read directly from the page cache; anything else
+// (pipes, character devices, or platforms without mmap) falls back to reading
+// the contents into a Buffer.
+class MappedFile {
+ public:
+  MappedFile() = default;
+  explicit MappedFile(Buffer);
+  MappedFile(MappedFile&&);
+  MappedFile& operator=(MappedFile&&);
+  ~MappedFile();
+
+  MappedFile(const MappedFile&) = delete;
+  MappedFile& operator=(const MappedFile&) = delete;
+
+  SpanU8 data() const { return data_; }
+  bool is_mapped() const { return is_mapped_; }
+
+ private:
+  friend optional<MappedFile> MapFile(string_view filename);
+
+  void Unmap();
+
+  SpanU8 data_;
+  Buffer buffer_;
+  bool is_mapped_ = false;
+};
+
+optional<MappedFile> MapFile(string_view filename);
+
 }  // namespace wasp
 
 #endif  // WASP_BASE_FILE_H_
@@ -0,0 +1,69 @@
+//
+// Copyright 2020 WebAssembly Community Group participants
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//     http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+//
+
+#ifndef WASP_BASE_PARALLEL_FOR_H_
+#define WASP_BASE_PARALLEL_FOR_H_
+
+#include <algorithm>
+#include <atomic>
+#include <thread>
+#include <vector>
+
+#include "wasp/base/types.h"
+
+namespace wasp {
+
+// Calls `func(worker, index)` for every index in [0, count), handing out
+// indexes dynamically to `num_threads` threads. `worker` is in
+// [0, num_threads) and is unique to the thread making the call, so it can be
+// used to select per-thread state. Runs everything on the calling thread if
+// `num_threads` is 1 or less.
+template <typename F>
+void ParallelFor(Index count, Index num_threads, F&& func) {
+  num_threads = std::min(num_threads, count);
+  if (num_threads <= 1) {
+    for (Index index = 0; index < count; ++index) {
+      func(Index{0}, index);
+    }
+    return;
+  }
+
+  std::atomic<Index> next{0};
+  auto run = [&](Index worker) {
+    for (Index index; (index = next.fetch_add(1)) < count;) {
+      func(worker, index);
+    }
+  };
+
+  std::vector<std::thread> threads;
+  threads.reserve(num_threads - 1);
+  for (Index worker = 1; worker < num_threads; ++worker) {
+    threads.emplace_back(run, worker);
+  }
+  run(0);
+  for (auto& thread : threads) {
+    thread.join();
+  }
+}
+
+// The number of threads to use when the user asks for "as many as possible".
+inline Index DefaultThreadCount() {
+  return std::max(1u, std::thread::hardware_concurrency());
+}
+
+}  // namespace wasp
+
+#endif  // WASP_BASE_PARALLEL_FOR_H_
@@ -18,11 +18,42 @@
 #define WASP_BASE_UTF8_H_
 
 #include "wasp/base/string_view.h"
+#include "wasp/base/types.h"
 
 namespace wasp {
 
 bool IsValidUtf8(string_view);
 
+// The implementations that IsValidUtf8 chooses between. IsValidUtf8 uses the
+// fastest one the CPU supports; the others are exposed so they can be tested
+// and benchmarked too. They all accept exactly the same strings.
+enum class Utf8Validator {
+  Portable,  // A DFA, skipping runs of ASCII 8 bytes at a time.
+  Sse41,
+  Avx2,
+};
+
+// Whether the validator was built in and is supported by this CPU.
+bool IsSupported(Utf8Validator);
+
+// Validates using the given validator, which must be supported.
+bool IsValidUtf8(string_view, Utf8Validator);
+
+// Validates UTF-8 that arrives in pieces, e.g. while decoding the escapes in a
+// quoted string. A multi-byte sequence may be split across pieces.
+class Utf8Checker {
+ public:
+  void Append(string_view);
+  void Append(u8);
+
+  // Whether everything appended so far is valid UTF-8, and doesn't end in the
+  // middle of a sequence.
+  bool IsValid() const;
+
+ private:
+  u32 state_ = 0;
+};
+
 }  // namespace wasp
 
 #endif  // WASP_BASE_UTF8_H_
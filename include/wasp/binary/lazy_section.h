@@ -32,6 +32,13 @@ class LazySection {
  public:
   explicit LazySection(SpanU8, string_view name, ReadCtx&);
 
+  // For a section whose count was already read, e.g. when the section is
+  // read incrementally.
+  explicit LazySection(OptAt<Index> count,
+                       SpanU8,
+                       string_view name,
+                       ReadCtx&);
+
   OptAt<Index> count;
   LazySequence<T> sequence;
 };
@@ -40,6 +47,13 @@ template <typename T>
 LazySection<T>::LazySection(SpanU8 data, string_view name, ReadCtx& ctx)
     : count{ReadCount(&data, ctx)}, sequence{data, count, name, ctx} {}
 
+template <typename T>
+LazySection<T>::LazySection(OptAt<Index> count,
+                            SpanU8 data,
+                            string_view name,
+                            ReadCtx& ctx)
+    : count{count}, sequence{data, count, name, ctx} {}
+
 }  // namespace wasp::binary
 
 #endif // WASP_BINARY_LAZY_SECTION_H_
@@ -0,0 +1,87 @@
+//
+// Copyright 2020 WebAssembly Community Group participants
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//     http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+//
+
+#ifndef WASP_BINARY_MODULE_INDEX_H_
+#define WASP_BINARY_MODULE_INDEX_H_
+
+#include <vector>
+
+#include "wasp/base/at.h"
+#include "wasp/base/buffer.h"
+#include "wasp/base/hashmap.h"
+#include "wasp/base/optional.h"
+#include "wasp/base/span.h"
+#include "wasp/base/string_view.h"
+#include "wasp/base/types.h"
+#include "wasp/binary/lazy_module.h"
+#include "wasp/binary/lazy_module_utils.h"
+#include "wasp/binary/types.h"
+
+namespace wasp::binary {
+
+struct ReadCtx;
+
+/// ---
+/// The layout of a LazyModule, gathered in one pass over its sections. Each
+/// code entry is recorded but not decoded, so a single function body can be
+/// read without reading all of the ones before it.
+struct ModuleIndex {
+  Index GetImportCount(ExternalKind) const;
+  Index GetFunctionCount() const;
+  optional<Index> FindFunction(string_view name) const;
+  optional<At<Section>> FindSection(SectionId) const;
+
+  // Reads the body of a defined function, given its function index.
+  auto GetCode(Index function_index, ReadCtx&) const -> OptAt<Code>;
+
+  std::vector<At<Section>> sections;
+  Index imported_function_count = 0;
+  Index imported_table_count = 0;
+  Index imported_memory_count = 0;
+  Index imported_global_count = 0;
+  Index imported_tag_count = 0;
+  Index defined_function_count = 0;
+  std::vector<SpanU8> codes;  // Each includes the entry's size prefix.
+
+  // Function names from the import, export and "name" sections, in the order
+  // they appear in the module. If a name is used more than once, it is mapped
+  // to the first function that uses it.
+  std::vector<IndexNamePair> function_names;
+  flat_hash_map<string_view, Index> name_to_function;
+};
+
+auto IndexModule(LazyModule&) -> ModuleIndex;
+
+// Adds the code entries of `known`, a code section, to `index.codes`. For
+// callers that already read the other sections themselves.
+void IndexCodeSection(ModuleIndex& index, KnownSection known, ReadCtx&);
+
+/// ---
+/// A ModuleIndex can be saved next to its module, so repeated inspections of
+/// the same module don't have to rebuild it. The saved index stores offsets
+/// into the module, and a hash of the module's contents; ReadModuleIndex
+/// returns nullopt if the hash doesn't match or the index is malformed.
+///
+/// The format uses the host's byte order, since it is only meant as a cache.
+u64 HashModuleContents(SpanU8);
+
+void WriteModuleIndex(const ModuleIndex&, SpanU8 module_data, Buffer&);
+
+auto ReadModuleIndex(SpanU8 index_data, LazyModule&) -> optional<ModuleIndex>;
+
+}  // namespace wasp::binary
+
+#endif  // WASP_BINARY_MODULE_INDEX_H_
@@ -0,0 +1,130 @@
+//
+// Copyright 2020 WebAssembly Community Group participants
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//     http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+//
+
+#ifndef WASP_BINARY_PACKED_EXPRESSION_H_
+#define WASP_BINARY_PACKED_EXPRESSION_H_
+
+#include <vector>
+
+#include "wasp/base/span.h"
+#include "wasp/base/types.h"
+#include "wasp/base/v128.h"
+#include "wasp/base/wasm_types.h"
+#include "wasp/binary/types.h"
+
+namespace wasp::binary {
+
+struct ReadCtx;
+
+/// ---
+/// A fixed-size, location-free instruction. Immediates that fit in three u32
+/// words are stored inline; anything larger lives in one of the side tables
+/// of the owning PackedExpression.
+///
+///   kind            immediate[0]      immediate[1]      immediate[2]
+///   S32, Index      value
+///   S64, F64        low bits          high bits
+///   F32             bits
+///   V128            v128s index
+///   Shuffle         shuffles index
+///   BlockType       block_types index
+///   HeapType        heap_types index
+///   HeapType2       heap_types index (parent, then child)
+///   BrOnCast        target            heap_types index
+///   RttSub          depth             heap_types index
+///   BrTable         br_table_targets index  target count
+///                   (the default target follows the other targets)
+///   Select          value_types index value type count
+///   Let             block_types index locals index    locals count
+///   MemArg          align_log2        offset            memory index
+///   SimdMemoryLane  simd_memory_lanes index
+///   SimdLane        lane
+///   CallIndirect, Copy, Init, StructField, MemOpt, FuncBind:
+///                   the immediate's fields, in declaration order
+struct PackedInstruction {
+  static constexpr u8 kHasMemoryIndex = 1;
+
+  Opcode opcode() const { return static_cast<Opcode>(opcode_value); }
+  bool has_memory_index() const { return (flags & kHasMemoryIndex) != 0; }
+
+  Index index_immediate() const { return immediate[0]; }
+  s32 s32_immediate() const { return static_cast<s32>(immediate[0]); }
+  s64 s64_immediate() const { return static_cast<s64>(u64_immediate()); }
+  f32 f32_immediate() const;
+  f64 f64_immediate() const;
+
+  u64 u64_immediate() const {
+    return u64{immediate[0]} | (u64{immediate[1]} << 32);
+  }
+
+  u16 opcode_value;
+  InstructionKind kind;
+  u8 flags;
+  u32 immediate[3];
+};
+
+static_assert(sizeof(PackedInstruction) == 16,
+              "PackedInstruction should be 16 bytes");
+
+/// ---
+/// A whole expression (usually a function body) decoded into
+/// PackedInstructions. The vectors are only cleared between uses, so reusing
+/// one PackedExpression for many functions does no per-instruction heap
+/// allocation once the vectors have grown.
+struct PackedExpression {
+  void Clear();
+
+  std::vector<PackedInstruction> instructions;
+  // Only filled if requested, one per instruction. Each offset is relative to
+  // the start of the bytes that the instruction was decoded from.
+  std::vector<u32> offsets;
+
+  std::vector<Index> br_table_targets;
+  std::vector<ValueType> value_types;
+  std::vector<BlockType> block_types;
+  std::vector<HeapType> heap_types;
+  std::vector<Locals> locals;
+  std::vector<v128> v128s;
+  std::vector<ShuffleImmediate> shuffles;
+  std::vector<SimdMemoryLaneImmediate> simd_memory_lanes;
+};
+
+enum class RecordOffsets { No, Yes };
+
+// Decodes every instruction in `data` into `out`, replacing its previous
+// contents. Errors are reported exactly as ReadExpression would report them.
+// Returns false if an error occurred; `out` then holds the instructions that
+// were decoded before the error.
+bool ReadPackedExpression(SpanU8 data,
+                          ReadCtx&,
+                          PackedExpression* out,
+                          RecordOffsets = RecordOffsets::No);
+bool ReadPackedExpression(Expression,
+                          ReadCtx&,
+                          PackedExpression* out,
+                          RecordOffsets = RecordOffsets::No);
+
+// Like ReadPackedExpression, but appends to `out` instead of replacing its
+// contents, so many expressions can share one set of tables. Side table
+// indexes in the new instructions refer to the shared tables.
+bool AppendPackedExpression(SpanU8 data,
+                            ReadCtx&,
+                            PackedExpression* out,
+                            RecordOffsets = RecordOffsets::No);
+
+}  // namespace wasp::binary
+
+#endif  // WASP_BINARY_PACKED_EXPRESSION_H_
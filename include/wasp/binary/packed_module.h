@@ -0,0 +1,73 @@
+//
+// Copyright 2020 WebAssembly Community Group participants
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//     http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+//
+
+#ifndef WASP_BINARY_PACKED_MODULE_H_
+#define WASP_BINARY_PACKED_MODULE_H_
+
+#include <vector>
+
+#include "wasp/base/at.h"
+#include "wasp/base/optional.h"
+#include "wasp/base/span.h"
+#include "wasp/base/types.h"
+#include "wasp/binary/packed_expression.h"
+#include "wasp/binary/types.h"
+
+namespace wasp::binary {
+
+struct ReadCtx;
+
+/// ---
+/// A function body in a PackedModule. The locals and instructions are ranges
+/// of the module's shared tables.
+struct PackedCode {
+  SpanU8 body;  // Instruction offsets are relative to the start of this.
+  Index first_locals;
+  Index locals_count;
+  Index first_instruction;
+  Index instruction_count;
+};
+
+/// ---
+/// Like Module, but all function bodies share one PackedExpression and one
+/// locals table instead of owning a vector each. Reading and destroying a
+/// large module is then a handful of bulk allocations, rather than several
+/// per function and per br_table/select instruction.
+struct PackedModule {
+  std::vector<At<DefinedType>> types;
+  std::vector<At<Import>> imports;
+  std::vector<At<Function>> functions;
+  std::vector<At<Table>> tables;
+  std::vector<At<Memory>> memories;
+  std::vector<At<Global>> globals;
+  std::vector<At<Tag>> tags;
+  std::vector<At<Export>> exports;
+  optional<At<Start>> start;
+  std::vector<At<ElementSegment>> element_segments;
+  optional<At<DataCount>> data_count;
+  std::vector<At<PackedCode>> codes;
+  std::vector<At<DataSegment>> data_segments;
+
+  std::vector<At<Locals>> locals;
+  PackedExpression code;  // All function bodies, back to back.
+};
+
+auto ReadPackedModule(SpanU8, ReadCtx&, RecordOffsets = RecordOffsets::No)
+    -> optional<PackedModule>;
+
+}  // namespace wasp::binary
+
+#endif  // WASP_BINARY_PACKED_MODULE_H_
@@ -30,7 +30,9 @@ namespace wasp::binary {
 struct ReadCtx;
 
 // Read a full binary module eagerly (see ReadLazyModule to read lazily).
-auto ReadModule(SpanU8, ReadCtx&) -> optional<Module>;
+// With more than one thread, the function bodies are decoded in parallel.
+// Errors are reported in the same order for any number of threads.
+auto ReadModule(SpanU8, ReadCtx&, Index num_threads = 1) -> optional<Module>;
 
 
 template <typename T>
@@ -125,6 +127,8 @@ auto Read(SpanU8*, ReadCtx&, ReadTag<Limits>, LimitsKind) -> OptAt<Limits>;
 auto Read(SpanU8*, ReadCtx&, ReadTag<Locals>) -> OptAt<Locals>;
 auto Read(SpanU8*, ReadCtx&, ReadTag<MemArgImmediate>)
     -> OptAt<MemArgImmediate>;
+auto Read(SpanU8*, ReadCtx&, ReadTag<MemOptImmediate>)
+    -> OptAt<MemOptImmediate>;
 auto Read(SpanU8*, ReadCtx&, ReadTag<Memory>) -> OptAt<Memory>;
 auto Read(SpanU8*, ReadCtx&, ReadTag<MemoryType>) -> OptAt<MemoryType>;
 auto Read(SpanU8*, ReadCtx&, ReadTag<Mutability>) -> OptAt<Mutability>;
@@ -152,6 +156,7 @@ auto Read(SpanU8*, ReadCtx&, ReadTag<u8>) -> OptAt<u8>;
 auto Read(SpanU8*, ReadCtx&, ReadTag<v128>) -> OptAt<v128>;
 auto Read(SpanU8*, ReadCtx&, ReadTag<ValueType>) -> OptAt<ValueType>;
 
+bool CheckSectionOrder(const At<SectionId>&, ReadCtx&);
 bool EndCode(SpanU8, ReadCtx&);
 bool EndModule(SpanU8, ReadCtx&);
 
@@ -20,6 +20,10 @@
 #include <type_traits>
 #include <iomanip>
 
+#if defined(_MSC_VER)
+#include <intrin.h>
+#endif
+
 #include "wasp/base/concat.h"
 #include "wasp/base/errors_context_guard.h"
 #include "wasp/base/features.h"
@@ -44,8 +48,43 @@ S SignExtend(std::make_unsigned_t<S> x, int N) {
   return static_cast<S>(x << (kNumBits - N - 1)) >> (kNumBits - N - 1);
 }
 
+// Loads 8 bytes in little-endian order. Compilers turn this into a single
+// (possibly unaligned) load on little-endian targets.
+inline u64 LoadU64LE(const u8* p) {
+  u64 word = 0;
+  for (int i = 0; i < 8; ++i) {
+    word |= u64{p[i]} << (i * 8);
+  }
+  return word;
+}
+
+// Returns the index of the lowest set bit. `x` must be non-zero.
+inline int CountTrailingZeroes(u64 x) {
+#if defined(_MSC_VER)
+  unsigned long index;
+  _BitScanForward64(&index, x);
+  return static_cast<int>(index);
+#else
+  return __builtin_ctzll(x);
+#endif
+}
+
+// Packs the low 7 bits of each byte of `word` into a contiguous 56-bit value,
+// i.e. the payload of an 8-byte LEB128 encoding. Bytes past the end of the
+// encoding must already be cleared.
+inline u64 CompactVarIntBytes(u64 word) {
+  word &= 0x7f7f7f7f7f7f7f7full;
+  word = ((word & 0x7f007f007f007f00ull) >> 1) | (word & 0x007f007f007f007full);
+  word = ((word & 0x3fff00003fff0000ull) >> 2) | (word & 0x00003fff00003fffull);
+  word = ((word & 0x0fffffff00000000ull) >> 4) | (word & 0x000000000fffffffull);
+  return word;
+}
+
+// Decodes `data` one byte at a time. This handles every case, including
+// truncated input and invalid last bytes, so it is used whenever the fast
+// paths in ReadVarInt below can't be sure the encoding is well-formed.
 template <typename T>
-OptAt<T> ReadVarInt(SpanU8* data, ReadCtx& ctx, string_view desc) {
+OptAt<T> ReadVarIntSlow(SpanU8* data, ReadCtx& ctx, string_view desc) {
   using U = std::make_unsigned_t<T>;
   constexpr bool is_signed = std::is_signed_v<T>;
   constexpr int kByteMask = VarInt<T>::kByteMask;
@@ -93,6 +132,56 @@ OptAt<T> ReadVarInt(SpanU8* data, ReadCtx& ctx, string_view desc) {
   }
 }
 
+template <typename T>
+OptAt<T> ReadVarInt(SpanU8* data, ReadCtx& ctx, string_view desc) {
+  using U = std::make_unsigned_t<T>;
+  constexpr bool is_signed = std::is_signed_v<T>;
+  constexpr int kMaxBytes = VarInt<T>::kMaxBytes;
+  static_assert(kMaxBytes > 2,
+                "Fast paths assume the last byte is not the 1st or 2nd");
+
+  const u8* start = data->data();
+  const size_t size = data->size();
+
+  // Most values in a module (indexes, small constants, alignments) fit in one
+  // or two bytes. Neither can be the last byte of the encoding, so no
+  // extension checks are needed and no error can occur.
+  if (size >= 1 && (start[0] & VarInt<T>::kExtendBit) == 0) {
+    U result = start[0];
+    data->remove_prefix(1);
+    return At{Location{start, 1},
+              is_signed ? SignExtend<T>(result, 6) : T(result)};
+  }
+  if (size >= 2 && (start[1] & VarInt<T>::kExtendBit) == 0) {
+    U result = U(start[0] & VarInt<T>::kByteMask) | (U(start[1]) << 7);
+    data->remove_prefix(2);
+    return At{Location{start, 2},
+              is_signed ? SignExtend<T>(result, 13) : T(result)};
+  }
+
+  // Longer encodings: find the terminating byte with a single 64-bit load.
+  // Encodings that reach kMaxBytes need the last-byte checks, and those
+  // (along with anything near the end of the buffer) take the slow path.
+  if (size >= 8) {
+    const u64 word = LoadU64LE(start);
+    const u64 stop_bits = ~word & 0x8080808080808080ull;
+    if (stop_bits != 0) {
+      const int length = CountTrailingZeroes(stop_bits) / 8 + 1;
+      if (length < kMaxBytes) {
+        const u64 mask =
+            length == 8 ? ~u64{0} : (u64{1} << (length * 8)) - 1;
+        U result = U(CompactVarIntBytes(word & mask));
+        data->remove_prefix(length);
+        return At{Location{start, size_t(length)},
+                  is_signed ? SignExtend<T>(result, length * 7 - 1)
+                            : T(result)};
+      }
+    }
+  }
+
+  return ReadVarIntSlow<T>(data, ctx, desc);
+}
+
 }  // namespace wasp::binary
 
 #endif  // WASP_BINARY_READ_READ_VAR_INT_H_
@@ -273,7 +273,7 @@ struct SimdMemoryLaneImmediate {
 };
 
 // NOTE this must be kept in sync with the Instruction variant below.
-enum class InstructionKind {
+enum class InstructionKind : u8 {
   None,
   S32,
   S64,
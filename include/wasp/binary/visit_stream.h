@@ -0,0 +1,383 @@
+//
+// Copyright 2020 WebAssembly Community Group participants
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//     http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+//
+
+#ifndef WASP_BINARY_VISIT_STREAM_H_
+#define WASP_BINARY_VISIT_STREAM_H_
+
+#include <algorithm>
+
+#include "wasp/base/buffer.h"
+#include "wasp/base/concat.h"
+#include "wasp/base/errors.h"
+#include "wasp/base/features.h"
+#include "wasp/base/optional.h"
+#include "wasp/base/span.h"
+#include "wasp/base/types.h"
+#include "wasp/binary/encoding.h"
+#include "wasp/binary/lazy_module.h"
+#include "wasp/binary/read.h"
+#include "wasp/binary/read/read_ctx.h"
+#include "wasp/binary/sections.h"
+#include "wasp/binary/visitor.h"
+
+namespace wasp::binary::visit {
+
+/// ---
+/// Visits a module that arrives in chunks, e.g. from a socket or a
+/// decompressor, calling the same Visitor callbacks as Visit. Sections are
+/// visited as soon as all of their bytes have arrived. The code section is
+/// visited one function at a time instead, so only the bytes that haven't
+/// been visited yet are buffered: at most one non-code section or one
+/// function body, rather than the whole module. A visitor may hold on to more
+/// than that; e.g. valid::ValidateVisitor with more than one thread copies
+/// the bodies it validates in parallel, up to a limit it sets, and the
+/// locations of errors in those bodies point into its copies.
+///
+/// Since the bytes are discarded once visited, the locations passed to the
+/// visitor and to Errors are only valid until the next call to Append.
+///
+/// The code section's bodies haven't arrived when its OnSection and
+/// BeginCodeSection callbacks are called, so the Section's data and the
+/// LazyCodeSection's sequence are empty; only the count is available.
+template <typename Visitor>
+class Stream {
+ public:
+  explicit Stream(const Features&, Errors&, Visitor&);
+
+  Stream(const Stream&) = delete;
+  Stream& operator=(const Stream&) = delete;
+
+  // Visits everything that is complete after appending `chunk`. Returns Fail
+  // if the module is malformed or the visitor failed, after which any further
+  // chunks are ignored.
+  Result Append(SpanU8 chunk);
+
+  // Call after the last chunk. Reports an error if the module ended in the
+  // middle of a section, then finishes the module like Visit does.
+  Result Finish();
+
+ private:
+  enum class State { Header, Section, CodeCount, Code, SkipSection, Done };
+
+  // The length and value of a u32 LEB128 at the start of a buffer. If it
+  // isn't `complete`, more bytes are needed to read it. If it's `malformed`,
+  // it can't be decoded, and the regular reader should report the error.
+  struct PeekedU32 {
+    bool complete = false;
+    bool malformed = false;
+    size_t length = 0;
+    u32 value = 0;
+  };
+
+  static PeekedU32 PeekU32(SpanU8);
+
+  ReadCtx& ctx() { return module_->ctx; }
+  SpanU8 available() const;
+  void Consume(size_t);
+  Result Process();
+  Result ProcessSection(SpanU8);
+  Result ProcessCode(SpanU8);
+  Result EndCodeSection(SpanU8);
+  Result Stop(Result);
+
+  static constexpr size_t kHeaderSize = 8;
+  static constexpr size_t kMaxU32Size = 5;
+
+  Features features_;
+  Errors& errors_;
+  Visitor& visitor_;
+  State state_ = State::Header;
+  Result result_ = Result::Ok;
+  Buffer buffer_;
+  size_t pos_ = 0;  // Bytes of buffer_ that have already been visited.
+  u8 header_[kHeaderSize];
+  optional<LazyModule> module_;
+
+  // The code section currently being visited.
+  size_t section_remaining_ = 0;
+  OptAt<Index> code_count_;
+  Index codes_read_ = 0;
+};
+
+template <typename Visitor>
+Stream<Visitor>::Stream(const Features& features,
+                        Errors& errors,
+                        Visitor& visitor)
+    : features_{features}, errors_{errors}, visitor_{visitor} {}
+
+template <typename Visitor>
+Result Stream<Visitor>::Append(SpanU8 chunk) {
+  if (state_ == State::Done) {
+    return result_;
+  }
+  // Everything before pos_ has been visited, so it can be dropped before the
+  // buffer grows.
+  buffer_.erase(buffer_.begin(), buffer_.begin() + pos_);
+  pos_ = 0;
+  buffer_.insert(buffer_.end(), chunk.begin(), chunk.end());
+  return Process();
+}
+
+template <typename Visitor>
+Result Stream<Visitor>::Finish() {
+  if (state_ == State::Done) {
+    return result_;
+  }
+
+  SpanU8 data = available();
+  switch (state_) {
+    case State::Header:
+      // Reports the missing magic or version.
+      module_.emplace(data, features_, errors_);
+      return Stop(Result::Fail);
+
+    case State::Section:
+      if (!data.empty()) {
+        // Reports why the section is incomplete.
+        Read<Section>(&data, ctx());
+        return Stop(Result::Fail);
+      }
+      break;
+
+    default:
+      ctx().errors.OnError(data, concat("Expected ", section_remaining_,
+                                        " more bytes in code section"));
+      return Stop(Result::Fail);
+  }
+
+  EndModule(module_->data, ctx());
+  return Stop(visitor_.EndModule(*module_));
+}
+
+// static
+template <typename Visitor>
+auto Stream<Visitor>::PeekU32(SpanU8 data) -> PeekedU32 {
+  PeekedU32 result;
+  for (size_t i = 0; i < std::min(data.size(), kMaxU32Size); ++i) {
+    u8 byte = data[i];
+    result.value |= u32(byte & 0x7f) << (i * 7);
+    if ((byte & 0x80) == 0) {
+      result.complete = true;
+      // The last byte only has room for the top 4 bits.
+      result.malformed = i == kMaxU32Size - 1 && (byte & 0x70) != 0;
+      result.length = i + 1;
+      return result;
+    }
+  }
+  if (data.size() >= kMaxU32Size) {
+    result.complete = result.malformed = true;
+  }
+  return result;
+}
+
+template <typename Visitor>
+SpanU8 Stream<Visitor>::available() const {
+  return SpanU8{buffer_}.subspan(pos_);
+}
+
+template <typename Visitor>
+void Stream<Visitor>::Consume(size_t size) {
+  pos_ += size;
+}
+
+template <typename Visitor>
+Result Stream<Visitor>::Process() {
+  for (;;) {
+    SpanU8 data = available();
+    switch (state_) {
+      case State::Header: {
+        if (data.size() < kHeaderSize) {
+          return Result::Ok;
+        }
+        std::copy_n(data.begin(), kHeaderSize, header_);
+        Consume(kHeaderSize);
+        module_.emplace(SpanU8{header_, kHeaderSize}, features_, errors_);
+        if (!(module_->magic && module_->version)) {
+          return Stop(Result::Fail);
+        }
+        auto res = visitor_.BeginModule(*module_);
+        if (res != Result::Ok) {
+          return Stop(res);
+        }
+        state_ = State::Section;
+        break;
+      }
+
+      case State::Section: {
+        if (data.size() < 2) {
+          return Result::Ok;
+        }
+        auto res = ProcessSection(data);
+        if (res != Result::Ok) {
+          return res == Result::Skip ? Result::Ok : res;
+        }
+        break;
+      }
+
+      case State::SkipSection: {
+        size_t size = std::min(data.size(), section_remaining_);
+        Consume(size);
+        section_remaining_ -= size;
+        if (section_remaining_ > 0) {
+          return Result::Ok;
+        }
+        state_ = State::Section;
+        break;
+      }
+
+      case State::CodeCount:
+      case State::Code: {
+        if (section_remaining_ == 0 && state_ == State::Code) {
+          if (EndCodeSection(data.first(0)) == Result::Fail) {
+            return Stop(Result::Fail);
+          }
+          state_ = State::Section;
+          break;
+        }
+        auto res = ProcessCode(data);
+        if (res != Result::Ok) {
+          return res == Result::Skip ? Result::Ok : res;
+        }
+        break;
+      }
+
+      case State::Done:
+        return result_;
+    }
+  }
+}
+
+// Returns Skip if more bytes are needed.
+template <typename Visitor>
+Result Stream<Visitor>::ProcessSection(SpanU8 data) {
+  auto size = PeekU32(data.subspan(1));
+  if (!size.complete) {
+    return Result::Skip;
+  }
+
+  if (!size.malformed &&
+      data[0] == encoding::SectionId::Encode(SectionId::Code)) {
+    // Visit the code section's header now, and its bodies as they arrive.
+    SpanU8 header = data.first(1 + size.length);
+    SpanU8 id_data = header;
+    auto id = Read<SectionId>(&id_data, ctx());
+    CheckSectionOrder(*id, ctx());
+    auto known = At{header, KnownSection{*id, data.first(0)}};
+    Consume(header.size());
+    section_remaining_ = size.value;
+    auto res = visitor_.OnSection(At{header, Section{known}});
+    if (res == Result::Fail) {
+      return Stop(Result::Fail);
+    }
+    state_ = res == Result::Skip ? State::SkipSection : State::CodeCount;
+    return Result::Ok;
+  }
+
+  size_t section_size = 1 + size.length + size.value;
+  if (!size.malformed && data.size() < section_size) {
+    return Result::Skip;
+  }
+  SpanU8 section_data = data.first(std::min(data.size(), section_size));
+  auto section = Read<Section>(&section_data, ctx());
+  if (!section ||
+      VisitSection(*module_, *section, visitor_) == Result::Fail) {
+    return Stop(Result::Fail);
+  }
+  Consume(section_size);
+  return Result::Ok;
+}
+
+// Returns Skip if more bytes are needed.
+template <typename Visitor>
+Result Stream<Visitor>::ProcessCode(SpanU8 data) {
+  // Nothing past the end of the code section belongs to it.
+  bool have_rest_of_section = data.size() >= section_remaining_;
+  data = data.first(std::min(data.size(), section_remaining_));
+  auto size = PeekU32(data);
+  if (!size.complete && !have_rest_of_section) {
+    return Result::Skip;
+  }
+
+  if (state_ == State::CodeCount) {
+    SpanU8 count_data = data;
+    code_count_ = Read<u32>(&count_data, ctx());
+    if (!code_count_) {
+      return Stop(Result::Fail);
+    }
+    Consume(size.length);
+    section_remaining_ -= size.length;
+    codes_read_ = 0;
+    auto res = visitor_.BeginCodeSection(
+        LazyCodeSection{code_count_, data.first(0), "code section", ctx()});
+    if (res == Result::Fail) {
+      return Stop(Result::Fail);
+    } else if (res == Result::Skip) {
+      // Like Visit, count the skipped bodies.
+      ctx().code_count += *code_count_;
+      state_ = State::SkipSection;
+    } else {
+      state_ = State::Code;
+    }
+    return Result::Ok;
+  }
+
+  size_t code_size = data.size();
+  if (size.complete && !size.malformed) {
+    code_size = std::min(code_size, size.length + size.value);
+    if (data.size() < size.length + size.value && !have_rest_of_section) {
+      return Result::Skip;
+    }
+  }
+  SpanU8 code_data = data.first(code_size);
+  auto code = Read<Code>(&code_data, ctx());
+  if (!code) {
+    // Like a LazySequence, stop at the first entry that can't be read.
+    if (EndCodeSection(data) == Result::Fail) {
+      return Stop(Result::Fail);
+    }
+    state_ = State::SkipSection;
+    return Result::Ok;
+  }
+  ++codes_read_;
+  if (VisitCode(*module_, *code, visitor_) == Result::Fail) {
+    return Stop(Result::Fail);
+  }
+  Consume(code_size);
+  section_remaining_ -= code_size;
+  return Result::Ok;
+}
+
+template <typename Visitor>
+Result Stream<Visitor>::EndCodeSection(SpanU8 rest) {
+  if (codes_read_ != *code_count_) {
+    ctx().errors.OnError(rest,
+                         concat("Expected code section to have count ",
+                                *code_count_, ", got ", codes_read_));
+  }
+  return visitor_.EndCodeSection(
+      LazyCodeSection{code_count_, rest.first(0), "code section", ctx()});
+}
+
+template <typename Visitor>
+Result Stream<Visitor>::Stop(Result result) {
+  state_ = State::Done;
+  result_ = result;
+  return result;
+}
+
+}  // namespace wasp::binary::visit
+
+#endif  // WASP_BINARY_VISIT_STREAM_H_
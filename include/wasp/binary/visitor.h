@@ -123,6 +123,15 @@ struct SkipVisitor : Visitor {
 template <typename Visitor>
 Result Visit(LazyModule&, Visitor&);
 
+// Visits a single section or function body. Visit calls these for each one;
+// they are also useful for visiting a module that arrives incrementally (see
+// visit::Stream).
+template <typename Visitor>
+Result VisitSection(LazyModule&, const At<Section>&, Visitor&);
+
+template <typename Visitor>
+Result VisitCode(LazyModule&, const At<Code>&, Visitor&);
+
 #define WASP_CHECK(x)      \
   if (x == Result::Fail) { \
     return Result::Fail;   \
@@ -177,6 +186,74 @@ Result Visit(LazyModule&, Visitor&);
     break;                                             \
   }
 
+template <typename Visitor>
+inline Result VisitCode(LazyModule& module,
+                        const At<Code>& code,
+                        Visitor& visitor) {
+  WASP_IF_OK(visitor.BeginCode(code), {
+    for (auto&& instr : ReadExpression(*code->body, module.ctx)) {
+      WASP_CHECK(visitor.OnInstruction(instr));
+    }
+    EndCode(code->body->data.last(0), module.ctx);
+    WASP_CHECK(visitor.EndCode(code));
+  })
+  return Result::Ok;
+}
+
+template <typename Visitor>
+inline Result VisitSection(LazyModule& module,
+                           const At<Section>& section,
+                           Visitor& visitor) {
+  auto res = visitor.OnSection(section);
+  if (res != Result::Ok) {
+    return res;
+  }
+
+  if (section->is_known()) {
+    const auto& known = section->known();
+    switch (known->id) {
+      WASP_SECTION(Type)
+      WASP_SECTION(Import)
+      WASP_SECTION_ELSE_SKIP(Function, {
+        module.ctx.defined_function_count += sec.count->value();
+      })
+      WASP_SECTION(Table)
+      WASP_SECTION(Memory)
+      WASP_SECTION(Global)
+      WASP_SECTION(Tag)
+      WASP_SECTION(Export)
+      WASP_OPT_SECTION(Start)
+      WASP_SECTION(Element)
+      WASP_OPT_SECTION(DataCount)
+
+      case SectionId::Code: {
+        auto sec = ReadCodeSection(known, module.ctx);
+        WASP_IF_OK_ELSE_SKIP(
+            visitor.BeginCodeSection(sec),
+            {
+              for (const auto& code : sec.sequence) {
+                WASP_CHECK(VisitCode(module, code, visitor));
+              }
+              WASP_CHECK(visitor.EndCodeSection(sec));
+            },
+            // If skipping this section, increment by the number of code
+            // items specified in this section.
+            { module.ctx.code_count += sec.count->value(); })
+        break;
+      }
+
+        WASP_SECTION_ELSE_SKIP(
+            Data,
+            // If skipping this section, increment by the number of data items
+            // specified in this section.
+            { module.ctx.data_count += sec.count->value(); })
+
+      default: break;
+    }
+  }
+  return Result::Ok;
+}
+
 template <typename Visitor>
 inline Result Visit(LazyModule& module, Visitor& visitor) {
   module.ctx.Reset();
@@ -186,62 +263,7 @@ inline Result Visit(LazyModule& module, Visitor& visitor) {
   }
 
   for (auto section : module.sections) {
-    auto res = visitor.OnSection(section);
-    if (res == Result::Skip) {
-      continue;
-    } else if (res == Result::Fail) {
-      return Result::Fail;
-    }
-
-    if (section->is_known()) {
-      const auto& known = section->known();
-      switch (known->id) {
-        WASP_SECTION(Type)
-        WASP_SECTION(Import)
-        WASP_SECTION_ELSE_SKIP(Function, {
-          module.ctx.defined_function_count += sec.count->value();
-        })
-        WASP_SECTION(Table)
-        WASP_SECTION(Memory)
-        WASP_SECTION(Global)
-        WASP_SECTION(Tag)
-        WASP_SECTION(Export)
-        WASP_OPT_SECTION(Start)
-        WASP_SECTION(Element)
-        WASP_OPT_SECTION(DataCount)
-
-        case SectionId::Code: {
-          auto sec = ReadCodeSection(known, module.ctx);
-          WASP_IF_OK_ELSE_SKIP(
-              visitor.BeginCodeSection(sec),
-              {
-                for (const auto& code : sec.sequence) {
-                  WASP_IF_OK(visitor.BeginCode(code), {
-                    for (auto&& instr :
-                         ReadExpression(*code->body, module.ctx)) {
-                      WASP_CHECK(visitor.OnInstruction(instr));
-                    }
-                    EndCode(code->body->data.last(0), module.ctx);
-                    WASP_CHECK(visitor.EndCode(code));
-                  })
-                }
-                WASP_CHECK(visitor.EndCodeSection(sec));
-              },
-              // If skipping this section, increment by the number of code
-              // items specified in this section.
-              { module.ctx.code_count += sec.count->value(); })
-          break;
-        }
-
-          WASP_SECTION_ELSE_SKIP(
-              Data,
-              // If skipping this section, increment by the number of data items
-              // specified in this section.
-              { module.ctx.data_count += sec.count->value(); })
-
-        default: break;
-      }
-    }
+    WASP_CHECK(VisitSection(module, section, visitor));
   }
   EndModule(module.data, module.ctx);
   return visitor.EndModule(module);
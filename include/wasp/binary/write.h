@@ -747,7 +747,7 @@ OutputIterator WriteKnownSection(SectionId section_id,
 
 template <typename Container, typename Iterator>
 Iterator WriteNonEmptyKnownSection(SectionId section_id,
-                                   Container container,
+                                   const Container& container,
                                    Iterator out) {
   if (!container.empty()) {
     out = WriteKnownSection(section_id, std::begin(container),
@@ -793,6 +793,24 @@ Iterator Write(const Module& value, Iterator out) {
   return out;
 }
 
+enum class CompactSizes { No, Yes };
+
+// Appends `value` to `buffer`, like Write(const Module&, Iterator), but
+// without writing each section and function body to a temporary buffer
+// first. Their sizes are written as 5-byte LEB128 placeholders instead, and
+// patched once the contents have been written.
+//
+// Padded LEB128s are valid, but larger than necessary. With CompactSizes::Yes
+// they are shrunk to their minimal encoding in a single final pass, so the
+// result is the same as Write(const Module&, Iterator).
+//
+// If `num_threads` is greater than 1, the function bodies are encoded in
+// parallel. The result is the same either way.
+void WriteModule(const Module&,
+                 Buffer&,
+                 CompactSizes = CompactSizes::Yes,
+                 Index num_threads = 1);
+
 }  // namespace wasp::binary
 
 #endif  // WASP_BINARY_WRITE_H_
@@ -17,10 +17,7 @@
 #ifndef WASP_CONVERT_TO_BINARY_H_
 #define WASP_CONVERT_TO_BINARY_H_
 
-#include <memory>
-#include <string>
-#include <vector>
-
+#include "wasp/base/arena.h"
 #include "wasp/base/at.h"
 #include "wasp/base/buffer.h"
 #include "wasp/base/features.h"
@@ -34,17 +31,14 @@ struct BinCtx {
   explicit BinCtx() = default;
   explicit BinCtx(const Features&);
 
-  string_view Add(std::string);
-  SpanU8 Add(Buffer);
+  string_view Add(string_view);
+  SpanU8 Add(SpanU8);
+  // Like Add, but equal strings share one copy. Used for names.
+  string_view Intern(string_view);
 
   Features features;
-
-  // TODO: The buffers need to have stable pointers (for use by string_view or
-  // span), so for now they are all std::unique_ptr<T>. This could be optimized
-  // in a number of ways, however (e.g. allocating in larger blocks of chars,
-  // and appending to that).
-  std::vector<std::unique_ptr<std::string>> strings;
-  std::vector<std::unique_ptr<Buffer>> buffers;
+  Arena arena;  // Owns the strings and buffers of the converted module.
+  Buffer scratch;
 };
 
 // Helpers.
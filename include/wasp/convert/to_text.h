@@ -17,11 +17,9 @@
 #ifndef WASP_CONVERT_TO_TEXT_H_
 #define WASP_CONVERT_TO_TEXT_H_
 
-#include <map>
-#include <memory>
 #include <string>
-#include <vector>
 
+#include "wasp/base/arena.h"
 #include "wasp/base/at.h"
 #include "wasp/base/buffer.h"
 #include "wasp/base/optional.h"
@@ -32,12 +30,11 @@ namespace wasp::convert {
 
 struct TextCtx {
   text::Text Add(string_view);
+  // Like Add, but equal strings share one copy. Used for names.
+  text::Text Intern(string_view);
 
-  // TODO: The buffers need to have stable pointers (for use by string_view or
-  // span), so for now they are all std::unique_ptr<T>. This could be optimized
-  // in a number of ways, however (e.g. allocating in larger blocks of chars,
-  // and appending to that).
-  std::vector<std::unique_ptr<std::string>> strings;
+  Arena arena;  // Owns the text of the converted module.
+  std::string scratch;
 };
 
 // Helpers.
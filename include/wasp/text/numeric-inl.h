@@ -20,12 +20,10 @@
 #include <charconv>
 #include <limits>
 
-#include "absl/strings/numbers.h"
 #include "absl/strings/str_cat.h"
 #include "absl/strings/str_format.h"
 
 #include "wasp/base/bitcast.h"
-#include "wasp/base/buffer.h"
 #include "wasp/base/macros.h"
 
 namespace wasp::text {
@@ -123,38 +121,6 @@ auto StrToInt(LiteralInfo info, SpanU8 span) -> optional<T> {
   return value;
 }
 
-inline void RemoveUnderscores(SpanU8 span, Buffer& out) {
-  std::copy_if(span.begin(), span.end(), std::back_inserter(out),
-               [](u8 c) { return c != '_'; });
-}
-
-template <typename T>
-auto SimpleAto(const char* str, T* value) -> bool;
-
-template <>
-inline auto SimpleAto<f32>(const char* str, f32* value) -> bool {
-  // Abseil's float conversions will silently convert large values into `inf`,
-  // which is not allowed by the Wasm text format. This function will only be
-  // used for normal values, so we know that if an `inf` is returned it is
-  // invalid.
-  return absl::SimpleAtof(str, value) && !std::isinf(*value);
-}
-
-template <>
-inline auto SimpleAto<f64>(const char* str, f64* value) -> bool {
-  // See the comment in SimpleAto<f32> above.
-  return absl::SimpleAtod(str, value) && !std::isinf(*value);
-}
-
-template <typename T>
-auto ParseFloat(SpanU8 span) -> optional<T> {
-  T value;
-  if (!SimpleAto(reinterpret_cast<const char*>(span.begin()), &value)) {
-    return nullopt;
-  }
-  return value;
-}
-
 template <typename Float>
 struct FloatTraits {};
 
@@ -215,15 +181,23 @@ auto MakeNanPayload(Sign sign, typename FloatTraits<T>::Int payload) -> T {
   return MakeFloat<T>(sign, FloatTraits<T>::exp_max, payload);
 }
 
+// Parses a decimal or hex float literal, which may have a sign and
+// underscores, without copying it. Returns nullopt if the value rounds to
+// infinity. Defined in numeric.cc.
+template <typename T>
+auto ParseFloat(SpanU8) -> optional<T>;
+
+template <>
+auto ParseFloat<f32>(SpanU8) -> optional<f32>;
+
+template <>
+auto ParseFloat<f64>(SpanU8) -> optional<f64>;
+
 template <typename T>
 auto StrToFloat(LiteralInfo info, SpanU8 span) -> optional<T> {
   switch (info.kind) {
-    case LiteralKind::Normal: {
-      Buffer vec;
-      RemoveUnderscores(span, vec);  // Always need to copy, to null-terminate.
-      vec.push_back(0);
-      return ParseFloat<T>(vec);
-    }
+    case LiteralKind::Normal:
+      return ParseFloat<T>(span);
 
     case LiteralKind::Nan:
       return MakeNan<T>(info.sign);
@@ -392,6 +366,11 @@ auto FloatToStr(T value, Base base) -> std::string {
         exp++;
       }
 
+      if (sig == 0) {
+        absl::StrAppend(&str, "0p0");
+        return str;
+      }
+
       // Remove trailing zeroes in mantissa.
       while ((sig & 1) == 0) {
         sig >>= 1;
@@ -17,11 +17,16 @@
 #ifndef WASP_TEXT_READ_NAME_MAP_H_
 #define WASP_TEXT_READ_NAME_MAP_H_
 
+#include <vector>
+
+#include "wasp/base/hashmap.h"
 #include "wasp/base/string_view.h"
 #include "wasp/text/types.h"
 
 namespace wasp::text {
 
+// Maps names to indexes, with nested scopes (for labels and let-bound
+// locals). Indexes count from the innermost scope outward.
 class NameMap {
  public:
   explicit NameMap();
@@ -39,9 +44,16 @@ class NameMap {
   auto Size() const -> Index;
 
  private:
-  optional<size_t> FindInRange(size_t begin, size_t end, BindVar) const;
+  static constexpr size_t kNone = ~size_t{0};
+
+  optional<size_t> Find(BindVar) const;
 
   std::vector<optional<BindVar>> names_;
+  // For each bound name in names_, the position of the binding that it
+  // shadows, or kNone.
+  std::vector<size_t> shadowed_;
+  // The position of the innermost binding of each name.
+  flat_hash_map<BindVar, size_t> innermost_;
   std::vector<size_t> stack_;
 };
 
@@ -72,6 +72,10 @@ inline OpcodeInfo::OpcodeInfo(Opcode opcode) : opcode{opcode}, features{0} {}
 inline OpcodeInfo::OpcodeInfo(Opcode opcode, Features features)
     : opcode{opcode}, features{features} {}
 
+inline string_view Text::contents() const {
+  return text.substr(1, text.size() - 2);
+}
+
 inline string_view Token::as_string_view() const {
   return ToStringView(loc);
 }
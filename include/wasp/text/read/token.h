@@ -41,6 +41,8 @@ enum class Sign { None, Plus, Minus };
 enum class LiteralKind { Normal, Nan, NanPayload, Infinity };
 enum class Base { Decimal, Hex };
 enum class HasUnderscores { No, Yes };
+enum class HasEscapes { No, Yes };
+enum class Utf8Validity { Unknown, Valid, Invalid };
 
 enum class SimdShape { I8X16, I16X8, I32X4, I64X2, F32X4, F64X2 };
 
@@ -74,8 +76,17 @@ struct Text {
   void AppendToBuffer(Buffer& buffer) const;
   auto ToString() const -> std::string;
 
+  // The text without its surrounding quotes. If there are no escapes, this is
+  // also the decoded text.
+  string_view contents() const;
+
   string_view text;
   u32 byte_size;
+
+  // Found by the lexer while scanning the text. Texts that weren't lexed use
+  // these defaults, so they are decoded before they are used.
+  HasEscapes has_escapes = HasEscapes::Yes;
+  Utf8Validity utf8 = Utf8Validity::Unknown;
 };
 
 struct Token {
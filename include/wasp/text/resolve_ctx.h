@@ -20,6 +20,7 @@
 #include <map>
 #include <vector>
 
+#include "wasp/base/hashmap.h"
 #include "wasp/base/optional.h"
 #include "wasp/base/string_view.h"
 #include "wasp/base/types.h"
@@ -63,13 +64,30 @@ class FunctionTypeMap {
   optional<FunctionType> Get(Index) const;
 
  private:
+  // A structural hash index over the function types in a List. Only the
+  // first of several identical types is indexed, so Find returns the lowest
+  // matching index, like a linear search would.
+  struct HashIndex {
+    static constexpr Index kNone = ~Index{0};
+
+    void Clear();
+    void Insert(const List&, Index);  // Must be called for every list entry.
+    auto Find(const List&, const FunctionType&, size_t hash) const
+        -> optional<Index>;
+
+    flat_hash_map<size_t, Index> heads;  // The first index with a given hash.
+    std::vector<Index> next;  // The next index with the same hash, or kNone.
+  };
+
   static DefinedType ToDefinedType(const FunctionType&);
-  static List::const_iterator FindIter(const List&, const FunctionType&);
+  static size_t Hash(const FunctionType&);
   static bool IsSame(const FunctionType&, const FunctionType&);
   static bool IsSame(const ValueTypeList&, const ValueTypeList&);
 
   List list_;
   List deferred_list_;
+  HashIndex index_;
+  HashIndex deferred_index_;
 };
 
 struct ResolveCtx {
@@ -19,9 +19,12 @@
 
 #include <algorithm>
 #include <cassert>
+#include <cstddef>
+#include <iterator>
 #include <string>
 #include <type_traits>
 
+#include "wasp/base/buffer.h"
 #include "wasp/base/concat.h"
 #include "wasp/base/formatters.h"
 #include "wasp/base/types.h"
@@ -32,26 +35,62 @@
 namespace wasp::text {
 
 struct WriteCtx {
-  void ClearSeparator() { separator = ""; }
-  void Space() { separator = " "; }
-  void Newline() { separator = indent; }
+  enum class Separator : u8 { None, Space, Newline };
 
-  void Indent() { indent += "  "; }
+  void ClearSeparator() { separator = Separator::None; }
+  void Space() { separator = Separator::Space; }
+  void Newline() {
+    separator = Separator::Newline;
+    newline_indent = indent;
+  }
+
+  void Indent() { ++indent; }
 
-  void DedentWithMinimum(size_t minimum) {
-    if (indent.size() > minimum) {
-      indent.erase(indent.size() - 2);
+  void DedentWithMinimum(Index minimum) {
+    if (indent > minimum) {
+      --indent;
     }
   }
 
-  void Dedent() { DedentWithMinimum(2); }
-  void DedentNoToplevel() { DedentWithMinimum(3); }
+  void Dedent() { DedentWithMinimum(0); }
+  void DedentNoToplevel() { DedentWithMinimum(1); }
 
-  std::string separator;
-  std::string indent = "\n";
+  Separator separator = Separator::None;
+  Index indent = 0;          // In steps of two spaces.
+  Index newline_indent = 0;  // The indent at the last call to Newline.
   Base base = Base::Decimal;
 };
 
+// An output iterator that appends to a Buffer, like std::back_inserter. The
+// WriteRaw overloads below append a whole string at once instead of one char
+// at a time, so this is the fastest way to write text. Reserve the Buffer up
+// front if the size of the output can be estimated.
+class BufferInserter {
+ public:
+  using iterator_category = std::output_iterator_tag;
+  using value_type = void;
+  using difference_type = std::ptrdiff_t;
+  using pointer = void;
+  using reference = void;
+
+  explicit BufferInserter(Buffer& buffer) : buffer_{&buffer} {}
+
+  BufferInserter& operator=(char value) {
+    buffer_->push_back(static_cast<u8>(value));
+    return *this;
+  }
+  BufferInserter& operator*() { return *this; }
+  BufferInserter& operator++() { return *this; }
+  BufferInserter& operator++(int) { return *this; }
+
+  void Append(string_view value) {
+    buffer_->insert(buffer_->end(), value.begin(), value.end());
+  }
+
+ private:
+  Buffer* buffer_;
+};
+
 // WriteRaw
 template <typename Iterator>
 Iterator WriteRaw(WriteCtx& ctx, char value, Iterator out) {
@@ -66,12 +105,55 @@ Iterator WriteRaw(WriteCtx& ctx, string_view value, Iterator out) {
 
 template <typename Iterator>
 Iterator WriteRaw(WriteCtx& ctx, const std::string& value, Iterator out) {
-  return std::copy(value.begin(), value.end(), out);
+  return WriteRaw(ctx, string_view{value}, out);
+}
+
+inline BufferInserter WriteRaw(WriteCtx& ctx,
+                               string_view value,
+                               BufferInserter out) {
+  out.Append(value);
+  return out;
+}
+
+inline BufferInserter WriteRaw(WriteCtx& ctx,
+                               const std::string& value,
+                               BufferInserter out) {
+  out.Append(value);
+  return out;
+}
+
+// A newline followed by the indentation for the first 32 levels, so a
+// newline and its indentation are usually written with a single WriteRaw.
+constexpr string_view kNewlineAndIndent =
+    "\n                                                                ";
+
+template <typename Iterator>
+Iterator WriteNewline(WriteCtx& ctx, Index indent, Iterator out) {
+  constexpr size_t kMaxSpaces = kNewlineAndIndent.size() - 1;
+  size_t spaces = size_t{indent} * 2;
+  size_t count = std::min(spaces, kMaxSpaces);
+  out = WriteRaw(ctx, kNewlineAndIndent.substr(0, 1 + count), out);
+  for (spaces -= count; spaces > 0; spaces -= count) {
+    count = std::min(spaces, kMaxSpaces);
+    out = WriteRaw(ctx, kNewlineAndIndent.substr(1, count), out);
+  }
+  return out;
 }
 
 template <typename Iterator>
 Iterator WriteSeparator(WriteCtx& ctx, Iterator out) {
-  out = WriteRaw(ctx, ctx.separator, out);
+  switch (ctx.separator) {
+    case WriteCtx::Separator::None:
+      break;
+
+    case WriteCtx::Separator::Space:
+      out = WriteRaw(ctx, ' ', out);
+      break;
+
+    case WriteCtx::Separator::Newline:
+      out = WriteNewline(ctx, ctx.newline_indent, out);
+      break;
+  }
   ctx.ClearSeparator();
   return out;
 }
@@ -203,6 +285,19 @@ Iterator Write(WriteCtx& ctx, const TextList& values, Iterator out) {
 
 template <typename Iterator>
 Iterator Write(WriteCtx& ctx, const ValueType& value, Iterator out) {
+  // Numeric types are by far the most common, so write them without
+  // formatting them first.
+  if (value.is_numeric_type()) {
+    switch (*value.numeric_type()) {
+#define WASP_V(val, Name, str) \
+  case NumericType::Name:      \
+    return Write(ctx, string_view{str}, out);
+#define WASP_FEATURE_V(val, Name, str, feature) WASP_V(val, Name, str)
+#include "wasp/base/inc/numeric_type.inc"
+#undef WASP_V
+#undef WASP_FEATURE_V
+    }
+  }
   return WriteFormat(ctx, value, out);
 }
 
@@ -450,6 +545,21 @@ Iterator Write(WriteCtx& ctx,
 
 template <typename Iterator>
 Iterator Write(WriteCtx& ctx, const Opcode& value, Iterator out) {
+  // Opcodes are numbered sequentially, so their names can be looked up
+  // directly instead of formatting them.
+  static constexpr string_view kOpcodeNames[] = {
+#define WASP_V(prefix, val, Name, str, ...) str,
+#define WASP_FEATURE_V(...) WASP_V(__VA_ARGS__)
+#define WASP_PREFIX_V(...) WASP_V(__VA_ARGS__)
+#include "wasp/base/inc/opcode.inc"
+#undef WASP_V
+#undef WASP_FEATURE_V
+#undef WASP_PREFIX_V
+  };
+  auto index = static_cast<size_t>(value);
+  if (index < std::size(kOpcodeNames)) {
+    return Write(ctx, kOpcodeNames[index], out);
+  }
   return WriteFormat(ctx, value, out);
 }
 
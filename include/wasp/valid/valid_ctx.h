@@ -17,6 +17,7 @@
 #ifndef WASP_VALID_CONTEXT_H_
 #define WASP_VALID_CONTEXT_H_
 
+#include <deque>
 #include <map>
 #include <set>
 #include <vector>
@@ -45,23 +46,33 @@ enum class LabelType {
   Let,
 };
 
+// The param and result types refer to storage owned by the ValidCtx (see
+// ValidCtx::GetStackFunctionType and ValidCtx::GetSingleTypeSpan), or to
+// static storage, so a Label is cheap to create and copy.
 struct Label {
   Label(LabelType,
         StackTypeSpan param_types,
         StackTypeSpan result_types,
         Index type_stack_limit);
 
-  const StackTypeList& br_types() const {
+  StackTypeSpan br_types() const {
     return label_type == LabelType::Loop ? param_types : result_types;
   }
 
   LabelType label_type;
-  StackTypeList param_types;
-  StackTypeList result_types;
+  StackTypeSpan param_types;
+  StackTypeSpan result_types;
   Index type_stack_limit;
   bool unreachable;
 };
 
+/// ---
+/// A function type's params and results, converted to stack types.
+struct StackFunctionType {
+  StackTypeList param_types;
+  StackTypeList result_types;
+};
+
 class SameTypes {
  public:
   void Reset(Index);
@@ -102,6 +113,16 @@ struct ValidCtx {
   bool IsStructType(Index) const;
   bool IsArrayType(Index) const;
 
+  // Returns the stack types of function type `index`, which must be a valid
+  // index of a function type. Each type is converted only once, and the
+  // returned lists are never modified, so spans of them stay valid until the
+  // next Reset().
+  auto GetStackFunctionType(Index) -> const StackFunctionType&;
+
+  // Returns a span containing just `type`, which stays valid until the next
+  // Reset().
+  auto GetSingleTypeSpan(StackType) -> StackTypeSpan;
+
   Features features;
   Errors* errors;
 
@@ -125,6 +146,12 @@ struct ValidCtx {
 
   SameTypes same_types;
   MatchTypes match_types;
+
+  // Caches for GetStackFunctionType and GetSingleTypeSpan. Growing the vector
+  // moves the StackTypeLists, but not their elements; a deque doesn't move its
+  // elements at all.
+  std::vector<StackFunctionType> stack_function_types;
+  std::deque<StackType> single_types;
 };
 
 }  // namespace wasp::valid
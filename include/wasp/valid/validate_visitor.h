@@ -17,6 +17,11 @@
 #ifndef WASP_VALID_VALIDATE_VISITOR_H_
 #define WASP_VALID_VALIDATE_VISITOR_H_
 
+#include <vector>
+
+#include "wasp/base/buffer.h"
+#include "wasp/base/span.h"
+#include "wasp/base/types.h"
 #include "wasp/binary/visitor.h"
 #include "wasp/valid/valid_ctx.h"
 #include "wasp/valid/validate.h"
@@ -31,7 +36,20 @@ struct ValidateVisitor : binary::visit::Visitor {
   using Result = binary::visit::Result;
 
   explicit ValidateVisitor(Features features, Errors& errors);
+  // When `num_threads` is greater than 1, function bodies are not validated
+  // as they are visited. Instead they are collected and validated in parallel
+  // at the end of the code section, and their errors are reported in function
+  // order. Bodies that aren't part of the module's data, e.g. those visited
+  // by binary::visit::Stream, are copied until then. Once the copies reach
+  // `max_pending_copy_size` bytes, the pending bodies are validated early, so
+  // at most that much (plus one body) is held at a time. The errors for a
+  // copied body refer to the copy rather than the original data; the copies
+  // are kept once an error has been reported.
+  explicit ValidateVisitor(Features features,
+                           Errors& errors,
+                           Index num_threads);
 
+  auto BeginModule(binary::LazyModule&) -> Result;
   auto BeginTypeSection(binary::LazyTypeSection) -> Result;
   auto OnType(const At<binary::DefinedType>&) -> Result;
   auto EndTypeSection(binary::LazyTypeSection) -> Result;
@@ -47,13 +65,21 @@ struct ValidateVisitor : binary::visit::Visitor {
   auto OnDataCount(const At<binary::DataCount>&) -> Result;
   auto BeginCode(const At<binary::Code>&) -> Result;
   auto OnInstruction(const At<binary::Instruction>&) -> Result;
+  auto EndCodeSection(binary::LazyCodeSection) -> Result;
   auto OnData(const At<binary::DataSegment>&) -> Result;
 
   auto FailUnless(bool) -> Result;
+  bool ValidatePendingCodes();
 
   ValidCtx ctx;
   Features features;
   Errors& errors;
+  Index num_threads = 1;
+  SpanU8 module_data;
+  std::vector<At<binary::Code>> pending_codes;
+  std::vector<Buffer> pending_code_copies;
+  size_t pending_copy_size = 0;
+  size_t max_pending_copy_size = 4 * 1024 * 1024;
 };
 
 }  // namespace valid
@@ -0,0 +1,119 @@
+//
+// Copyright 2020 WebAssembly Community Group participants
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//     http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+//
+
+#include "wasp/base/arena.h"
+
+#include <cstring>
+#include <utility>
+
+namespace wasp {
+
+Arena::Arena() : Arena{kDefaultChunkSize} {}
+
+Arena::Arena(size_t chunk_size) : chunk_size_{chunk_size} {}
+
+Arena::Arena(Arena&& other) noexcept
+    : chunk_size_{other.chunk_size_},
+      chunks_{std::move(other.chunks_)},
+      chunk_{std::exchange(other.chunk_, nullptr)},
+      next_{std::exchange(other.next_, nullptr)},
+      end_{std::exchange(other.end_, nullptr)},
+      size_{std::exchange(other.size_, 0)},
+      interned_{std::move(other.interned_)} {
+  other.chunks_.clear();
+  other.interned_.clear();
+}
+
+Arena& Arena::operator=(Arena&& other) noexcept {
+  if (this != &other) {
+    chunk_size_ = other.chunk_size_;
+    chunks_ = std::move(other.chunks_);
+    chunk_ = std::exchange(other.chunk_, nullptr);
+    next_ = std::exchange(other.next_, nullptr);
+    end_ = std::exchange(other.end_, nullptr);
+    size_ = std::exchange(other.size_, 0);
+    interned_ = std::move(other.interned_);
+    other.chunks_.clear();
+    other.interned_.clear();
+  }
+  return *this;
+}
+
+SpanU8 Arena::Add(SpanU8 bytes) {
+  if (bytes.empty()) {
+    return {};
+  }
+  u8* copy = Allocate(bytes.size());
+  std::memcpy(copy, bytes.data(), bytes.size());
+  return SpanU8{copy, bytes.size()};
+}
+
+string_view Arena::Add(string_view str) {
+  auto bytes =
+      Add(SpanU8{reinterpret_cast<const u8*>(str.data()), str.size()});
+  return string_view{reinterpret_cast<const char*>(bytes.data()),
+                     bytes.size()};
+}
+
+string_view Arena::Intern(string_view str) {
+  auto iter = interned_.find(str);
+  if (iter != interned_.end()) {
+    return *iter;
+  }
+  auto copy = Add(str);
+  interned_.insert(copy);
+  return copy;
+}
+
+void Arena::Clear() {
+  // Keep the current chunk, since it is always chunk_size_ bytes; a chunk
+  // that holds a single large copy may not be.
+  std::unique_ptr<u8[]> keep;
+  for (auto& chunk : chunks_) {
+    if (chunk.get() == chunk_) {
+      keep = std::move(chunk);
+      break;
+    }
+  }
+  chunks_.clear();
+  if (keep) {
+    chunks_.push_back(std::move(keep));
+  }
+  next_ = chunk_;
+  end_ = chunk_ ? chunk_ + chunk_size_ : nullptr;
+  size_ = 0;
+  interned_.clear();
+}
+
+u8* Arena::Allocate(size_t size) {
+  size_ += size;
+  if (size > static_cast<size_t>(end_ - next_)) {
+    if (size > chunk_size_ / 4) {
+      // Give large copies their own chunk, rather than wasting the rest of
+      // the current one.
+      chunks_.emplace_back(new u8[size]);
+      return chunks_.back().get();
+    }
+    chunks_.emplace_back(new u8[chunk_size_]);
+    chunk_ = next_ = chunks_.back().get();
+    end_ = chunk_ + chunk_size_;
+  }
+  u8* result = next_;
+  next_ += size;
+  return result;
+}
+
+}  // namespace wasp
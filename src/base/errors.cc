@@ -0,0 +1,38 @@
+//
+// Copyright 2020 WebAssembly Community Group participants
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//     http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+//
+
+#include "wasp/base/errors.h"
+
+#include "wasp/base/errors_context_guard.h"
+
+namespace wasp {
+
+void Errors::FlushLazyContexts() {
+  FlushLazyContexts(lazy_context_);
+}
+
+void Errors::FlushLazyContexts(ErrorsContextGuard* guard) {
+  // Push the outermost contexts first. Everything below a context that has
+  // already been pushed has been pushed too.
+  if (!guard || guard->pushed_context_) {
+    return;
+  }
+  FlushLazyContexts(guard->prev_);
+  HandlePushContext(guard->loc_, guard->desc_);
+  guard->pushed_context_ = true;
+}
+
+}  // namespace wasp
@@ -0,0 +1,58 @@
+//
+// Copyright 2020 WebAssembly Community Group participants
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//     http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+//
+
+#include "wasp/base/errors_buffer.h"
+
+#include <cassert>
+
+namespace wasp {
+
+void ErrorsBuffer::Clear() {
+  context_stack_.clear();
+  errors_.clear();
+}
+
+void ErrorsBuffer::ReplayTo(Errors& errors) const {
+  for (const auto& error : errors_) {
+    for (const auto& context : error.context_stack) {
+      errors.PushContext(context.loc, context.desc);
+    }
+    errors.OnError(error.loc, error.message);
+    for (size_t i = 0; i < error.context_stack.size(); ++i) {
+      errors.PopContext();
+    }
+  }
+}
+
+void ErrorsBuffer::HandlePushContext(Location loc, string_view desc) {
+  context_stack_.emplace_back(loc, desc);
+}
+
+void ErrorsBuffer::HandlePopContext() {
+  assert(!context_stack_.empty());
+  context_stack_.pop_back();
+}
+
+void ErrorsBuffer::HandleOnError(Location loc, string_view message) {
+  BufferedError error{{}, loc, std::string{message}};
+  error.context_stack.reserve(context_stack_.size());
+  for (const auto& [context_loc, desc] : context_stack_) {
+    error.context_stack.push_back(Context{context_loc, std::string{desc}});
+  }
+  errors_.push_back(std::move(error));
+}
+
+}  // namespace wasp
@@ -17,7 +17,20 @@
 #include "wasp/base/file.h"
 
 #include <fstream>
+#include <iterator>
 #include <string>
+#include <utility>
+
+#if !defined(_WIN32)
+#define WASP_HAS_MMAP 1
+#include <errno.h>
+#include <fcntl.h>
+#include <sys/mman.h>
+#include <sys/stat.h>
+#include <unistd.h>
+#else
+#define WASP_HAS_MMAP 0
+#endif
 
 namespace wasp {
 
@@ -29,9 +42,21 @@ optional<Buffer> ReadFile(string_view filename) {
 
   Buffer buffer;
   stream.seekg(0, std::ios::end);
-  buffer.resize(stream.tellg());
+  auto size = stream.tellg();
+  if (size == std::streampos(-1)) {
+    // Not seekable (e.g. a pipe), so read until EOF instead.
+    stream.clear();
+    buffer.assign(std::istreambuf_iterator<char>{stream},
+                  std::istreambuf_iterator<char>{});
+    if (stream.bad()) {
+      return nullopt;
+    }
+    return buffer;
+  }
+
+  buffer.resize(size);
   stream.seekg(0, std::ios::beg);
-  stream.read(reinterpret_cast<char*>(&buffer[0]), buffer.size());
+  stream.read(reinterpret_cast<char*>(buffer.data()), buffer.size());
   if (stream.fail()) {
     return nullopt;
   }
@@ -39,4 +64,116 @@ optional<Buffer> ReadFile(string_view filename) {
   return buffer;
 }
 
+MappedFile::MappedFile(Buffer buffer) : buffer_{std::move(buffer)} {
+  data_ = SpanU8{buffer_};
+}
+
+MappedFile::MappedFile(MappedFile&& other) {
+  *this = std::move(other);
+}
+
+MappedFile& MappedFile::operator=(MappedFile&& other) {
+  if (this != &other) {
+    Unmap();
+    // Moving a std::vector keeps its storage, so data_ remains valid when it
+    // refers to buffer_.
+    data_ = std::exchange(other.data_, SpanU8{});
+    buffer_ = std::move(other.buffer_);
+    is_mapped_ = std::exchange(other.is_mapped_, false);
+  }
+  return *this;
+}
+
+MappedFile::~MappedFile() {
+  Unmap();
+}
+
+void MappedFile::Unmap() {
+#if WASP_HAS_MMAP
+  if (is_mapped_) {
+    munmap(const_cast<u8*>(data_.data()), data_.size());
+    is_mapped_ = false;
+  }
+#endif
+  data_ = SpanU8{};
+}
+
+#if WASP_HAS_MMAP
+namespace {
+
+// Reads from `fd` until EOF. Used for files that can't be mapped; a pipe can
+// only be read once, so this must use the fd that was already opened.
+optional<Buffer> ReadToEnd(int fd) {
+  constexpr size_t kChunkSize = 64 * 1024;
+  Buffer buffer;
+  size_t size = 0;
+  for (;;) {
+    buffer.resize(size + kChunkSize);
+    ssize_t count = read(fd, buffer.data() + size, kChunkSize);
+    if (count < 0) {
+      if (errno == EINTR) {
+        continue;
+      }
+      return nullopt;
+    }
+    if (count == 0) {
+      break;
+    }
+    size += static_cast<size_t>(count);
+  }
+  buffer.resize(size);
+  return buffer;
+}
+
+}  // namespace
+#endif
+
+optional<MappedFile> MapFile(string_view filename) {
+#if WASP_HAS_MMAP
+  std::string path{filename};
+  int fd = open(path.c_str(), O_RDONLY | O_CLOEXEC);
+  if (fd < 0) {
+    return nullopt;
+  }
+
+  struct stat st;
+  bool is_mappable =
+      fstat(fd, &st) == 0 && S_ISREG(st.st_mode) && st.st_size > 0;
+  void* addr = MAP_FAILED;
+  size_t size = 0;
+  if (is_mappable) {
+    size = static_cast<size_t>(st.st_size);
+    addr = mmap(nullptr, size, PROT_READ, MAP_PRIVATE, fd, 0);
+  }
+
+  if (addr == MAP_FAILED) {
+    auto optbuf = ReadToEnd(fd);
+    close(fd);
+    if (!optbuf) {
+      return nullopt;
+    }
+    return MappedFile{std::move(*optbuf)};
+  }
+
+  // The mapping keeps its own reference to the file.
+  close(fd);
+
+  // Modules are read front-to-back, so ask the kernel for aggressive
+  // readahead. These are only hints; failures are ignored.
+  madvise(addr, size, MADV_SEQUENTIAL);
+  madvise(addr, size, MADV_WILLNEED);
+
+  MappedFile file;
+  file.data_ = SpanU8{static_cast<const u8*>(addr), size};
+  file.is_mapped_ = true;
+  return file;
+#else
+  auto optbuf = ReadFile(filename);
+  if (!optbuf) {
+    return nullopt;
+  }
+  return MappedFile{std::move(*optbuf)};
+#endif
+}
+
 }  // namespace wasp
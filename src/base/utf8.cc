@@ -16,10 +16,23 @@
 
 #include "wasp/base/utf8.h"
 
+#include <cassert>
+#include <cstring>
+
 #include "wasp/base/types.h"
 
+#if (defined(__x86_64__) || defined(__i386__)) && \
+    (defined(__GNUC__) || defined(__clang__))
+#define WASP_UTF8_X86 1
+#include <immintrin.h>
+#else
+#define WASP_UTF8_X86 0
+#endif
+
 namespace wasp {
 
+namespace {
+
 // Decoder modified from https://bjoern.hoehrmann.de/utf-8/decoder/dfa/, with
 // the following license:
 //
@@ -43,32 +56,365 @@ namespace wasp {
 // FROM, OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS
 // IN THE SOFTWARE.
 
+constexpr u8 kUtf8Dfa[] = {
+  0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0, // 00..1f
+  0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0, // 20..3f
+  0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0, // 40..5f
+  0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0, // 60..7f
+  1,1,1,1,1,1,1,1,1,1,1,1,1,1,1,1,9,9,9,9,9,9,9,9,9,9,9,9,9,9,9,9, // 80..9f
+  7,7,7,7,7,7,7,7,7,7,7,7,7,7,7,7,7,7,7,7,7,7,7,7,7,7,7,7,7,7,7,7, // a0..bf
+  8,8,2,2,2,2,2,2,2,2,2,2,2,2,2,2,2,2,2,2,2,2,2,2,2,2,2,2,2,2,2,2, // c0..df
+  0xa,0x3,0x3,0x3,0x3,0x3,0x3,0x3,0x3,0x3,0x3,0x3,0x3,0x4,0x3,0x3, // e0..ef
+  0xb,0x6,0x6,0x6,0x5,0x8,0x8,0x8,0x8,0x8,0x8,0x8,0x8,0x8,0x8,0x8, // f0..ff
+  0x0,0x1,0x2,0x3,0x5,0x8,0x7,0x1,0x1,0x1,0x4,0x6,0x1,0x1,0x1,0x1, // s0..s0
+  1,1,1,1,1,1,1,1,1,1,1,1,1,1,1,1,1,0,1,1,1,1,1,0,1,0,1,1,1,1,1,1, // s1..s2
+  1,2,1,1,1,1,1,2,1,2,1,1,1,1,1,1,1,1,1,1,1,1,1,2,1,1,1,1,1,1,1,1, // s3..s4
+  1,2,1,1,1,1,1,1,1,2,1,1,1,1,1,1,1,1,1,1,1,1,1,3,1,3,1,1,1,1,1,1, // s5..s6
+  1,3,1,1,1,1,1,3,1,3,1,1,1,1,1,1,1,3,1,1,1,1,1,1,1,1,1,1,1,1,1,1, // s7..s8
+};
+
+constexpr u32 kAccept = 0;
+constexpr u32 kReject = 1;
+
+// Runs the DFA over [p, end) from the given state. Returns kReject as soon as
+// it is reached.
+u32 RunDfa(u32 state, const u8* p, const u8* end) {
+  while (p != end) {
+    if (state == kAccept) {
+      // ASCII bytes leave the DFA in the accept state, so skip runs of them.
+      while (end - p >= 8) {
+        u64 word;
+        std::memcpy(&word, p, sizeof(word));
+        if (word & 0x8080808080808080ull) {
+          break;
+        }
+        p += 8;
+      }
+      if (p == end) {
+        break;
+      }
+    }
+    state = kUtf8Dfa[256 + state * 16 + kUtf8Dfa[*p++]];
+    if (state == kReject) {
+      break;
+    }
+  }
+  return state;
+}
+
+bool IsValidUtf8Portable(string_view s) {
+  auto* p = reinterpret_cast<const u8*>(s.data());
+  return RunDfa(kAccept, p, p + s.size()) == kAccept;
+}
+
+#if WASP_UTF8_X86
+
+// The SIMD validators use the lookup algorithm from "Validating UTF-8 In Less
+// Than One Instruction Per Byte" (Keiser and Lemire, 2021). Every pair of
+// adjacent bytes is classified with three 16-entry table lookups, on the high
+// and low nibble of the first byte and the high nibble of the second. Each
+// bit of the result is one kind of error, so ANDing the lookups leaves a bit
+// set only if both bytes agree that it's an error. Three and four byte
+// sequences are then checked by requiring continuation bytes exactly where
+// the lead bytes two and three bytes back expect them.
+
+constexpr u8 kTooShort = 1 << 0;      // 11______ 0_______, 11______ 11______
+constexpr u8 kTooLong = 1 << 1;       // 0_______ 10______
+constexpr u8 kOverlong3 = 1 << 2;     // 11100000 100_____
+constexpr u8 kTooLarge = 1 << 3;      // 11110100 1001____, 11110100 101_____
+constexpr u8 kSurrogate = 1 << 4;     // 11101101 101_____
+constexpr u8 kOverlong2 = 1 << 5;     // 1100000_ 10______
+constexpr u8 kTooLarge1000 = 1 << 6;  // 11110101+ 1000____
+constexpr u8 kOverlong4 = 1 << 6;     // 11110000 1000____
+constexpr u8 kTwoConts = 1 << 7;      // 10______ 10______
+constexpr u8 kCarry = kTooShort | kTooLong | kTwoConts;
+
+constexpr u8 kByte1High[16] = {
+    // 0_______ ________
+    kTooLong, kTooLong, kTooLong, kTooLong,
+    kTooLong, kTooLong, kTooLong, kTooLong,
+    // 10______ ________
+    kTwoConts, kTwoConts, kTwoConts, kTwoConts,
+    // 1100____ ________
+    kTooShort | kOverlong2,
+    // 1101____ ________
+    kTooShort,
+    // 1110____ ________
+    kTooShort | kOverlong3 | kSurrogate,
+    // 1111____ ________
+    kTooShort | kTooLarge | kTooLarge1000 | kOverlong4,
+};
+
+constexpr u8 kByte1Low[16] = {
+    // ____0000 ________
+    kCarry | kOverlong3 | kOverlong2 | kOverlong4,
+    // ____0001 ________
+    kCarry | kOverlong2,
+    // ____001_ ________
+    kCarry,
+    kCarry,
+    // ____0100 ________
+    kCarry | kTooLarge,
+    // ____0101 ________
+    kCarry | kTooLarge | kTooLarge1000,
+    // ____011_ ________
+    kCarry | kTooLarge | kTooLarge1000,
+    kCarry | kTooLarge | kTooLarge1000,
+    // ____1___ ________
+    kCarry | kTooLarge | kTooLarge1000,
+    kCarry | kTooLarge | kTooLarge1000,
+    kCarry | kTooLarge | kTooLarge1000,
+    kCarry | kTooLarge | kTooLarge1000,
+    kCarry | kTooLarge | kTooLarge1000,
+    // ____1101 ________
+    kCarry | kTooLarge | kTooLarge1000 | kSurrogate,
+    kCarry | kTooLarge | kTooLarge1000,
+    kCarry | kTooLarge | kTooLarge1000,
+};
+
+constexpr u8 kByte2High[16] = {
+    // ________ 0_______
+    kTooShort, kTooShort, kTooShort, kTooShort,
+    kTooShort, kTooShort, kTooShort, kTooShort,
+    // ________ 1000____
+    kTooLong | kOverlong2 | kTwoConts | kOverlong3 | kTooLarge1000 | kOverlong4,
+    // ________ 1001____
+    kTooLong | kOverlong2 | kTwoConts | kOverlong3 | kTooLarge,
+    // ________ 101_____
+    kTooLong | kOverlong2 | kTwoConts | kSurrogate | kTooLarge,
+    kTooLong | kOverlong2 | kTwoConts | kSurrogate | kTooLarge,
+    // ________ 11______
+    kTooShort, kTooShort, kTooShort, kTooShort,
+};
+
+// A block ends with an incomplete sequence if any of its last three bytes is
+// a lead byte that needs more continuation bytes than are left; i.e. if it is
+// greater than the corresponding byte here. The SSE validator uses the last
+// 16 bytes.
+constexpr u8 kIncompleteMax[32] = {
+    0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff,
+    0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff,
+    0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff,
+    0xff, 0xff, 0xff, 0xff, 0xff, 0xef, 0xdf, 0xbf,
+};
+
+#define WASP_TARGET_SSE41 __attribute__((target("sse4.1")))
+#define WASP_TARGET_AVX2 __attribute__((target("avx2")))
+
+struct Sse41State {
+  __m128i error;
+  __m128i prev_input;
+  __m128i prev_incomplete;
+};
+
+WASP_TARGET_SSE41
+inline __m128i LoadSse41(const u8* p) {
+  return _mm_loadu_si128(reinterpret_cast<const __m128i*>(p));
+}
+
+WASP_TARGET_SSE41
+inline __m128i HighNibbleSse41(__m128i v) {
+  return _mm_and_si128(_mm_srli_epi16(v, 4), _mm_set1_epi8(0x0f));
+}
+
+WASP_TARGET_SSE41
+inline void ValidateBlockSse41(Sse41State& state, __m128i input) {
+  if (_mm_movemask_epi8(input) == 0) {
+    // An ASCII block is valid, unless the previous block was incomplete.
+    state.error = _mm_or_si128(state.error, state.prev_incomplete);
+  } else {
+    __m128i prev1 = _mm_alignr_epi8(input, state.prev_input, 15);
+    __m128i prev2 = _mm_alignr_epi8(input, state.prev_input, 14);
+    __m128i prev3 = _mm_alignr_epi8(input, state.prev_input, 13);
+    __m128i special = _mm_and_si128(
+        _mm_and_si128(
+            _mm_shuffle_epi8(LoadSse41(kByte1High), HighNibbleSse41(prev1)),
+            _mm_shuffle_epi8(LoadSse41(kByte1Low),
+                             _mm_and_si128(prev1, _mm_set1_epi8(0x0f)))),
+        _mm_shuffle_epi8(LoadSse41(kByte2High), HighNibbleSse41(input)));
+    // Only 111_____ and 1111____ are >= 0x80 after subtracting.
+    __m128i is_third = _mm_subs_epu8(prev2, _mm_set1_epi8(0xe0 - 0x80));
+    __m128i is_fourth = _mm_subs_epu8(prev3, _mm_set1_epi8(0xf0 - 0x80));
+    __m128i must_be_cont = _mm_and_si128(_mm_or_si128(is_third, is_fourth),
+                                         _mm_set1_epi8(char(0x80)));
+    state.error =
+        _mm_or_si128(state.error, _mm_xor_si128(must_be_cont, special));
+    state.prev_incomplete =
+        _mm_subs_epu8(input, LoadSse41(kIncompleteMax + 16));
+  }
+  state.prev_input = input;
+}
+
+WASP_TARGET_SSE41
+bool IsValidUtf8Sse41(string_view s) {
+  auto* p = reinterpret_cast<const u8*>(s.data());
+  size_t size = s.size();
+  Sse41State state{_mm_setzero_si128(), _mm_setzero_si128(),
+                   _mm_setzero_si128()};
+  size_t i = 0;
+  for (; i + 16 <= size; i += 16) {
+    ValidateBlockSse41(state, LoadSse41(p + i));
+  }
+  // Pad the rest with zeroes; an incomplete sequence at the end of the string
+  // is then followed by ASCII, which is an error.
+  u8 tail[16] = {};
+  std::memcpy(tail, p + i, size - i);
+  ValidateBlockSse41(state, LoadSse41(tail));
+  __m128i error = _mm_or_si128(state.error, state.prev_incomplete);
+  return _mm_testz_si128(error, error);
+}
+
+struct Avx2State {
+  __m256i error;
+  __m256i prev_input;
+  __m256i prev_incomplete;
+};
+
+WASP_TARGET_AVX2
+inline __m256i LoadAvx2(const u8* p) {
+  return _mm256_loadu_si256(reinterpret_cast<const __m256i*>(p));
+}
+
+WASP_TARGET_AVX2
+inline __m256i LoadTableAvx2(const u8* table) {
+  return _mm256_broadcastsi128_si256(
+      _mm_loadu_si128(reinterpret_cast<const __m128i*>(table)));
+}
+
+WASP_TARGET_AVX2
+inline __m256i HighNibbleAvx2(__m256i v) {
+  return _mm256_and_si256(_mm256_srli_epi16(v, 4), _mm256_set1_epi8(0x0f));
+}
+
+WASP_TARGET_AVX2
+inline void ValidateBlockAvx2(Avx2State& state, __m256i input) {
+  if (_mm256_movemask_epi8(input) == 0) {
+    state.error = _mm256_or_si256(state.error, state.prev_incomplete);
+  } else {
+    // alignr works within each 128-bit lane, so first build a vector of the
+    // 16 bytes before each lane.
+    __m256i before = _mm256_permute2x128_si256(state.prev_input, input, 0x21);
+    __m256i prev1 = _mm256_alignr_epi8(input, before, 15);
+    __m256i prev2 = _mm256_alignr_epi8(input, before, 14);
+    __m256i prev3 = _mm256_alignr_epi8(input, before, 13);
+    __m256i special = _mm256_and_si256(
+        _mm256_and_si256(
+            _mm256_shuffle_epi8(LoadTableAvx2(kByte1High),
+                                HighNibbleAvx2(prev1)),
+            _mm256_shuffle_epi8(LoadTableAvx2(kByte1Low),
+                                _mm256_and_si256(prev1,
+                                                 _mm256_set1_epi8(0x0f)))),
+        _mm256_shuffle_epi8(LoadTableAvx2(kByte2High), HighNibbleAvx2(input)));
+    __m256i is_third = _mm256_subs_epu8(prev2, _mm256_set1_epi8(0xe0 - 0x80));
+    __m256i is_fourth = _mm256_subs_epu8(prev3, _mm256_set1_epi8(0xf0 - 0x80));
+    __m256i must_be_cont = _mm256_and_si256(
+        _mm256_or_si256(is_third, is_fourth), _mm256_set1_epi8(char(0x80)));
+    state.error = _mm256_or_si256(state.error,
+                                  _mm256_xor_si256(must_be_cont, special));
+    state.prev_incomplete =
+        _mm256_subs_epu8(input, LoadAvx2(kIncompleteMax));
+  }
+  state.prev_input = input;
+}
+
+WASP_TARGET_AVX2
+bool IsValidUtf8Avx2(string_view s) {
+  auto* p = reinterpret_cast<const u8*>(s.data());
+  size_t size = s.size();
+  Avx2State state{_mm256_setzero_si256(), _mm256_setzero_si256(),
+                  _mm256_setzero_si256()};
+  size_t i = 0;
+  for (; i + 32 <= size; i += 32) {
+    ValidateBlockAvx2(state, LoadAvx2(p + i));
+  }
+  u8 tail[32] = {};
+  std::memcpy(tail, p + i, size - i);
+  ValidateBlockAvx2(state, LoadAvx2(tail));
+  __m256i error = _mm256_or_si256(state.error, state.prev_incomplete);
+  return _mm256_testz_si256(error, error);
+}
+
+#undef WASP_TARGET_SSE41
+#undef WASP_TARGET_AVX2
+
+#endif  // WASP_UTF8_X86
+
+using ValidateFunction = bool (*)(string_view);
+
+ValidateFunction GetValidateFunction(Utf8Validator validator) {
+  switch (validator) {
+#if WASP_UTF8_X86
+    case Utf8Validator::Sse41:
+      return IsValidUtf8Sse41;
+
+    case Utf8Validator::Avx2:
+      return IsValidUtf8Avx2;
+#endif
+
+    default:
+      return IsValidUtf8Portable;
+  }
+}
+
+ValidateFunction ChooseValidateFunction() {
+  for (auto validator : {Utf8Validator::Avx2, Utf8Validator::Sse41}) {
+    if (IsSupported(validator)) {
+      return GetValidateFunction(validator);
+    }
+  }
+  return IsValidUtf8Portable;
+}
+
+}  // namespace
+
+bool IsSupported(Utf8Validator validator) {
+  switch (validator) {
+    case Utf8Validator::Portable:
+      return true;
+
+#if WASP_UTF8_X86
+    case Utf8Validator::Sse41:
+      return __builtin_cpu_supports("sse4.1");
+
+    case Utf8Validator::Avx2:
+      return __builtin_cpu_supports("avx2");
+#endif
+
+    default:
+      return false;
+  }
+}
+
+bool IsValidUtf8(string_view s, Utf8Validator validator) {
+  assert(IsSupported(validator));
+  return GetValidateFunction(validator)(s);
+}
+
+void Utf8Checker::Append(string_view s) {
+  if (state_ != kReject) {
+    auto* p = reinterpret_cast<const u8*>(s.data());
+    state_ = RunDfa(state_, p, p + s.size());
+  }
+}
+
+void Utf8Checker::Append(u8 c) {
+  if (state_ != kReject) {
+    state_ = kUtf8Dfa[256 + state_ * 16 + kUtf8Dfa[c]];
+  }
+}
+
+bool Utf8Checker::IsValid() const {
+  return state_ == kAccept;
+}
+
 bool IsValidUtf8(string_view s) {
-  static const u8 utf8d[] = {
-    0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0, // 00..1f
-    0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0, // 20..3f
-    0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0, // 40..5f
-    0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0,0, // 60..7f
-    1,1,1,1,1,1,1,1,1,1,1,1,1,1,1,1,9,9,9,9,9,9,9,9,9,9,9,9,9,9,9,9, // 80..9f
-    7,7,7,7,7,7,7,7,7,7,7,7,7,7,7,7,7,7,7,7,7,7,7,7,7,7,7,7,7,7,7,7, // a0..bf
-    8,8,2,2,2,2,2,2,2,2,2,2,2,2,2,2,2,2,2,2,2,2,2,2,2,2,2,2,2,2,2,2, // c0..df
-    0xa,0x3,0x3,0x3,0x3,0x3,0x3,0x3,0x3,0x3,0x3,0x3,0x3,0x4,0x3,0x3, // e0..ef
-    0xb,0x6,0x6,0x6,0x5,0x8,0x8,0x8,0x8,0x8,0x8,0x8,0x8,0x8,0x8,0x8, // f0..ff
-    0x0,0x1,0x2,0x3,0x5,0x8,0x7,0x1,0x1,0x1,0x4,0x6,0x1,0x1,0x1,0x1, // s0..s0
-    1,1,1,1,1,1,1,1,1,1,1,1,1,1,1,1,1,0,1,1,1,1,1,0,1,0,1,1,1,1,1,1, // s1..s2
-    1,2,1,1,1,1,1,2,1,2,1,1,1,1,1,1,1,1,1,1,1,1,1,2,1,1,1,1,1,1,1,1, // s3..s4
-    1,2,1,1,1,1,1,1,1,2,1,1,1,1,1,1,1,1,1,1,1,1,1,3,1,3,1,1,1,1,1,1, // s5..s6
-    1,3,1,1,1,1,1,3,1,3,1,1,1,1,1,1,1,3,1,1,1,1,1,1,1,1,1,1,1,1,1,1, // s7..s8
-  };
-
-  u32 state = 0;
-  static const u32 accept = 0;
-
-  for (u8 c : s) {
-    u32 type = utf8d[c];
-    state = utf8d[256 + state * 16 + type];
+  // Most names are short, and the SIMD validators always process at least one
+  // whole block, so they're only worth using for longer strings.
+  if (s.size() < 16) {
+    return IsValidUtf8Portable(s);
   }
-  return state == accept;
+  static const ValidateFunction validate = ChooseValidateFunction();
+  return validate(s);
 }
 
 }  // namespace wasp
@@ -0,0 +1,362 @@
+//
+// Copyright 2020 WebAssembly Community Group participants
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//     http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+//
+
+#include "wasp/binary/module_index.h"
+
+#include <cstring>
+
+#include "wasp/base/errors_nop.h"
+#include "wasp/binary/name_section/sections.h"
+#include "wasp/binary/read.h"
+#include "wasp/binary/read/read_ctx.h"
+#include "wasp/binary/sections.h"
+
+namespace wasp::binary {
+
+namespace {
+
+constexpr u32 kIndexMagic = 0x78646977;  // "widx"
+constexpr u32 kIndexVersion = 1;
+
+template <typename T>
+void Append(Buffer& buffer, T value) {
+  auto size = buffer.size();
+  buffer.resize(size + sizeof(T));
+  memcpy(buffer.data() + size, &value, sizeof(T));
+}
+
+void AppendSpan(Buffer& buffer, SpanU8 module_data, SpanU8 span) {
+  Append<u32>(buffer, static_cast<u32>(span.data() - module_data.data()));
+  Append<u32>(buffer, static_cast<u32>(span.size()));
+}
+
+// Reads the values written by Append. Every read is bounds-checked, and any
+// failure is sticky, so the caller only needs to check ok() at the end.
+class IndexReader {
+ public:
+  explicit IndexReader(SpanU8 data) : data_{data} {}
+
+  bool ok() const { return ok_; }
+
+  template <typename T>
+  T Read() {
+    T value{};
+    if (data_.size() < sizeof(T)) {
+      ok_ = false;
+      return value;
+    }
+    memcpy(&value, data_.data(), sizeof(T));
+    data_.remove_prefix(sizeof(T));
+    return value;
+  }
+
+  // Reads a count of items, each `item_size` bytes, rejecting counts larger
+  // than the remaining data before anything is allocated for them.
+  u32 ReadCount(size_t item_size) {
+    auto count = Read<u32>();
+    if (count > data_.size() / item_size) {
+      ok_ = false;
+      return 0;
+    }
+    return count;
+  }
+
+  SpanU8 ReadSpan(SpanU8 module_data) {
+    auto offset = Read<u32>();
+    auto size = Read<u32>();
+    if (offset > module_data.size() || size > module_data.size() - offset) {
+      ok_ = false;
+      return {};
+    }
+    return module_data.subspan(offset, size);
+  }
+
+ private:
+  SpanU8 data_;
+  bool ok_ = true;
+};
+
+void AddFunctionName(ModuleIndex& index, Index func_index, string_view name) {
+  index.function_names.push_back(IndexNamePair{func_index, name});
+  index.name_to_function.emplace(name, func_index);
+}
+
+void IndexImports(ModuleIndex& index, KnownSection known, ReadCtx& ctx) {
+  for (auto import : ReadImportSection(known, ctx).sequence) {
+    switch (import->kind()) {
+      case ExternalKind::Function:
+        AddFunctionName(index, index.imported_function_count++, import->name);
+        break;
+
+      case ExternalKind::Table:
+        index.imported_table_count++;
+        break;
+
+      case ExternalKind::Memory:
+        index.imported_memory_count++;
+        break;
+
+      case ExternalKind::Global:
+        index.imported_global_count++;
+        break;
+
+      case ExternalKind::Tag:
+        index.imported_tag_count++;
+        break;
+    }
+  }
+}
+
+}  // namespace
+
+Index ModuleIndex::GetImportCount(ExternalKind kind) const {
+  switch (kind) {
+    case ExternalKind::Function: return imported_function_count;
+    case ExternalKind::Table:    return imported_table_count;
+    case ExternalKind::Memory:   return imported_memory_count;
+    case ExternalKind::Global:   return imported_global_count;
+    case ExternalKind::Tag:      return imported_tag_count;
+  }
+  return 0;
+}
+
+Index ModuleIndex::GetFunctionCount() const {
+  return imported_function_count + defined_function_count;
+}
+
+optional<Index> ModuleIndex::FindFunction(string_view name) const {
+  auto iter = name_to_function.find(name);
+  if (iter == name_to_function.end()) {
+    return nullopt;
+  }
+  return iter->second;
+}
+
+optional<At<Section>> ModuleIndex::FindSection(SectionId id) const {
+  for (const auto& section : sections) {
+    if (section->is_known() && section->known()->id == id) {
+      return section;
+    }
+  }
+  return nullopt;
+}
+
+auto ModuleIndex::GetCode(Index function_index, ReadCtx& ctx) const
+    -> OptAt<Code> {
+  if (function_index < imported_function_count ||
+      function_index - imported_function_count >= codes.size()) {
+    return nullopt;
+  }
+  SpanU8 data = codes[function_index - imported_function_count];
+  // Reading a single entry out of order shouldn't count towards the number of
+  // code entries seen in the module.
+  Index code_count = ctx.code_count;
+  auto code = Read<Code>(&data, ctx);
+  ctx.code_count = code_count;
+  return code;
+}
+
+void IndexCodeSection(ModuleIndex& index, KnownSection known, ReadCtx& ctx) {
+  // Only the size of each entry is read, so the locals and instructions are
+  // not decoded here.
+  SpanU8 data = known.data;
+  auto count = ReadCount(&data, ctx);
+  if (!count) {
+    return;
+  }
+  index.codes.reserve(index.codes.size() + *count);
+  for (Index i = 0; i < *count; ++i) {
+    const u8* begin = data.begin();
+    auto size = ReadLength(&data, ctx);
+    if (!size || !ReadBytes(&data, *size, ctx)) {
+      return;
+    }
+    index.codes.push_back(MakeSpan(begin, data.begin()));
+  }
+}
+
+auto IndexModule(LazyModule& module) -> ModuleIndex {
+  // Any errors will be reported when the module is read normally.
+  ErrorsNop errors;
+  LazyModule copy{module.data, module.ctx.features, errors};
+  auto& ctx = copy.ctx;
+
+  ModuleIndex index;
+  for (auto section : copy.sections) {
+    index.sections.push_back(section);
+    if (section->is_known()) {
+      auto known = section->known();
+      switch (known->id) {
+        case SectionId::Import:
+          IndexImports(index, known, ctx);
+          break;
+
+        case SectionId::Function:
+          index.defined_function_count +=
+              ReadFunctionSection(known, ctx).count.value_or(0);
+          break;
+
+        case SectionId::Export:
+          for (auto export_ : ReadExportSection(known, ctx).sequence) {
+            if (export_->kind == ExternalKind::Function) {
+              AddFunctionName(index, export_->index, export_->name);
+            }
+          }
+          break;
+
+        case SectionId::Code:
+          IndexCodeSection(index, known, ctx);
+          break;
+
+        default:
+          break;
+      }
+    } else if (section->is_custom()) {
+      auto custom = section->custom();
+      if (*custom->name == "name") {
+        for (auto subsection : ReadNameSection(custom, ctx)) {
+          if (subsection->id == NameSubsectionId::FunctionNames) {
+            for (auto name_assoc :
+                 ReadFunctionNamesSubsection(*subsection, ctx).sequence) {
+              AddFunctionName(index, name_assoc->index, name_assoc->name);
+            }
+          }
+        }
+      }
+    }
+  }
+  return index;
+}
+
+u64 HashModuleContents(SpanU8 data) {
+  // The hash must be stable across runs, so absl::Hash can't be used. This is
+  // a multiply-xor hash over four independent lanes of 8-byte words, so the
+  // multiplies of neighbouring words can overlap.
+  constexpr u64 kMul = 0x9e3779b97f4a7c15;
+  u64 lanes[4] = {data.size(), 1, 2, 3};
+  const u8* ptr = data.data();
+  const u8* end = ptr + data.size();
+  for (; end - ptr >= 32; ptr += 32) {
+    for (int i = 0; i < 4; ++i) {
+      u64 word;
+      memcpy(&word, ptr + i * 8, 8);
+      lanes[i] = (lanes[i] ^ word) * kMul;
+      lanes[i] ^= lanes[i] >> 32;
+    }
+  }
+  for (; ptr < end; ++ptr) {
+    lanes[0] = (lanes[0] ^ *ptr) * kMul;
+  }
+  u64 hash = 0;
+  for (auto lane : lanes) {
+    hash = (hash ^ lane) * kMul;
+    hash ^= hash >> 32;
+  }
+  return hash;
+}
+
+void WriteModuleIndex(const ModuleIndex& index,
+                      SpanU8 module_data,
+                      Buffer& out) {
+  Append<u32>(out, kIndexMagic);
+  Append<u32>(out, kIndexVersion);
+  Append<u64>(out, module_data.size());
+  Append<u64>(out, HashModuleContents(module_data));
+  Append<u32>(out, index.imported_function_count);
+  Append<u32>(out, index.imported_table_count);
+  Append<u32>(out, index.imported_memory_count);
+  Append<u32>(out, index.imported_global_count);
+  Append<u32>(out, index.imported_tag_count);
+  Append<u32>(out, index.defined_function_count);
+
+  // Only the offset of each section is stored; the headers are cheap to
+  // reread, and that gives back the sections' names and locations.
+  Append<u32>(out, static_cast<u32>(index.sections.size()));
+  for (const auto& section : index.sections) {
+    Append<u32>(out,
+                static_cast<u32>(section.loc().data() - module_data.data()));
+  }
+
+  Append<u32>(out, static_cast<u32>(index.codes.size()));
+  for (auto code : index.codes) {
+    AppendSpan(out, module_data, code);
+  }
+
+  Append<u32>(out, static_cast<u32>(index.function_names.size()));
+  for (const auto& pair : index.function_names) {
+    Append<u32>(out, pair.first);
+    AppendSpan(out, module_data,
+               SpanU8{reinterpret_cast<const u8*>(pair.second.data()),
+                      pair.second.size()});
+  }
+}
+
+auto ReadModuleIndex(SpanU8 index_data, LazyModule& module)
+    -> optional<ModuleIndex> {
+  SpanU8 data = module.data;
+  IndexReader reader{index_data};
+  if (reader.Read<u32>() != kIndexMagic ||
+      reader.Read<u32>() != kIndexVersion ||
+      reader.Read<u64>() != data.size() ||
+      reader.Read<u64>() != HashModuleContents(data)) {
+    return nullopt;
+  }
+
+  ModuleIndex index;
+  index.imported_function_count = reader.Read<u32>();
+  index.imported_table_count = reader.Read<u32>();
+  index.imported_memory_count = reader.Read<u32>();
+  index.imported_global_count = reader.Read<u32>();
+  index.imported_tag_count = reader.Read<u32>();
+  index.defined_function_count = reader.Read<u32>();
+
+  ErrorsNop errors;
+  ReadCtx ctx{module.ctx.features, errors};
+  auto section_count = reader.ReadCount(sizeof(u32));
+  index.sections.reserve(section_count);
+  for (u32 i = 0; i < section_count; ++i) {
+    auto offset = reader.Read<u32>();
+    if (offset > data.size()) {
+      return nullopt;
+    }
+    SpanU8 section_data = data.subspan(offset);
+    auto section = Read<Section>(&section_data, ctx);
+    if (!section) {
+      return nullopt;
+    }
+    index.sections.push_back(*section);
+  }
+
+  auto code_count = reader.ReadCount(2 * sizeof(u32));
+  index.codes.reserve(code_count);
+  for (u32 i = 0; i < code_count; ++i) {
+    index.codes.push_back(reader.ReadSpan(data));
+  }
+
+  auto name_count = reader.ReadCount(3 * sizeof(u32));
+  index.function_names.reserve(name_count);
+  for (u32 i = 0; i < name_count; ++i) {
+    auto func_index = reader.Read<u32>();
+    AddFunctionName(index, func_index, ToStringView(reader.ReadSpan(data)));
+  }
+
+  if (!reader.ok()) {
+    return nullopt;
+  }
+  return index;
+}
+
+}  // namespace wasp::binary
@@ -0,0 +1,504 @@
+//
+// Copyright 2020 WebAssembly Community Group participants
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//     http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+//
+
+#include "wasp/binary/packed_expression.h"
+
+#include <array>
+#include <cstring>
+#include <vector>
+
+#include "wasp/base/concat.h"
+#include "wasp/base/errors_context_guard.h"
+#include "wasp/base/formatters.h"
+#include "wasp/base/macros.h"
+#include "wasp/binary/read.h"
+#include "wasp/binary/read/location_guard.h"
+#include "wasp/binary/read/macros.h"
+#include "wasp/binary/read/read_ctx.h"
+
+namespace wasp::binary {
+
+namespace {
+
+constexpr size_t kOpcodeCount = 0
+#define WASP_V(prefix, val, Name, str, ...) +1
+#define WASP_FEATURE_V(...) WASP_V(__VA_ARGS__)
+#define WASP_PREFIX_V(...) WASP_V(__VA_ARGS__)
+#include "wasp/base/inc/opcode.inc"
+#undef WASP_V
+#undef WASP_FEATURE_V
+#undef WASP_PREFIX_V
+    ;
+
+static_assert(kOpcodeCount <= 0x10000, "Opcode doesn't fit in u16");
+
+PackedInstruction MakePacked(Opcode opcode,
+                             InstructionKind kind,
+                             u32 imm0 = 0,
+                             u32 imm1 = 0,
+                             u32 imm2 = 0) {
+  return PackedInstruction{static_cast<u16>(opcode), kind, 0,
+                           {imm0, imm1, imm2}};
+}
+
+PackedInstruction MakePacked64(Opcode opcode, InstructionKind kind, u64 bits) {
+  return MakePacked(opcode, kind, static_cast<u32>(bits),
+                    static_cast<u32>(bits >> 32));
+}
+
+// Appends `value` to a side table, returning its index.
+template <typename T>
+u32 Push(std::vector<T>& table, const T& value) {
+  table.push_back(value);
+  return static_cast<u32>(table.size() - 1);
+}
+
+u32 PushHeapTypes(PackedExpression* out, const HeapType2Immediate& immediate) {
+  u32 index = static_cast<u32>(out->heap_types.size());
+  out->heap_types.push_back(immediate.parent);
+  out->heap_types.push_back(immediate.child);
+  return index;
+}
+
+PackedInstruction Pack(const Instruction& instr, PackedExpression* out) {
+  const Opcode opcode = instr.opcode;
+  const InstructionKind kind = instr.kind();
+  switch (kind) {
+    case InstructionKind::None:
+      return MakePacked(opcode, kind);
+
+    case InstructionKind::S32:
+      return MakePacked(opcode, kind,
+                        static_cast<u32>(instr.s32_immediate().value()));
+
+    case InstructionKind::S64:
+      return MakePacked64(opcode, kind,
+                          static_cast<u64>(instr.s64_immediate().value()));
+
+    case InstructionKind::F32: {
+      u32 bits;
+      f32 value = instr.f32_immediate();
+      memcpy(&bits, &value, sizeof(bits));
+      return MakePacked(opcode, kind, bits);
+    }
+
+    case InstructionKind::F64: {
+      u64 bits;
+      f64 value = instr.f64_immediate();
+      memcpy(&bits, &value, sizeof(bits));
+      return MakePacked64(opcode, kind, bits);
+    }
+
+    case InstructionKind::V128:
+      return MakePacked(opcode, kind,
+                        Push(out->v128s, *instr.v128_immediate()));
+
+    case InstructionKind::Index:
+      return MakePacked(opcode, kind, instr.index_immediate());
+
+    case InstructionKind::BlockType:
+      return MakePacked(opcode, kind,
+                        Push(out->block_types, *instr.block_type_immediate()));
+
+    case InstructionKind::BrTable: {
+      const auto& immediate = instr.br_table_immediate();
+      u32 index = static_cast<u32>(out->br_table_targets.size());
+      for (const auto& target : immediate->targets) {
+        out->br_table_targets.push_back(target);
+      }
+      out->br_table_targets.push_back(immediate->default_target);
+      return MakePacked(opcode, kind, index,
+                        static_cast<u32>(immediate->targets.size()));
+    }
+
+    case InstructionKind::CallIndirect: {
+      const auto& immediate = instr.call_indirect_immediate();
+      return MakePacked(opcode, kind, immediate->index, immediate->table_index);
+    }
+
+    case InstructionKind::Copy: {
+      const auto& immediate = instr.copy_immediate();
+      return MakePacked(opcode, kind, immediate->dst_index,
+                        immediate->src_index);
+    }
+
+    case InstructionKind::Init: {
+      const auto& immediate = instr.init_immediate();
+      return MakePacked(opcode, kind, immediate->segment_index,
+                        immediate->dst_index);
+    }
+
+    case InstructionKind::Let: {
+      const auto& immediate = instr.let_immediate();
+      u32 block_type_index = static_cast<u32>(out->block_types.size());
+      u32 locals_index = static_cast<u32>(out->locals.size());
+      out->block_types.push_back(immediate->block_type);
+      for (const auto& locals : immediate->locals) {
+        out->locals.push_back(locals);
+      }
+      return MakePacked(opcode, kind, block_type_index, locals_index,
+                        static_cast<u32>(immediate->locals.size()));
+    }
+
+    case InstructionKind::MemArg: {
+      const auto& immediate = instr.mem_arg_immediate();
+      auto packed = MakePacked(opcode, kind, immediate->align_log2,
+                               immediate->offset);
+      if (immediate->memory_index) {
+        packed.flags |= PackedInstruction::kHasMemoryIndex;
+        packed.immediate[2] = *immediate->memory_index;
+      }
+      return packed;
+    }
+
+    case InstructionKind::MemOpt:
+      return MakePacked(opcode, kind, instr.mem_opt_immediate()->memory_index);
+
+    case InstructionKind::HeapType:
+      return MakePacked(opcode, kind,
+                        Push(out->heap_types, *instr.heap_type_immediate()));
+
+    case InstructionKind::Select: {
+      const auto& immediate = instr.select_immediate();
+      u32 index = static_cast<u32>(out->value_types.size());
+      for (const auto& type : *immediate) {
+        out->value_types.push_back(type);
+      }
+      return MakePacked(opcode, kind, index,
+                        static_cast<u32>(immediate->size()));
+    }
+
+    case InstructionKind::Shuffle:
+      return MakePacked(opcode, kind,
+                        Push(out->shuffles, *instr.shuffle_immediate()));
+
+    case InstructionKind::SimdLane:
+      return MakePacked(opcode, kind, instr.simd_lane_immediate());
+
+    case InstructionKind::SimdMemoryLane:
+      return MakePacked(opcode, kind,
+                        Push(out->simd_memory_lanes,
+                             *instr.simd_memory_lane_immediate()));
+
+    case InstructionKind::FuncBind:
+      return MakePacked(opcode, kind, instr.func_bind_immediate()->index);
+
+    case InstructionKind::BrOnCast: {
+      const auto& immediate = instr.br_on_cast_immediate();
+      return MakePacked(opcode, kind, immediate->target,
+                        PushHeapTypes(out, immediate->types));
+    }
+
+    case InstructionKind::HeapType2:
+      return MakePacked(opcode, kind,
+                        PushHeapTypes(out, instr.heap_type_2_immediate()));
+
+    case InstructionKind::RttSub: {
+      const auto& immediate = instr.rtt_sub_immediate();
+      return MakePacked(opcode, kind, immediate->depth,
+                        PushHeapTypes(out, immediate->types));
+    }
+
+    case InstructionKind::StructField: {
+      const auto& immediate = instr.struct_field_immediate();
+      return MakePacked(opcode, kind, immediate->struct_, immediate->field);
+    }
+  }
+  WASP_UNREACHABLE();
+}
+
+// The immediates of br_table, select and let are vectors, so
+// Read<Instruction> would allocate for them. These readers decode straight
+// into the side tables instead, and mirror the error contexts of the
+// Read<BrTableImmediate>, ReadVector<ValueType> and Read<LetImmediate> calls
+// they replace.
+
+optional<PackedInstruction> ReadPackedBrTable(SpanU8* data,
+                                              ReadCtx& ctx,
+                                              Opcode opcode,
+                                              PackedExpression* out) {
+  ErrorsContextGuard error_guard{ctx.errors, *data, "br_table"};
+  const u32 index = static_cast<u32>(out->br_table_targets.size());
+  ErrorsContextGuard targets_guard{ctx.errors, *data, "targets"};
+  WASP_TRY_READ(count, ReadCount(data, ctx));
+  for (u32 i = 0; i < count; ++i) {
+    WASP_TRY_READ(target, Read<Index>(data, ctx));
+    out->br_table_targets.push_back(target);
+  }
+  targets_guard.PopContext();
+  WASP_TRY_READ(default_target, ReadIndex(data, ctx, "default target"));
+  out->br_table_targets.push_back(default_target);
+  return MakePacked(opcode, InstructionKind::BrTable, index, count);
+}
+
+optional<PackedInstruction> ReadPackedSelect(SpanU8* data,
+                                             ReadCtx& ctx,
+                                             Opcode opcode,
+                                             PackedExpression* out) {
+  ErrorsContextGuard error_guard{ctx.errors, *data, "types"};
+  const u32 index = static_cast<u32>(out->value_types.size());
+  WASP_TRY_READ(count, ReadCount(data, ctx));
+  for (u32 i = 0; i < count; ++i) {
+    WASP_TRY_READ(type, Read<ValueType>(data, ctx));
+    out->value_types.push_back(type);
+  }
+  return MakePacked(opcode, InstructionKind::Select, index, count);
+}
+
+optional<PackedInstruction> ReadPackedLet(SpanU8* data,
+                                          ReadCtx& ctx,
+                                          At<Opcode> opcode,
+                                          PackedExpression* out) {
+  const u32 block_type_index = static_cast<u32>(out->block_types.size());
+  const u32 locals_index = static_cast<u32>(out->locals.size());
+  WASP_TRY_READ_CONTEXT(block_type, Read<BlockType>(data, ctx), "block_type");
+  out->block_types.push_back(block_type);
+  ErrorsContextGuard locals_guard{ctx.errors, *data, "locals vector"};
+  WASP_TRY_READ(count, ReadCount(data, ctx));
+  for (u32 i = 0; i < count; ++i) {
+    WASP_TRY_READ(locals, Read<Locals>(data, ctx));
+    out->locals.push_back(locals);
+  }
+  locals_guard.PopContext();
+  ctx.open_blocks.push_back(opcode);
+  return MakePacked(opcode, InstructionKind::Let, block_type_index,
+                    locals_index, count);
+}
+
+// Single-byte MVP opcodes whose immediates can be decoded without building a
+// binary::Instruction first. Errors are still reported through the same Read
+// functions that Read<Instruction> uses.
+struct FastOpcode {
+  bool is_fast = false;
+  Opcode opcode = Opcode::Unreachable;
+  InstructionKind kind = InstructionKind::None;
+};
+
+InstructionKind GetFastKind(u8 byte) {
+  if (byte == 0x0c || byte == 0x0d || byte == 0x10 ||
+      (byte >= 0x20 && byte <= 0x24)) {
+    return InstructionKind::Index;
+  } else if (byte >= 0x28 && byte <= 0x3e) {
+    return InstructionKind::MemArg;
+  } else if (byte == 0x3f || byte == 0x40) {
+    return InstructionKind::MemOpt;
+  } else if (byte == 0x41) {
+    return InstructionKind::S32;
+  } else if (byte == 0x42) {
+    return InstructionKind::S64;
+  } else if (byte == 0x43) {
+    return InstructionKind::F32;
+  } else if (byte == 0x44) {
+    return InstructionKind::F64;
+  } else {
+    return InstructionKind::None;
+  }
+}
+
+bool IsFastByte(u8 byte) {
+  return byte == 0x00 || byte == 0x01 || byte == 0x0c || byte == 0x0d ||
+         byte == 0x0f || byte == 0x10 || byte == 0x1a || byte == 0x1b ||
+         (byte >= 0x20 && byte <= 0x24) || (byte >= 0x28 && byte <= 0xbf);
+}
+
+const std::array<FastOpcode, 256>& GetFastOpcodes() {
+  static const std::array<FastOpcode, 256> table = []() {
+    std::array<FastOpcode, 256> result;
+    auto add = [&](u32 prefix, u32 code, Opcode opcode) {
+      if (prefix == 0 && code < 256 && IsFastByte(code)) {
+        result[code] = FastOpcode{true, opcode, GetFastKind(code)};
+      }
+    };
+    // Opcodes that depend on a feature are left to Read<Instruction>.
+#define WASP_V(prefix, val, Name, str) add(prefix, val, Opcode::Name);
+#define WASP_FEATURE_V(...)
+#define WASP_PREFIX_V(...)
+#include "wasp/base/inc/opcode.inc"
+#undef WASP_V
+#undef WASP_FEATURE_V
+#undef WASP_PREFIX_V
+    return result;
+  }();
+  return table;
+}
+
+optional<PackedInstruction> ReadFastInstruction(SpanU8* data,
+                                                ReadCtx& ctx,
+                                                const FastOpcode& fast) {
+  data->remove_prefix(1);
+  const Opcode opcode = fast.opcode;
+  const InstructionKind kind = fast.kind;
+  switch (kind) {
+    case InstructionKind::None:
+      return MakePacked(opcode, kind);
+
+    case InstructionKind::Index: {
+      WASP_TRY_READ(index, ReadIndex(data, ctx, "index"));
+      return MakePacked(opcode, kind, index);
+    }
+
+    case InstructionKind::S32: {
+      WASP_TRY_READ_CONTEXT(value, Read<s32>(data, ctx), "i32 constant");
+      return MakePacked(opcode, kind, static_cast<u32>(*value));
+    }
+
+    case InstructionKind::S64: {
+      WASP_TRY_READ_CONTEXT(value, Read<s64>(data, ctx), "i64 constant");
+      return MakePacked64(opcode, kind, static_cast<u64>(*value));
+    }
+
+    case InstructionKind::F32: {
+      WASP_TRY_READ_CONTEXT(value, Read<f32>(data, ctx), "f32 constant");
+      u32 bits;
+      memcpy(&bits, &*value, sizeof(bits));
+      return MakePacked(opcode, kind, bits);
+    }
+
+    case InstructionKind::F64: {
+      WASP_TRY_READ_CONTEXT(value, Read<f64>(data, ctx), "f64 constant");
+      u64 bits;
+      memcpy(&bits, &*value, sizeof(bits));
+      return MakePacked64(opcode, kind, bits);
+    }
+
+    case InstructionKind::MemArg: {
+      WASP_TRY_READ(immediate, Read<MemArgImmediate>(data, ctx));
+      auto packed = MakePacked(opcode, kind, immediate->align_log2,
+                               immediate->offset);
+      if (immediate->memory_index) {
+        packed.flags |= PackedInstruction::kHasMemoryIndex;
+        packed.immediate[2] = *immediate->memory_index;
+      }
+      return packed;
+    }
+
+    case InstructionKind::MemOpt: {
+      WASP_TRY_READ(immediate, Read<MemOptImmediate>(data, ctx));
+      return MakePacked(opcode, kind, immediate->memory_index);
+    }
+
+    default:
+      WASP_UNREACHABLE();
+  }
+}
+
+bool HasVectorImmediate(u8 byte) {
+  return byte == 0x0e ||  // br_table
+         byte == 0x17 ||  // let
+         byte == 0x1c;    // select t*
+}
+
+optional<PackedInstruction> ReadPackedInstruction(SpanU8* data,
+                                                  ReadCtx& ctx,
+                                                  PackedExpression* out) {
+  if (!data->empty() && !ctx.seen_final_end) {
+    const FastOpcode& fast = GetFastOpcodes()[(*data)[0]];
+    if (fast.is_fast) {
+      return ReadFastInstruction(data, ctx, fast);
+    }
+  }
+
+  if (data->empty() || !HasVectorImmediate((*data)[0])) {
+    WASP_TRY_READ(instr, Read<Instruction>(data, ctx));
+    return Pack(instr, out);
+  }
+
+  // Same checks as the start of Read<Instruction>.
+  WASP_TRY_READ(opcode, Read<Opcode>(data, ctx));
+  if (ctx.seen_final_end) {
+    ctx.errors.OnError(opcode.loc(), concat("Unexpected ", *opcode,
+                                            " instruction after 'end'"));
+    return nullopt;
+  }
+
+  switch (opcode) {
+    case Opcode::BrTable:
+      return ReadPackedBrTable(data, ctx, opcode, out);
+    case Opcode::SelectT:
+      return ReadPackedSelect(data, ctx, opcode, out);
+    case Opcode::Let:
+      return ReadPackedLet(data, ctx, opcode, out);
+    default:
+      WASP_UNREACHABLE();
+  }
+}
+
+}  // namespace
+
+f32 PackedInstruction::f32_immediate() const {
+  f32 value;
+  memcpy(&value, &immediate[0], sizeof(value));
+  return value;
+}
+
+f64 PackedInstruction::f64_immediate() const {
+  u64 bits = u64_immediate();
+  f64 value;
+  memcpy(&value, &bits, sizeof(value));
+  return value;
+}
+
+void PackedExpression::Clear() {
+  instructions.clear();
+  offsets.clear();
+  br_table_targets.clear();
+  value_types.clear();
+  block_types.clear();
+  heap_types.clear();
+  locals.clear();
+  v128s.clear();
+  shuffles.clear();
+  simd_memory_lanes.clear();
+}
+
+bool ReadPackedExpression(SpanU8 data,
+                          ReadCtx& ctx,
+                          PackedExpression* out,
+                          RecordOffsets record_offsets) {
+  out->Clear();
+  return AppendPackedExpression(data, ctx, out, record_offsets);
+}
+
+bool ReadPackedExpression(Expression expr,
+                          ReadCtx& ctx,
+                          PackedExpression* out,
+                          RecordOffsets record_offsets) {
+  return ReadPackedExpression(expr.data, ctx, out, record_offsets);
+}
+
+bool AppendPackedExpression(SpanU8 data,
+                            ReadCtx& ctx,
+                            PackedExpression* out,
+                            RecordOffsets record_offsets) {
+  const u8* start = data.begin();
+  ctx.seen_final_end = false;
+  while (!data.empty()) {
+    if (record_offsets == RecordOffsets::Yes) {
+      out->offsets.push_back(static_cast<u32>(data.begin() - start));
+    }
+    auto packed = ReadPackedInstruction(&data, ctx, out);
+    if (!packed) {
+      if (record_offsets == RecordOffsets::Yes) {
+        out->offsets.pop_back();
+      }
+      return false;
+    }
+    out->instructions.push_back(*packed);
+  }
+  return true;
+}
+
+}  // namespace wasp::binary
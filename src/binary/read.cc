@@ -1539,13 +1539,7 @@ OptAt<Section> Read(SpanU8* data, ReadCtx& ctx, ReadTag<Section>) {
     return At{guard.range(data),
               Section{At{guard.range(data), CustomSection{name, *bytes}}}};
   } else {
-    if (ctx.last_section_id && *ctx.last_section_id >= id.value()) {
-      ctx.errors.OnError(
-          id.loc(), concat("Section out of order: ", id, " cannot occur after ",
-                           *ctx.last_section_id));
-    }
-    ctx.last_section_id = id;
-
+    CheckSectionOrder(id, ctx);
     return At{guard.range(data),
               Section{At{guard.range(data), KnownSection{id, *bytes}}}};
   }
@@ -1718,6 +1712,18 @@ OptAt<ValueType> Read(SpanU8* data, ReadCtx& ctx, ReadTag<ValueType>) {
   }
 }
 
+bool CheckSectionOrder(const At<SectionId>& id, ReadCtx& ctx) {
+  bool ok = true;
+  if (ctx.last_section_id && *ctx.last_section_id >= id.value()) {
+    ctx.errors.OnError(
+        id.loc(), concat("Section out of order: ", id, " cannot occur after ",
+                         *ctx.last_section_id));
+    ok = false;
+  }
+  ctx.last_section_id = id;
+  return ok;
+}
+
 bool EndCode(SpanU8 data, ReadCtx& ctx) {
   if (!ctx.open_blocks.empty()) {
     for (auto& [loc, op] : ctx.open_blocks) {
@@ -16,8 +16,15 @@
 
 #include "wasp/binary/read.h"
 
+#include <deque>
+#include <vector>
+
+#include "wasp/base/errors_buffer.h"
 #include "wasp/base/errors_context_guard.h"
+#include "wasp/base/parallel_for.h"
+#include "wasp/binary/lazy_expression.h"
 #include "wasp/binary/lazy_module.h"
+#include "wasp/binary/packed_module.h"
 #include "wasp/binary/read/location_guard.h"
 #include "wasp/binary/read/macros.h"
 #include "wasp/binary/visitor.h"
@@ -26,8 +33,11 @@ namespace wasp::binary {
 
 using visit::Result;
 
-struct EagerModuleVisitor : visit::Visitor {
-  explicit EagerModuleVisitor(Module& module) : module{module} {}
+// Collects everything but the code section. Shared by Module and
+// PackedModule, which only differ in how function bodies are stored.
+template <typename M>
+struct EagerModuleVisitorBase : visit::Visitor {
+  explicit EagerModuleVisitorBase(M& module) : module{module} {}
 
   auto OnType(const At<DefinedType>& type) -> Result {
     module.types.push_back(type);
@@ -84,8 +94,84 @@ struct EagerModuleVisitor : visit::Visitor {
     return Result::Ok;
   }
 
+  auto OnData(const At<DataSegment>& data_segment) -> Result {
+    module.data_segments.push_back(data_segment);
+    return Result::Ok;
+  }
+
+  M& module;
+};
+
+// Sends errors to the ErrorsBuffer of the function currently being read, if
+// there is one. Reading a code entry's locals happens in Visit, before
+// BeginCode is called, so this lets those errors be buffered along with the
+// errors from decoding the function's body later.
+class CodeErrors : public Errors {
+ public:
+  explicit CodeErrors(Errors& errors) : errors_{errors} {}
+
+  void set_buffer(ErrorsBuffer* buffer) { buffer_ = buffer; }
+
+  bool HasError() const override {
+    return has_buffered_error_ || errors_.HasError();
+  }
+
+ protected:
+  void HandlePushContext(Location loc, string_view desc) override {
+    Errors* errors = current();
+    errors->PushContext(loc, desc);
+    pushed_.push_back(errors);
+  }
+
+  void HandlePopContext() override {
+    pushed_.back()->PopContext();
+    pushed_.pop_back();
+  }
+
+  void HandleOnError(Location loc, string_view message) override {
+    has_buffered_error_ |= buffer_ != nullptr;
+    current()->OnError(loc, message);
+  }
+
+ private:
+  Errors* current() const {
+    return buffer_ ? static_cast<Errors*>(buffer_) : &errors_;
+  }
+
+  Errors& errors_;
+  ErrorsBuffer* buffer_ = nullptr;
+  bool has_buffered_error_ = false;
+  // The Errors object each context was pushed to, so it's popped from the
+  // same one.
+  std::vector<Errors*> pushed_;
+};
+
+struct EagerModuleVisitor : EagerModuleVisitorBase<Module> {
+  explicit EagerModuleVisitor(Module& module,
+                              ReadCtx& ctx,
+                              Index num_threads,
+                              CodeErrors* code_errors)
+      : EagerModuleVisitorBase{module},
+        ctx{ctx},
+        num_threads{num_threads},
+        code_errors{code_errors} {}
+
+  auto BeginCodeSection(LazyCodeSection) -> Result {
+    if (code_errors) {
+      // Buffer the errors from reading the first function's locals.
+      code_errors->set_buffer(&pending_errors.emplace_back());
+    }
+    return Result::Ok;
+  }
+
   auto BeginCode(const At<Code>& code) -> Result {
     module.codes.push_back(At{code.loc(), UnpackedCode{code->locals, {}}});
+    if (code_errors) {
+      // Decoded in EndCodeSection instead.
+      pending_bodies.push_back(code->body->data);
+      code_errors->set_buffer(&pending_errors.emplace_back());
+      return Result::Skip;
+    }
     return Result::Ok;
   }
 
@@ -94,23 +180,129 @@ struct EagerModuleVisitor : visit::Visitor {
     return Result::Ok;
   }
 
-  auto OnData(const At<DataSegment>& data_segment) -> Result {
-    module.data_segments.push_back(data_segment);
+  auto EndCodeSection(LazyCodeSection) -> Result {
+    if (code_errors) {
+      code_errors->set_buffer(nullptr);
+      ReadPendingBodies();
+      pending_bodies.clear();
+      pending_errors.clear();
+    }
     return Result::Ok;
   }
 
-  Module& module;
+  // The locals of each function are still read in order by Visit; only the
+  // instructions are decoded in parallel. Each function's errors, from its
+  // locals and then its body, are collected in its own ErrorsBuffer and
+  // reported in function order afterward, the same as a sequential read.
+  void ReadPendingBodies() {
+    Index count = static_cast<Index>(pending_bodies.size());
+    Index first_code = static_cast<Index>(module.codes.size()) - count;
+
+    ParallelFor(count, num_threads, [&](Index, Index index) {
+      SpanU8 body = pending_bodies[index];
+      ReadCtx body_ctx{ctx.features, pending_errors[index]};
+      body_ctx.declared_data_count = ctx.declared_data_count;
+      auto& instructions = module.codes[first_code + index]->body.instructions;
+      for (auto&& instruction : ReadExpression(body, body_ctx)) {
+        instructions.push_back(instruction);
+      }
+      binary::EndCode(body.last(0), body_ctx);
+    });
+
+    // The last buffer has any errors after the last function was read, e.g.
+    // a malformed code entry or a count mismatch.
+    for (const auto& function_errors : pending_errors) {
+      function_errors.ReplayTo(ctx.errors);
+    }
+  }
+
+  ReadCtx& ctx;
+  Index num_threads;
+  CodeErrors* code_errors;
+  std::vector<SpanU8> pending_bodies;
+  // A deque, so pointers to the buffers stay valid as more are added.
+  std::deque<ErrorsBuffer> pending_errors;
+};
+
+struct PackedModuleVisitor : EagerModuleVisitorBase<PackedModule> {
+  explicit PackedModuleVisitor(PackedModule& module,
+                               ReadCtx& ctx,
+                               RecordOffsets record_offsets)
+      : EagerModuleVisitorBase{module},
+        ctx{ctx},
+        record_offsets{record_offsets} {}
+
+  auto OnSection(At<Section> section) -> Result {
+    if (section->id() == SectionId::Code) {
+      // Most instructions are 1-3 bytes, so this avoids nearly all of the
+      // regrowth without reserving far too much.
+      module.code.instructions.reserve(section->data().size() / 3);
+    }
+    return Result::Ok;
+  }
+
+  auto BeginCodeSection(LazyCodeSection section) -> Result {
+    if (section.count) {
+      module.codes.reserve(module.codes.size() + *section.count);
+    }
+    return Result::Ok;
+  }
+
+  // Decodes the body directly into the shared tables, so the visitor doesn't
+  // need to build an Instruction for each one.
+  auto BeginCode(const At<Code>& code) -> Result {
+    PackedCode packed;
+    packed.body = code->body->data;
+    packed.first_locals = static_cast<Index>(module.locals.size());
+    packed.locals_count = static_cast<Index>(code->locals.size());
+    packed.first_instruction =
+        static_cast<Index>(module.code.instructions.size());
+    module.locals.insert(module.locals.end(), code->locals.begin(),
+                         code->locals.end());
+    // Like Visit, keep going after an error so the same errors are reported.
+    AppendPackedExpression(code->body->data, ctx, &module.code,
+                           record_offsets);
+    binary::EndCode(code->body->data.last(0), ctx);
+    packed.instruction_count = static_cast<Index>(
+        module.code.instructions.size() - packed.first_instruction);
+    module.codes.push_back(At{code.loc(), packed});
+    return Result::Skip;
+  }
+
+  ReadCtx& ctx;
+  RecordOffsets record_offsets;
 };
 
-auto ReadModule(SpanU8 data, ReadCtx& ctx) -> optional<Module> {
+auto ReadModule(SpanU8 data, ReadCtx& ctx, Index num_threads)
+    -> optional<Module> {
   ErrorsContextGuard error_guard{ctx.errors, data, "module"};
-  LazyModule lazy_module{data, ctx.features, ctx.errors};
+  CodeErrors code_errors{ctx.errors};
+  bool parallel = num_threads > 1;
+  LazyModule lazy_module{data, ctx.features,
+                         parallel ? code_errors : ctx.errors};
   if (!(lazy_module.magic.has_value() && lazy_module.version.has_value())) {
     return nullopt;
   }
 
   Module module;
-  EagerModuleVisitor visitor{module};
+  EagerModuleVisitor visitor{module, lazy_module.ctx, num_threads,
+                             parallel ? &code_errors : nullptr};
+  if (Visit(lazy_module, visitor) == Result::Fail || ctx.errors.HasError()) {
+    return nullopt;
+  }
+  return module;
+}
+
+auto ReadPackedModule(SpanU8 data, ReadCtx& ctx, RecordOffsets record_offsets)
+    -> optional<PackedModule> {
+  ErrorsContextGuard error_guard{ctx.errors, data, "module"};
+  LazyModule lazy_module{data, ctx.features, ctx.errors};
+  if (!(lazy_module.magic.has_value() && lazy_module.version.has_value())) {
+    return nullopt;
+  }
+
+  PackedModule module;
+  PackedModuleVisitor visitor{module, lazy_module.ctx, record_offsets};
   if (Visit(lazy_module, visitor) == Result::Fail || ctx.errors.HasError()) {
     return nullopt;
   }
@@ -0,0 +1,248 @@
+//
+// Copyright 2020 WebAssembly Community Group participants
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//     http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+//
+
+#include "wasp/binary/write.h"
+
+#include <algorithm>
+#include <cassert>
+#include <cstring>
+#include <limits>
+#include <vector>
+
+#include "wasp/base/parallel_for.h"
+
+namespace wasp::binary {
+
+namespace {
+
+constexpr size_t kPaddedSizeBytes = 5;
+
+// Writes u32 sizes as padded LEB128 placeholders, and patches them later.
+class SizeWriter {
+ public:
+  explicit SizeWriter(Buffer& buffer) : buffer_{buffer} {}
+
+  // Writes a placeholder for the size of everything written until the
+  // matching End(). Returns its index, to be passed to End().
+  size_t Begin();
+  void End(size_t index);
+
+  // Rewrites every size with its minimal encoding, moving the rest of the
+  // buffer down to fill the gaps.
+  void Compact();
+
+ private:
+  struct Size {
+    size_t offset;  // Of the placeholder.
+    size_t end;     // Of the sized contents.
+  };
+
+  static u32 ContentSize(const Size& size) {
+    return static_cast<u32>(size.end - size.offset - kPaddedSizeBytes);
+  }
+
+  static size_t EncodedSize(u32 value) {
+    size_t count = 1;
+    for (value >>= 7; value != 0; value >>= 7) {
+      ++count;
+    }
+    return count;
+  }
+
+  Buffer& buffer_;
+  std::vector<Size> sizes_;  // Ordered by offset.
+};
+
+size_t SizeWriter::Begin() {
+  sizes_.push_back(Size{buffer_.size(), 0});
+  buffer_.resize(buffer_.size() + kPaddedSizeBytes);
+  return sizes_.size() - 1;
+}
+
+void SizeWriter::End(size_t index) {
+  auto& size = sizes_[index];
+  size.end = buffer_.size();
+  assert(size.end - size.offset - kPaddedSizeBytes <
+         std::numeric_limits<u32>::max());
+
+  u32 value = ContentSize(size);
+  u8* out = &buffer_[size.offset];
+  for (size_t i = 0; i < kPaddedSizeBytes - 1; ++i) {
+    *out++ = static_cast<u8>((value & 0x7f) | 0x80);
+    value >>= 7;
+  }
+  *out = static_cast<u8>(value);
+}
+
+void SizeWriter::Compact() {
+  // Sizes may be nested (function bodies in the code section), so an outer
+  // size shrinks by the bytes saved by the sizes inside it. Those always come
+  // later in `sizes_`, so compute the new sizes back to front, keeping a
+  // running total of the bytes saved from each index to the end.
+  const size_t count = sizes_.size();
+  std::vector<u32> new_sizes(count);
+  std::vector<size_t> saved_from(count + 1);
+  for (size_t i = count; i-- > 0;) {
+    const auto& size = sizes_[i];
+    auto inner_end = std::lower_bound(
+        sizes_.begin() + i + 1, sizes_.end(), size.end,
+        [](const Size& size, size_t end) { return size.offset < end; });
+    size_t inner_saved =
+        saved_from[i + 1] - saved_from[inner_end - sizes_.begin()];
+    new_sizes[i] = static_cast<u32>(ContentSize(size) - inner_saved);
+    saved_from[i] = saved_from[i + 1] + kPaddedSizeBytes -
+                    EncodedSize(new_sizes[i]);
+  }
+
+  // Then move everything down, front to back.
+  u8* data = buffer_.data();
+  size_t read = 0;
+  size_t write = 0;
+  for (size_t i = 0; i < count; ++i) {
+    size_t offset = sizes_[i].offset;
+    std::memmove(data + write, data + read, offset - read);
+    write += offset - read;
+    auto end = WriteVarInt(new_sizes[i], data + write);
+    write = end - data;
+    read = offset + kPaddedSizeBytes;
+  }
+  std::memmove(data + write, data + read, buffer_.size() - read);
+  buffer_.resize(write + buffer_.size() - read);
+  sizes_.clear();
+}
+
+void WriteCode(const UnpackedCode& value, Buffer& buffer, SizeWriter& sizes) {
+  auto size = sizes.Begin();
+  auto out = std::back_inserter(buffer);
+  out = WriteVector(value.locals.begin(), value.locals.end(), out);
+  Write(value.body, out);
+  sizes.End(size);
+}
+
+template <typename T>
+void WriteItem(const T& value, Buffer& buffer, SizeWriter&) {
+  Write(value, std::back_inserter(buffer));
+}
+
+void WriteItem(const At<UnpackedCode>& value,
+               Buffer& buffer,
+               SizeWriter& sizes) {
+  WriteCode(value, buffer, sizes);
+}
+
+template <typename T>
+void WriteSection(SectionId section_id,
+                  const std::vector<T>& values,
+                  Buffer& buffer,
+                  SizeWriter& sizes) {
+  if (values.empty()) {
+    return;
+  }
+  Write(section_id, std::back_inserter(buffer));
+  auto size = sizes.Begin();
+  assert(values.size() < std::numeric_limits<u32>::max());
+  Write(static_cast<u32>(values.size()), std::back_inserter(buffer));
+  for (const auto& value : values) {
+    WriteItem(value, buffer, sizes);
+  }
+  sizes.End(size);
+}
+
+// Encodes the function bodies on `num_threads` threads. Each thread appends
+// the bodies it encodes to its own chunk; they're then copied to `buffer` in
+// order.
+void WriteCodeSectionParallel(const std::vector<At<UnpackedCode>>& codes,
+                              Buffer& buffer,
+                              SizeWriter& sizes,
+                              Index num_threads) {
+  struct Body {
+    Index worker;
+    size_t begin;
+    size_t end;
+  };
+
+  Index count = static_cast<Index>(codes.size());
+  std::vector<Buffer> chunks(std::min(num_threads, count));
+  std::vector<Body> bodies(count);
+  ParallelFor(count, num_threads, [&](Index worker, Index index) {
+    const auto& code = *codes[index];
+    auto& chunk = chunks[worker];
+    size_t begin = chunk.size();
+    auto out = std::back_inserter(chunk);
+    out = WriteVector(code.locals.begin(), code.locals.end(), out);
+    Write(code.body, out);
+    bodies[index] = Body{worker, begin, chunk.size()};
+  });
+
+  Write(SectionId::Code, std::back_inserter(buffer));
+  auto section_size = sizes.Begin();
+  Write(count, std::back_inserter(buffer));
+  for (const auto& body : bodies) {
+    const auto& chunk = chunks[body.worker];
+    auto size = sizes.Begin();
+    buffer.insert(buffer.end(), chunk.begin() + body.begin,
+                  chunk.begin() + body.end);
+    sizes.End(size);
+  }
+  sizes.End(section_size);
+}
+
+template <typename T>
+void WriteSection(SectionId section_id,
+                  const optional<T>& value,
+                  Buffer& buffer,
+                  SizeWriter& sizes) {
+  if (!value) {
+    return;
+  }
+  Write(section_id, std::back_inserter(buffer));
+  auto size = sizes.Begin();
+  WriteItem(*value, buffer, sizes);
+  sizes.End(size);
+}
+
+}  // namespace
+
+void WriteModule(const Module& value,
+                 Buffer& buffer,
+                 CompactSizes compact_sizes,
+                 Index num_threads) {
+  SizeWriter sizes{buffer};
+  WriteBytes(encoding::Magic, std::back_inserter(buffer));
+  WriteBytes(encoding::Version, std::back_inserter(buffer));
+  WriteSection(SectionId::Type, value.types, buffer, sizes);
+  WriteSection(SectionId::Import, value.imports, buffer, sizes);
+  WriteSection(SectionId::Function, value.functions, buffer, sizes);
+  WriteSection(SectionId::Table, value.tables, buffer, sizes);
+  WriteSection(SectionId::Memory, value.memories, buffer, sizes);
+  WriteSection(SectionId::Global, value.globals, buffer, sizes);
+  WriteSection(SectionId::Tag, value.tags, buffer, sizes);
+  WriteSection(SectionId::Export, value.exports, buffer, sizes);
+  WriteSection(SectionId::Start, value.start, buffer, sizes);
+  WriteSection(SectionId::Element, value.element_segments, buffer, sizes);
+  WriteSection(SectionId::DataCount, value.data_count, buffer, sizes);
+  if (num_threads > 1 && value.codes.size() > 1) {
+    WriteCodeSectionParallel(value.codes, buffer, sizes, num_threads);
+  } else {
+    WriteSection(SectionId::Code, value.codes, buffer, sizes);
+  }
+  WriteSection(SectionId::Data, value.data_segments, buffer, sizes);
+  if (compact_sizes == CompactSizes::Yes) {
+    sizes.Compact();
+  }
+}
+
+}  // namespace wasp::binary
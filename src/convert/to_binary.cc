@@ -25,14 +25,16 @@ namespace wasp::convert {
 
 BinCtx::BinCtx(const Features& features) : features{features} {}
 
-string_view BinCtx::Add(std::string str) {
-  strings.push_back(std::make_unique<std::string>(str));
-  return string_view{*strings.back()};
+string_view BinCtx::Add(string_view str) {
+  return arena.Add(str);
 }
 
-SpanU8 BinCtx::Add(Buffer buffer) {
-  buffers.push_back(std::make_unique<Buffer>(std::move(buffer)));
-  return SpanU8{*buffers.back()};
+SpanU8 BinCtx::Add(SpanU8 buffer) {
+  return arena.Add(buffer);
+}
+
+string_view BinCtx::Intern(string_view str) {
+  return arena.Intern(str);
 }
 
 auto ToBinary(BinCtx& ctx, const At<text::HeapType>& value)
@@ -99,7 +101,12 @@ auto ToBinary(BinCtx& ctx, const At<text::StorageType>& value)
 }
 
 auto ToBinary(BinCtx& ctx, const At<text::Text>& value) -> At<string_view> {
-  return At{value.loc(), ctx.Add(value->ToString())};
+  if (value->has_escapes == text::HasEscapes::No) {
+    return At{value.loc(), ctx.Intern(value->contents())};
+  }
+  ctx.scratch.clear();
+  value->AppendToBuffer(ctx.scratch);
+  return At{value.loc(), ctx.Intern(ToStringView(ctx.scratch))};
 }
 
 auto ToBinary(BinCtx& ctx, const At<text::Var>& value) -> At<Index> {
@@ -773,11 +780,11 @@ auto ToBinaryCode(BinCtx& ctx, const At<text::Function>& value)
 
 // Section 11: Data
 auto ToBinary(BinCtx& ctx, const At<text::DataItemList>& value) -> SpanU8 {
-  Buffer buffer;
+  ctx.scratch.clear();
   for (auto&& data_item : *value) {
-    data_item->AppendToBuffer(buffer);
+    data_item->AppendToBuffer(ctx.scratch);
   }
-  return ctx.Add(buffer);
+  return ctx.Add(SpanU8{ctx.scratch});
 }
 
 auto ToBinary(BinCtx& ctx, const At<text::DataSegment>& value)
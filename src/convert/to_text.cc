@@ -23,9 +23,9 @@
 
 namespace wasp::convert {
 
-std::string EncodeAsText(string_view str) {
+void EncodeAsText(string_view str, std::string& text) {
   const char kHexDigit[] = "0123456789abcdef";
-  std::string text = "\"";
+  text = "\"";
   for (u8 byte : str) {
     if (byte == '"') {
       text += "\\\"";
@@ -46,12 +46,16 @@ std::string EncodeAsText(string_view str) {
     }
   }
   text += "\"";
-  return text;
 }
 
 text::Text TextCtx::Add(string_view str) {
-  strings.push_back(std::make_unique<std::string>(EncodeAsText(str)));
-  return text::Text{string_view{*strings.back()}, static_cast<u32>(str.size())};
+  EncodeAsText(str, scratch);
+  return text::Text{arena.Add(scratch), static_cast<u32>(str.size())};
+}
+
+text::Text TextCtx::Intern(string_view str) {
+  EncodeAsText(str, scratch);
+  return text::Text{arena.Intern(scratch), static_cast<u32>(str.size())};
 }
 
 // Helpers.
@@ -128,7 +132,7 @@ auto ToText(TextCtx& ctx, const At<binary::StorageType>& value)
 }
 
 auto ToText(TextCtx& ctx, const At<string_view>& value) -> At<text::Text> {
-  return At{value.loc(), ctx.Add(*value)};
+  return At{value.loc(), ctx.Intern(*value)};
 }
 
 auto ToText(TextCtx& ctx, const At<Index>& value) -> At<text::Var> {
@@ -23,6 +23,18 @@ import sys
 SOURCE_DIR = os.path.dirname(os.path.abspath(__file__))
 DEFAULT_INPUT = os.path.join(SOURCE_DIR, 'keywords.txt')
 DEFAULT_OUTPUT = os.path.join(SOURCE_DIR, 'keywords-inl.cc')
+DEFAULT_HASH_OUTPUT = os.path.join(SOURCE_DIR, 'keywords-hash-inl.cc')
+
+# Parameters for the perfect hash; see EmitHash. The multipliers must match
+# HashKeyword in lex.cc.
+TABLE_BITS = 10
+BUCKET_BITS = 8
+WORD_MULTIPLIERS = (0x9e3779b97f4a7c15, 0xc2b2ae3d27d4eb4f,
+                    0x165667b19e3779f9, 0x27d4eb2f165667c5)
+FINAL_MULTIPLIER = 0x9e3779b97f4a7c15
+SLOT_MULTIPLIER = 0x85ebca6b
+U32_MASK = (1 << 32) - 1
+U64_MASK = (1 << 64) - 1
 
 class Error(Exception):
     pass
@@ -46,13 +58,17 @@ class Runner(object):
                 self.values[parts[0]] = parts[1:]
 
     def Run(self):
-        if self.options.output:
-            with open(self.options.output, 'w') as output_file:
+        self.RunOne(self.options.output, lambda: self.Emit(self.keys))
+        self.RunOne(self.options.hash_output, lambda: self.EmitHash(self.keys))
+
+    def RunOne(self, filename, emit):
+        if filename:
+            with open(filename, 'w') as output_file:
                 self.output_file = output_file
-                self.Emit(self.keys)
+                emit()
         else:
             self.output_file = sys.stdout
-            self.Emit(self.keys)
+            emit()
         self.output_file = None
 
     def DistinctChars(self, keys, index):
@@ -81,16 +97,9 @@ class Runner(object):
 
             if len(subkeys) == 1:
                 key = subkeys[0]
-                values = tuple(self.values[key])
-                if values[0] in ('TokenType::AlignEqNat',
-                                 'TokenType::OffsetEqNat'):
-                  self.Print('', ' return LexNameEqNum(data, "{}", {});'.format(
-                             key, values[0]))
-                elif values == ('TokenType::Float', 'LiteralKind::NanPayload'):
-                  self.Print('', ' return LexNan(data);')
-                else:
-                  self.Print('', ' return LexKeyword(data, "{}", {});'.format(
-                             key, ', '.join(values)))
+                self.Print('', ' ' + (self.PrefixReturn(key) or
+                    'return LexKeyword(data, "{}", {});'.format(
+                        key, ', '.join(self.values[key]))))
             else:
                 self.Print()
                 self.Emit(subkeys, indent + '    ')
@@ -100,6 +109,99 @@ class Runner(object):
         self.Print(indent, '}')
         self.Print(indent, 'break;')
 
+    def PrefixReturn(self, key):
+        """Returns the statement that lexes a keyword that is followed by a
+        number (e.g. `align=8`), or None if `key` isn't one of those."""
+        values = tuple(self.values[key])
+        if values[0] in ('TokenType::AlignEqNat', 'TokenType::OffsetEqNat'):
+            return 'return LexNameEqNum(data, "{}", {});'.format(key, values[0])
+        elif values == ('TokenType::Float', 'LiteralKind::NanPayload'):
+            return 'return LexNan(data);'
+        return None
+
+    def Hash(self, key):
+        """Mirrors HashKeyword in lex.cc: mixes the length, the first 16 bytes
+        and (for longer keywords) the last 8 bytes."""
+        data = key.encode()
+        def Word(chunk):
+            return int.from_bytes(chunk.ljust(8, b'\0'), 'little')
+        words = (len(data), Word(data[:8]), Word(data[8:16]),
+                 Word(data[-8:]) if len(data) > 16 else 0)
+        x = 0
+        for word, multiplier in zip(words, WORD_MULTIPLIERS):
+            x ^= (word * multiplier) & U64_MASK
+        return (((x ^ (x >> 32)) * FINAL_MULTIPLIER) & U64_MASK) >> 32
+
+    def Slot(self, h, seed):
+        return (((h ^ seed) * SLOT_MULTIPLIER) & U32_MASK) >> (32 - TABLE_BITS)
+
+    def EmitHash(self, keys):
+        """Emits a perfect hash ("hash and displace") from keywords to table
+        slots. The top bits of a keyword's hash choose a bucket, and each
+        bucket has a seed that moves its keywords to free slots. A keyword is
+        then found with a single string comparison against its slot."""
+        hashes = {key: self.Hash(key) for key in keys}
+        if len(set(hashes.values())) != len(keys):
+            raise Error('Keyword hashes collide')
+
+        buckets = collections.defaultdict(list)
+        for key in keys:
+            buckets[hashes[key] >> (32 - BUCKET_BITS)].append(key)
+
+        seeds = [0] * (1 << BUCKET_BITS)
+        slots = [None] * (1 << TABLE_BITS)
+        for bucket, bucket_keys in sorted(buckets.items(),
+                                          key=lambda item: -len(item[1])):
+            for seed in range(1 << 16):
+                candidate = [self.Slot(hashes[key], seed) for key in bucket_keys]
+                if (len(set(candidate)) == len(candidate) and
+                        all(slots[slot] is None for slot in candidate)):
+                    break
+            else:
+                raise Error('Unable to find a seed for bucket {}'.format(bucket))
+            seeds[bucket] = seed
+            for key, slot in zip(bucket_keys, candidate):
+                slots[slot] = key
+
+        self.Print('', '{')
+        self.Print('', '  static constexpr u16 kSeeds[] = {')
+        for i in range(0, len(seeds), 12):
+            self.Print('', '      {},'.format(
+                ', '.join(str(seed) for seed in seeds[i:i + 12])))
+        self.Print('', '  };')
+        self.Print('', '  static constexpr string_view kKeywords[] = {')
+        for key in slots:
+            self.Print('', '      "{}",'.format(key or ''))
+        self.Print('', '  };')
+        self.Print()
+        self.Print('', '  auto n = CountReservedChars(data);')
+        self.Print('', '  if (n <= {}) {{'.format(max(len(key) for key in keys)))
+        self.Print('', '    u32 h = HashKeyword(data, n);')
+        self.Print('', '    u32 slot = ((h ^ kSeeds[h >> {}]) * {:#x}u) >> {};'.format(
+            32 - BUCKET_BITS, SLOT_MULTIPLIER, 32 - TABLE_BITS))
+        self.Print('', '    if (kKeywords[slot] == ToStringView(data->first(n))) {')
+        self.Print('', '      switch (slot) {')
+        for slot, key in enumerate(slots):
+            if key is None:
+                continue
+            statement = self.PrefixReturn(key) or (
+                'return MatchedKeyword(data, n, {});'.format(
+                    ', '.join(self.values[key])))
+            self.Print('', '        case {}: {}'.format(slot, statement))
+        self.Print('', '        default: break;')
+        self.Print('', '      }')
+        self.Print('', '    }')
+        self.Print('', '  }')
+        for key in keys:
+            statement = self.PrefixReturn(key)
+            if statement:
+                self.Print('', '  if (n > {} && HasPrefix(data, "{}")) {{'.format(
+                    len(key), key))
+                self.Print('', '    ' + statement)
+                self.Print('', '  }')
+        self.Print('', '}')
+        self.Print('', 'break;')
+
     def Print(self, indent='', line='', end=None):
         print('{}{}'.format(indent, line), end=end, file=self.output_file)
 
@@ -110,6 +212,9 @@ def main(args):
                         default=DEFAULT_INPUT)
     parser.add_argument('-o', '--output', help='file to write as output',
                         default=DEFAULT_OUTPUT)
+    parser.add_argument('--hash-output',
+                        help='file to write the perfect hash version to',
+                        default=DEFAULT_HASH_OUTPUT)
     options = parser.parse_args(args)
 
     Runner(options.filename, options).Run()
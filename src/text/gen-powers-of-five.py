@@ -0,0 +1,70 @@
+#!/usr/bin/env python3
+#
+# Copyright 2020 WebAssembly Community Group participants
+#
+# Licensed under the Apache License, Version 2.0 (the "License");
+# you may not use this file except in compliance with the License.
+# You may obtain a copy of the License at
+#
+#     http://www.apache.org/licenses/LICENSE-2.0
+#
+# Unless required by applicable law or agreed to in writing, software
+# distributed under the License is distributed on an "AS IS" BASIS,
+# WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+# See the License for the specific language governing permissions and
+# limitations under the License.
+#
+
+# Generates the table of 128-bit powers of five used by ParseDecimalFloat in
+# numeric.cc. Entry q is 5**q scaled by a power of two so that its top bit is
+# set, truncated to 128 bits (rounded up for negative q). See "Number Parsing
+# at a Gigabyte per Second" (Lemire, 2021).
+
+import argparse
+import os
+import sys
+
+SOURCE_DIR = os.path.dirname(os.path.abspath(__file__))
+DEFAULT_OUTPUT = os.path.join(SOURCE_DIR, 'powers-of-five-inl.cc')
+
+# Must match kMinPowerOfFive and kMaxPowerOfFive in numeric.cc.
+MIN_POWER = -342
+MAX_POWER = 308
+
+
+def PowerOfFive(q):
+    if q < 0:
+        power5 = 5 ** -q
+        z = power5.bit_length()
+        b = z + 127 if q >= -27 else 2 * z + 2 * 64
+        c = 2 ** b // power5 + 1
+        while c >= 1 << 128:
+            c //= 2
+        return c
+    else:
+        power5 = 5 ** q
+        while power5 < 1 << 127:
+            power5 *= 2
+        while power5 >= 1 << 128:
+            power5 //= 2
+        return power5
+
+
+def main(args):
+    parser = argparse.ArgumentParser()
+    parser.add_argument('-o', '--output', help='file to write as output',
+                        default=DEFAULT_OUTPUT)
+    options = parser.parse_args(args)
+
+    with open(options.output, 'w') as output_file:
+        output_file.write(
+            '// Generated by gen-powers-of-five.py; do not edit.\n')
+        for q in range(MIN_POWER, MAX_POWER + 1):
+            c = PowerOfFive(q)
+            output_file.write('{0x%016xull, 0x%016xull},  // 5^%d\n' %
+                              (c >> 64, c & ((1 << 64) - 1), q))
+    return 0
+
+
+if __name__ == '__main__':
+    sys.exit(main(sys.argv[1:]))
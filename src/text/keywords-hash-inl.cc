@@ -0,0 +1,1722 @@
+{
+  static constexpr u16 kSeeds[] = {
+      3, 11, 0, 9, 1, 1, 0, 3, 3, 4, 18, 0,
+      0, 5, 0, 0, 2, 7, 0, 0, 6, 1, 0, 1,
+      2, 0, 3, 1, 0, 0, 0, 0, 9, 5, 3, 2,
+      14, 9, 4, 6, 9, 3, 0, 1, 1, 5, 2, 0,
+      1, 6, 0, 4, 0, 0, 2, 0, 2, 0, 1, 3,
+      1, 0, 0, 0, 3, 1, 18, 8, 10, 0, 2, 9,
+      1, 23, 2, 2, 6, 1, 1, 0, 2, 2, 0, 2,
+      3, 0, 6, 0, 2, 0, 0, 2, 2, 0, 0, 0,
+      1, 0, 4, 4, 1, 4, 0, 2, 4, 0, 1, 1,
+      7, 4, 10, 0, 2, 1, 0, 0, 3, 0, 0, 0,
+      0, 2, 2, 2, 1, 2, 0, 2, 1, 1, 6, 0,
+      2, 3, 2, 2, 2, 4, 3, 9, 0, 0, 1, 4,
+      0, 2, 2, 1, 0, 0, 0, 1, 4, 4, 1, 1,
+      9, 1, 1, 0, 3, 1, 6, 0, 5, 0, 2, 1,
+      0, 1, 1, 0, 16, 0, 12, 1, 0, 0, 1, 3,
+      0, 4, 0, 6, 10, 3, 0, 1, 0, 4, 0, 0,
+      2, 0, 5, 3, 1, 0, 4, 2, 0, 5, 6, 0,
+      7, 3, 5, 0, 1, 9, 0, 0, 1, 25, 0, 13,
+      2, 8, 8, 0, 1, 2, 0, 4, 0, 5, 0, 1,
+      0, 7, 0, 14, 3, 6, 1, 0, 3, 2, 0, 0,
+      0, 0, 7, 0, 2, 0, 0, 0, 0, 0, 0, 0,
+      0, 0, 6, 2,
+  };
+  static constexpr string_view kKeywords[] = {
+      "f64.load",
+      "f64.promote/f32",
+      "",
+      "local.tee",
+      "ref.cast",
+      "f32.trunc",
+      "",
+      "",
+      "",
+      "",
+      "i16x8.narrow_i32x4_s",
+      "i16x8.extract_lane_s",
+      "elem.drop",
+      "i32.atomic.rmw.cmpxchg",
+      "i64x2.shl",
+      "f64.convert_s/i32",
+      "v128.and",
+      "i16x8.add_sat_s",
+      "i64.extend16_s",
+      "",
+      "",
+      "f32x4.lt",
+      "i32.trunc_sat_f64_u",
+      "v128.load8_lane",
+      "i64.load8_u",
+      "",
+      "f32.min",
+      "i64.xor",
+      "v128.store8_lane",
+      "i64x2.add",
+      "ref.as_non_null",
+      "f64x2.div",
+      "i32x4.shr_s",
+      "",
+      "set_global",
+      "",
+      "f32.store",
+      "i8x16.shl",
+      "",
+      "else",
+      "",
+      "v128.load32_splat",
+      "i32.atomic.rmw16.xor_u",
+      "",
+      "",
+      "i64.trunc_sat_f32_u",
+      "i32.trunc_u/f64",
+      "i8x16.shr_u",
+      "i16x8.extend_low_i8x16_u",
+      "f32.reinterpret_i32",
+      "i64.atomic.rmw.cmpxchg",
+      "i8x16.eq",
+      "",
+      "type",
+      "offset=",
+      "",
+      "",
+      "struct",
+      "",
+      "field",
+      "i32.ne",
+      "f32.demote_f64",
+      "i32x4",
+      "",
+      "f64.const",
+      "i8x16.replace_lane",
+      "f64.convert_i64_s",
+      "f64.reinterpret_i64",
+      "i31ref",
+      "f64x2.floor",
+      "",
+      "i64.ctz",
+      "",
+      "i16x8.lt_s",
+      "i64x2.extend_low_i32x4_u",
+      "",
+      "f32x4.neg",
+      "nan",
+      "current_memory",
+      "",
+      "i32x4.mul",
+      "",
+      "i32x4.replace_lane",
+      "",
+      "",
+      "",
+      "",
+      "",
+      "",
+      "i32x4.le_u",
+      "",
+      "",
+      "f64x2.mul",
+      "then",
+      "f64x2.sub",
+      "",
+      "",
+      "f64x2.trunc",
+      "register",
+      "i16x8.splat",
+      "",
+      "mut",
+      "item",
+      "",
+      "array.get_s",
+      "i32x4.max_u",
+      "",
+      "v128.load64_lane",
+      "i32.atomic.store16",
+      "f32x4.floor",
+      "v128.load32x2_s",
+      "memory",
+      "v128.store32_lane",
+      "",
+      "i31.get_u",
+      "f64.convert_u/i32",
+      "v128.load8x8_s",
+      "",
+      "",
+      "i64.le_u",
+      "",
+      "",
+      "i8x16.abs",
+      "struct.get_u",
+      "",
+      "i64.atomic.rmw8.and_u",
+      "",
+      "",
+      "i32x4.min_s",
+      "",
+      "",
+      "br_on_null",
+      "",
+      "",
+      "i32.trunc_f32_u",
+      "v128.andnot",
+      "i64.atomic.store16",
+      "",
+      "",
+      "memory.size",
+      "i8x16.bitmask",
+      "assert_return",
+      "",
+      "i64x2.gt_s",
+      "null",
+      "i64.extend_s/i32",
+      "i64x2.neg",
+      "i8x16.narrow_i16x8_u",
+      "i64.atomic.rmw16.and_u",
+      "i32x4.min_u",
+      "i64.trunc_f64_u",
+      "any",
+      "",
+      "i64.lt_u",
+      "i64.store16",
+      "i32x4.trunc_sat_f32x4_u",
+      "i64x2.extmul_high_i32x4_u",
+      "f32x4.mul",
+      "i64.atomic.rmw8.add_u",
+      "",
+      "f64.sqrt",
+      "",
+      "memory.copy",
+      "i16x8.lt_u",
+      "i64x2.extend_low_i32x4_s",
+      "",
+      "result",
+      "f64.store",
+      "i64x2.extmul_high_i32x4_s",
+      "",
+      "i32x4.shr_u",
+      "f64x2.lt",
+      "",
+      "shared",
+      "v128.load16_lane",
+      "i32x4.trunc_sat_f32x4_s",
+      "end",
+      "",
+      "i16x8.min_s",
+      "assert_invalid",
+      "i64.atomic.rmw16.xor_u",
+      "i64.clz",
+      "i16x8.extmul_high_i8x16_u",
+      "i64x2.splat",
+      "f32x4.splat",
+      "i16x8.mul",
+      "",
+      "",
+      "",
+      "",
+      "",
+      "i32.const",
+      "i64.store8",
+      "i32x4.extend_low_i16x8_s",
+      "i64x2.shr_u",
+      "",
+      "i32.atomic.rmw8.xchg_u",
+      "i64.trunc_f32_u",
+      "i64.trunc_u:sat/f32",
+      "",
+      "catch",
+      "",
+      "",
+      "f64x2.ne",
+      "i32.and",
+      "",
+      "i64.atomic.rmw.xchg",
+      "",
+      "",
+      "f64.reinterpret/i64",
+      "i16x8.extmul_high_i8x16_s",
+      "i16x8.narrow_i32x4_u",
+      "",
+      "call_indirect",
+      "i32.trunc_f64_u",
+      "v128.load64_splat",
+      "i64.store",
+      "",
+      "i32.atomic.rmw16.cmpxchg_u",
+      "f32x4.min",
+      "",
+      "i64x2.extract_lane",
+      "f32x4.trunc",
+      "i31.get_s",
+      "i16x8.eq",
+      "ref.eq",
+      "",
+      "i16x8.extend_high_i8x16_u",
+      "i64.atomic.rmw32.or_u",
+      "",
+      "",
+      "",
+      "",
+      "",
+      "",
+      "",
+      "f64.convert_i32_u",
+      "i64.popcnt",
+      "f32.reinterpret/i32",
+      "i8x16.gt_u",
+      "i64.mul",
+      "",
+      "",
+      "f32.demote/f64",
+      "",
+      "i32.mul",
+      "i16x8.sub_sat_u",
+      "",
+      "",
+      "i16x8.shr_u",
+      "return",
+      "",
+      "i8x16.splat",
+      "i64.atomic.rmw32.add_u",
+      "f64x2.eq",
+      "i64x2.all_true",
+      "table.init",
+      "f32x4.nearest",
+      "",
+      "",
+      "",
+      "f64.ne",
+      "i32x4.extract_lane",
+      "f32.const",
+      "f32.le",
+      "",
+      "i32.extend16_s",
+      "",
+      "",
+      "i32x4.extend_low_i16x8_u",
+      "i64.gt_s",
+      "",
+      "i32.rem_s",
+      "",
+      "v128.not",
+      "",
+      "",
+      "",
+      "i32.atomic.rmw8.add_u",
+      "i64.eqz",
+      "i32.atomic.store",
+      "",
+      "",
+      "memory.grow",
+      "i64.extend_i32_u",
+      "i64.load8_s",
+      "i32",
+      "",
+      "i8x16.avgr_u",
+      "local.get",
+      "",
+      "",
+      "i64.atomic.rmw32.sub_u",
+      "v128.store16_lane",
+      "i64.atomic.rmw.or",
+      "",
+      "",
+      "i64.rem_s",
+      "i16x8.extadd_pairwise_i8x16_s",
+      "",
+      "externref",
+      "f64",
+      "f64.mul",
+      "table.grow",
+      "i32.load8_u",
+      "",
+      "",
+      "tee_local",
+      "",
+      "i8x16.popcnt",
+      "i64.trunc_s:sat/f32",
+      "",
+      "do",
+      "",
+      "",
+      "i32.atomic.rmw8.cmpxchg_u",
+      "",
+      "export",
+      "i16x8.bitmask",
+      "i64.load16_s",
+      "",
+      "i32.lt_u",
+      "",
+      "",
+      "ref.null",
+      "",
+      "",
+      "v128",
+      "i32.shr_s",
+      "i32.atomic.load",
+      "memory.fill",
+      "",
+      "i16x8.shr_s",
+      "i64.shr_s",
+      "i32.atomic.rmw.or",
+      "get_local",
+      "",
+      "",
+      "i64x2.shr_s",
+      "v128.load64_zero",
+      "grow_memory",
+      "i32x4.trunc_sat_f64x2_u_zero",
+      "f32x4.extract_lane",
+      "i8x16.shr_s",
+      "",
+      "",
+      "i8x16.sub_sat_u",
+      "f32.lt",
+      "i16x8.q15mulr_sat_s",
+      "f64.nearest",
+      "i32x4.all_true",
+      "i32.sub",
+      "",
+      "i16x8.extmul_low_i8x16_u",
+      "i8x16.narrow_i16x8_s",
+      "i32.atomic.rmw16.sub_u",
+      "i32.trunc_u/f32",
+      "i32.atomic.rmw16.and_u",
+      "func.bind",
+      "",
+      "ref.test",
+      "br_if",
+      "",
+      "",
+      "i8x16.min_u",
+      "f64.convert_s/i64",
+      "i8",
+      "i16x8.extend_low_i8x16_s",
+      "",
+      "",
+      "",
+      "",
+      "",
+      "local",
+      "delegate",
+      "f64x2.ge",
+      "ref.func",
+      "f32.convert_u/i64",
+      "",
+      "throw",
+      "f32x4.gt",
+      "",
+      "i64",
+      "f64.convert_i32_s",
+      "f64x2.nearest",
+      "",
+      "v128.store",
+      "i32.load8_s",
+      "",
+      "",
+      "i32.trunc_s:sat/f64",
+      "",
+      "eqref",
+      "",
+      "",
+      "i64.atomic.load",
+      "i64.extend_u/i32",
+      "i64.shr_u",
+      "i64.load",
+      "",
+      "data.drop",
+      "f32x4.ne",
+      "",
+      "i64.atomic.rmw32.and_u",
+      "i32x4.extend_high_i16x8_u",
+      "",
+      "",
+      "",
+      "",
+      "f64x2.convert_low_i32x4_s",
+      "",
+      "nan:arithmetic",
+      "",
+      "i8x16",
+      "func",
+      "i64.div_s",
+      "i8x16.max_s",
+      "",
+      "i8x16.sub",
+      "memory.atomic.notify",
+      "local.set",
+      "i64.trunc_sat_f64_u",
+      "f64x2.abs",
+      "",
+      "i32.div_u",
+      "v128.load32x2_u",
+      "",
+      "",
+      "i64.const",
+      "",
+      "",
+      "",
+      "i32x4.dot_i16x8_s",
+      "i64.atomic.rmw8.xor_u",
+      "array.new_with_rtt",
+      "",
+      "i64x2.eq",
+      "get_global",
+      "i31.new",
+      "f64.le",
+      "",
+      "i32.atomic.rmw8.xor_u",
+      "",
+      "",
+      "nop",
+      "struct.new_with_rtt",
+      "i32x4.ge_u",
+      "",
+      "",
+      "i8x16.extract_lane_u",
+      "array.get",
+      "i64.trunc_s:sat/f64",
+      "",
+      "f32.ceil",
+      "i64.ne",
+      "",
+      "i8x16.ge_s",
+      "f32x4.demote_f64x2_zero",
+      "i32.trunc_u:sat/f64",
+      "i32.rem_u",
+      "",
+      "i32x4.ge_s",
+      "",
+      "i64.reinterpret_f64",
+      "",
+      "",
+      "",
+      "nan:canonical",
+      "i32.load",
+      "f64x2.gt",
+      "",
+      "i32.gt_s",
+      "i32.or",
+      "",
+      "",
+      "f32x4.replace_lane",
+      "table.size",
+      "memory.atomic.wait32",
+      "i32.atomic.rmw16.add_u",
+      "",
+      "",
+      "br_table",
+      "i32.atomic.rmw8.sub_u",
+      "return_call",
+      "i64.atomic.rmw.add",
+      "",
+      "",
+      "i16x8.sub",
+      "start",
+      "i8x16.le_u",
+      "f32x4.convert_i32x4_s",
+      "i64.lt_s",
+      "i16x8.neg",
+      "i64x2.ge_s",
+      "i8x16.le_s",
+      "",
+      "",
+      "",
+      "",
+      "f64.ceil",
+      "",
+      "f64x2",
+      "f64.promote_f32",
+      "i8x16.ge_u",
+      "tag",
+      "i32.xor",
+      "i64.reinterpret/f64",
+      "i64.div_u",
+      "f32.convert_i32_u",
+      "ref.is_null",
+      "i32.eq",
+      "array.get_u",
+      "",
+      "i32x4.eq",
+      "i32.store16",
+      "",
+      "i8x16.all_true",
+      "",
+      "i64.atomic.load32_u",
+      "i64.atomic.rmw.xor",
+      "i64x2.lt_s",
+      "",
+      "param",
+      "i32x4.trunc_sat_f64x2_s_zero",
+      "i64x2",
+      "nan:0x",
+      "i64x2.ne",
+      "f64x2.splat",
+      "",
+      "v128.load16x4_s",
+      "rtt.sub",
+      "",
+      "",
+      "",
+      "v128.xor",
+      "",
+      "i64.rem_u",
+      "i64.load32_s",
+      "table",
+      "assert_unlinkable",
+      "table.copy",
+      "f32x4",
+      "",
+      "f64.convert_i64_u",
+      "",
+      "",
+      "",
+      "",
+      "f32.add",
+      "i32.wrap/i64",
+      "",
+      "i8x16.ne",
+      "unreachable",
+      "",
+      "f64x2.replace_lane",
+      "",
+      "",
+      "f64x2.pmin",
+      "",
+      "f32",
+      "",
+      "select",
+      "struct.new_default_with_rtt",
+      "",
+      "i32.trunc_s/f32",
+      "f32x4.div",
+      "i8x16.add_sat_s",
+      "",
+      "i8x16.shuffle",
+      "",
+      "i32.eqz",
+      "",
+      "",
+      "",
+      "",
+      "i32x4.gt_s",
+      "i16x8.extend_high_i8x16_s",
+      "i32.lt_s",
+      "i64.atomic.store",
+      "br_on_cast",
+      "i64.atomic.rmw32.cmpxchg_u",
+      "return_call_indirect",
+      "funcref",
+      "",
+      "i32x4.extend_high_i16x8_s",
+      "f32x4.sqrt",
+      "f64x2.sqrt",
+      "v128.or",
+      "i32.clz",
+      "i32x4.sub",
+      "",
+      "f32.convert_s/i64",
+      "f32.max",
+      "array.new_default_with_rtt",
+      "",
+      "i64x2.extmul_low_i32x4_u",
+      "i64.add",
+      "f64.floor",
+      "i16x8.min_u",
+      "i64.extend8_s",
+      "i64.le_s",
+      "",
+      "",
+      "i32x4.extmul_high_i16x8_u",
+      "f32.convert_i64_s",
+      "i8x16.gt_s",
+      "i32.trunc_sat_f64_s",
+      "i32.wrap_i64",
+      "i16x8.gt_u",
+      "i64.trunc_u/f32",
+      "",
+      "i64.atomic.rmw16.add_u",
+      "f32.copysign",
+      "i32.atomic.rmw.xor",
+      "ref",
+      "",
+      "",
+      "i32.trunc_f32_s",
+      "i8x16.neg",
+      "",
+      "i32.atomic.rmw16.or_u",
+      "",
+      "v128.load8_splat",
+      "f64.neg",
+      "",
+      "",
+      "",
+      "",
+      "",
+      "i64.atomic.rmw8.sub_u",
+      "f32x4.sub",
+      "f32.convert_u/i32",
+      "f32.div",
+      "i64.atomic.store8",
+      "i8x16.add_sat_u",
+      "i16x8.all_true",
+      "anyfunc",
+      "",
+      "global.set",
+      "i8x16.sub_sat_s",
+      "",
+      "i64.sub",
+      "i16x8.avgr_u",
+      "",
+      "i32.trunc_sat_f32_s",
+      "i16x8.ne",
+      "i64x2.extend_high_i32x4_s",
+      "i32x4.extmul_low_i16x8_s",
+      "i32x4.neg",
+      "i16x8.extmul_low_i8x16_s",
+      "f32x4.add",
+      "v128.bitselect",
+      "i64.rotl",
+      "f32.sub",
+      "array.set",
+      "",
+      "f32x4.le",
+      "",
+      "extern",
+      "",
+      "i32.atomic.rmw.and",
+      "",
+      "",
+      "global",
+      "",
+      "",
+      "",
+      "module",
+      "",
+      "",
+      "i64.ge_u",
+      "f64.abs",
+      "",
+      "",
+      "call_ref",
+      "i32x4.bitmask",
+      "",
+      "quote",
+      "",
+      "i64.atomic.store32",
+      "elem",
+      "i32x4.extmul_high_i16x8_s",
+      "",
+      "i32x4.lt_s",
+      "",
+      "",
+      "i8x16.add",
+      "",
+      "",
+      "i32x4.lt_u",
+      "table.set",
+      "i64.extend_i32_s",
+      "",
+      "i32.atomic.rmw8.and_u",
+      "i64.atomic.load16_u",
+      "i16x8.replace_lane",
+      "",
+      "rtt",
+      "",
+      "ref.extern",
+      "v128.any_true",
+      "",
+      "",
+      "i64.atomic.rmw16.sub_u",
+      "",
+      "i64.atomic.rmw8.cmpxchg_u",
+      "",
+      "",
+      "i32.div_s",
+      "i16x8.shl",
+      "i32.atomic.load8_u",
+      "f64x2.extract_lane",
+      "i64.rotr",
+      "import",
+      "br",
+      "f64x2.le",
+      "i64.atomic.load8_u",
+      "",
+      "",
+      "",
+      "",
+      "i64x2.replace_lane",
+      "i16x8",
+      "",
+      "",
+      "",
+      "table.get",
+      "i8x16.swizzle",
+      "i16x8.le_u",
+      "try",
+      "i32.popcnt",
+      "i64.trunc_s/f32",
+      "",
+      "i64.trunc_f32_s",
+      "f32x4.ceil",
+      "",
+      "anyref",
+      "",
+      "set_local",
+      "f32.gt",
+      "",
+      "i64.atomic.rmw8.xchg_u",
+      "array",
+      "f32.neg",
+      "",
+      "memory.atomic.wait64",
+      "",
+      "",
+      "table.fill",
+      "",
+      "f32.ge",
+      "",
+      "assert_trap",
+      "i32x4.extadd_pairwise_i16x8_s",
+      "v128.load",
+      "",
+      "i32x4.shl",
+      "f32.abs",
+      "f32x4.pmin",
+      "v128.load32_zero",
+      "",
+      "f32x4.ge",
+      "",
+      "f64.gt",
+      "i8x16.max_u",
+      "",
+      "",
+      "",
+      "i32.trunc_s:sat/f32",
+      "i32.shr_u",
+      "",
+      "return_call_ref",
+      "",
+      "",
+      "i32x4.ne",
+      "",
+      "struct.get_s",
+      "br_on_non_null",
+      "i64.atomic.rmw16.or_u",
+      "v128.const",
+      "",
+      "i32.shl",
+      "",
+      "",
+      "i32.ctz",
+      "",
+      "f64.copysign",
+      "f32.load",
+      "binary",
+      "",
+      "",
+      "i8x16.lt_u",
+      "i64.atomic.rmw16.cmpxchg_u",
+      "loop",
+      "",
+      "f32.nearest",
+      "",
+      "",
+      "",
+      "",
+      "",
+      "i8x16.min_s",
+      "f32.convert_i32_s",
+      "i64.eq",
+      "",
+      "",
+      "i32x4.extmul_low_i16x8_u",
+      "",
+      "v128.load16_splat",
+      "",
+      "f64.lt",
+      "",
+      "i32.atomic.rmw8.or_u",
+      "",
+      "f64x2.neg",
+      "memory.init",
+      "f64x2.convert_low_i32x4_u",
+      "v128.store64_lane",
+      "i64.load32_u",
+      "i16x8.extract_lane_u",
+      "i32.reinterpret/f32",
+      "",
+      "i32.rotr",
+      "",
+      "f64x2.max",
+      "i64.trunc_f64_s",
+      "",
+      "i31",
+      "",
+      "i16x8.abs",
+      "",
+      "i32x4.extadd_pairwise_i16x8_u",
+      "f32x4.max",
+      "inf",
+      "",
+      "",
+      "",
+      "data",
+      "f32.convert_s/i32",
+      "i64.trunc_u/f64",
+      "i32.ge_s",
+      "",
+      "f32x4.convert_i32x4_u",
+      "i64.trunc_s/f64",
+      "",
+      "f64x2.min",
+      "i16x8.max_s",
+      "rethrow",
+      "assert_exhaustion",
+      "f64.add",
+      "",
+      "",
+      "",
+      "f64.div",
+      "",
+      "f32.floor",
+      "i64.atomic.rmw32.xor_u",
+      "f32.ne",
+      "",
+      "i32.load16_s",
+      "i64x2.mul",
+      "f64.sub",
+      "",
+      "i16x8.extadd_pairwise_i8x16_u",
+      "i64.atomic.rmw.and",
+      "i32.trunc_s/f64",
+      "f32x4.pmax",
+      "array.len",
+      "i64x2.extend_high_i32x4_u",
+      "f64x2.pmax",
+      "f64.ge",
+      "i32x4.max_s",
+      "call",
+      "",
+      "",
+      "i16x8.add_sat_u",
+      "",
+      "",
+      "i64x2.abs",
+      "i64.extend32_s",
+      "declare",
+      "rtt.canon",
+      "",
+      "i32.trunc_u:sat/f32",
+      "f64x2.promote_low_f32x4",
+      "i16x8.gt_s",
+      "i64.shl",
+      "global.get",
+      "f64.eq",
+      "i64.or",
+      "eq",
+      "f32.mul",
+      "",
+      "",
+      "",
+      "invoke",
+      "",
+      "f32.sqrt",
+      "i16x8.sub_sat_s",
+      "",
+      "",
+      "struct.get",
+      "i64x2.sub",
+      "i16x8.ge_s",
+      "i32.store8",
+      "i64x2.extmul_low_i32x4_s",
+      "",
+      "",
+      "block",
+      "i32.atomic.rmw.xchg",
+      "",
+      "",
+      "i32x4.gt_u",
+      "i16",
+      "",
+      "",
+      "i16x8.max_u",
+      "i32.trunc_sat_f32_u",
+      "v128.load32_lane",
+      "",
+      "offset",
+      "i32.le_u",
+      "",
+      "f32.convert_i64_u",
+      "i64.store32",
+      "",
+      "i32.gt_u",
+      "",
+      "",
+      "i64x2.bitmask",
+      "",
+      "f64x2.add",
+      "i32.le_s",
+      "",
+      "",
+      "i32.rotl",
+      "i64.ge_s",
+      "f32x4.eq",
+      "i32.atomic.rmw16.xchg_u",
+      "i32.ge_u",
+      "i16x8.ge_u",
+      "i32x4.le_s",
+      "i64.atomic.rmw.sub",
+      "",
+      "",
+      "i64.atomic.rmw16.xchg_u",
+      "",
+      "",
+      "",
+      "i64.atomic.rmw32.xchg_u",
+      "i64.load16_u",
+      "i32.load16_u",
+      "",
+      "struct.set",
+      "",
+      "v128.load16x4_u",
+      "",
+      "",
+      "i32.atomic.rmw.sub",
+      "align=",
+      "f64.convert_u/i64",
+      "i16x8.le_s",
+      "i64.gt_u",
+      "i32.atomic.store8",
+      "i32.atomic.rmw.add",
+      "i8x16.extract_lane_s",
+      "",
+      "",
+      "",
+      "",
+      "let",
+      "i64x2.le_s",
+      "",
+      "i32.add",
+      "",
+      "",
+      "i64.trunc_sat_f64_s",
+      "get",
+      "drop",
+      "i32.extend8_s",
+      "i16x8.add",
+      "",
+      "i32.atomic.load16_u",
+      "i32.store",
+      "",
+      "i64.and",
+      "",
+      "f64.max",
+      "",
+      "",
+      "f32.eq",
+      "",
+      "i8x16.lt_s",
+      "i64.trunc_u:sat/f64",
+      "",
+      "",
+      "i32x4.splat",
+      "",
+      "",
+      "f32x4.abs",
+      "i32x4.abs",
+      "i32x4.add",
+      "",
+      "i64.trunc_sat_f32_s",
+      "f64.min",
+      "f64x2.ceil",
+      "i32.reinterpret_f32",
+      "f64.trunc",
+      "",
+      "",
+      "",
+      "",
+      "",
+      "catch_all",
+      "",
+      "",
+      "",
+      "v128.load8x8_u",
+      "",
+      "i32.trunc_f64_s",
+      "if",
+      "i64.atomic.rmw8.or_u",
+      "assert_malformed",
+      "",
+  };
+
+  auto n = CountReservedChars(data);
+  if (n <= 29) {
+    u32 h = HashKeyword(data, n);
+    u32 slot = ((h ^ kSeeds[h >> 24]) * 0x85ebca6bu) >> 22;
+    if (kKeywords[slot] == ToStringView(data->first(n))) {
+      switch (slot) {
+        case 0: return MatchedKeyword(data, n, TokenType::MemoryInstr, Opcode::F64Load);
+        case 1: return MatchedKeyword(data, n, Opcode::F64PromoteF32);
+        case 3: return MatchedKeyword(data, n, TokenType::VarInstr, Opcode::LocalTee);
+        case 4: return MatchedKeyword(data, n, TokenType::HeapType2Instr, Opcode::RefCast, Features::GC);
+        case 5: return MatchedKeyword(data, n, Opcode::F32Trunc);
+        case 10: return MatchedKeyword(data, n, Opcode::I16X8NarrowI32X4S, Features::Simd);
+        case 11: return MatchedKeyword(data, n, TokenType::SimdLaneInstr, Opcode::I16X8ExtractLaneS, Features::Simd);
+        case 12: return MatchedKeyword(data, n, TokenType::VarInstr, Opcode::ElemDrop, Features::BulkMemory);
+        case 13: return MatchedKeyword(data, n, TokenType::MemoryInstr, Opcode::I32AtomicRmwCmpxchg, Features::Threads);
+        case 14: return MatchedKeyword(data, n, Opcode::I64X2Shl, Features::Simd);
+        case 15: return MatchedKeyword(data, n, Opcode::F64ConvertI32S);
+        case 16: return MatchedKeyword(data, n, Opcode::V128And, Features::Simd);
+        case 17: return MatchedKeyword(data, n, Opcode::I16X8AddSatS, Features::Simd);
+        case 18: return MatchedKeyword(data, n, Opcode::I64Extend16S, Features::SignExtension);
+        case 21: return MatchedKeyword(data, n, Opcode::F32X4Lt, Features::Simd);
+        case 22: return MatchedKeyword(data, n, Opcode::I32TruncSatF64U, Features::SaturatingFloatToInt);
+        case 23: return MatchedKeyword(data, n, TokenType::SimdMemoryLaneInstr, Opcode::V128Load8Lane, Features::Simd);
+        case 24: return MatchedKeyword(data, n, TokenType::MemoryInstr, Opcode::I64Load8U);
+        case 26: return MatchedKeyword(data, n, Opcode::F32Min);
+        case 27: return MatchedKeyword(data, n, Opcode::I64Xor);
+        case 28: return MatchedKeyword(data, n, TokenType::SimdMemoryLaneInstr, Opcode::V128Store8Lane, Features::Simd);
+        case 29: return MatchedKeyword(data, n, Opcode::I64X2Add, Features::Simd);
+        case 30: return MatchedKeyword(data, n, Opcode::RefAsNonNull, Features::FunctionReferences);
+        case 31: return MatchedKeyword(data, n, Opcode::F64X2Div, Features::Simd);
+        case 32: return MatchedKeyword(data, n, Opcode::I32X4ShrS, Features::Simd);
+        case 34: return MatchedKeyword(data, n, TokenType::VarInstr, Opcode::GlobalSet);
+        case 36: return MatchedKeyword(data, n, TokenType::MemoryInstr, Opcode::F32Store);
+        case 37: return MatchedKeyword(data, n, Opcode::I8X16Shl, Features::Simd);
+        case 39: return MatchedKeyword(data, n, TokenType::Else, Opcode::Else);
+        case 41: return MatchedKeyword(data, n, TokenType::MemoryInstr, Opcode::V128Load32Splat, Features::Simd);
+        case 42: return MatchedKeyword(data, n, TokenType::MemoryInstr, Opcode::I32AtomicRmw16XorU, Features::Threads);
+        case 45: return MatchedKeyword(data, n, Opcode::I64TruncSatF32U, Features::SaturatingFloatToInt);
+        case 46: return MatchedKeyword(data, n, Opcode::I32TruncF64U);
+        case 47: return MatchedKeyword(data, n, Opcode::I8X16ShrU, Features::Simd);
+        case 48: return MatchedKeyword(data, n, Opcode::I16X8ExtendLowI8X16U, Features::Simd);
+        case 49: return MatchedKeyword(data, n, Opcode::F32ReinterpretI32);
+        case 50: return MatchedKeyword(data, n, TokenType::MemoryInstr, Opcode::I64AtomicRmwCmpxchg, Features::Threads);
+        case 51: return MatchedKeyword(data, n, Opcode::I8X16Eq, Features::Simd);
+        case 53: return MatchedKeyword(data, n, TokenType::Type);
+        case 54: return LexNameEqNum(data, "offset=", TokenType::OffsetEqNat);
+        case 57: return MatchedKeyword(data, n, TokenType::Struct);
+        case 59: return MatchedKeyword(data, n, TokenType::Field);
+        case 60: return MatchedKeyword(data, n, Opcode::I32Ne);
+        case 61: return MatchedKeyword(data, n, Opcode::F32DemoteF64);
+        case 62: return MatchedKeyword(data, n, SimdShape::I32X4);
+        case 64: return MatchedKeyword(data, n, TokenType::F64ConstInstr, Opcode::F64Const);
+        case 65: return MatchedKeyword(data, n, TokenType::SimdLaneInstr, Opcode::I8X16ReplaceLane, Features::Simd);
+        case 66: return MatchedKeyword(data, n, Opcode::F64ConvertI64S);
+        case 67: return MatchedKeyword(data, n, Opcode::F64ReinterpretI64);
+        case 68: return MatchedKeyword(data, n, ReferenceKind::I31ref);
+        case 69: return MatchedKeyword(data, n, Opcode::F64X2Floor, Features::Simd);
+        case 71: return MatchedKeyword(data, n, Opcode::I64Ctz);
+        case 73: return MatchedKeyword(data, n, Opcode::I16X8LtS, Features::Simd);
+        case 74: return MatchedKeyword(data, n, Opcode::I64X2ExtendLowI32X4U, Features::Simd);
+        case 76: return MatchedKeyword(data, n, Opcode::F32X4Neg, Features::Simd);
+        case 77: return MatchedKeyword(data, n, TokenType::Float, LiteralKind::Nan);
+        case 78: return MatchedKeyword(data, n, Opcode::MemorySize);
+        case 80: return MatchedKeyword(data, n, Opcode::I32X4Mul, Features::Simd);
+        case 82: return MatchedKeyword(data, n, TokenType::SimdLaneInstr, Opcode::I32X4ReplaceLane, Features::Simd);
+        case 89: return MatchedKeyword(data, n, Opcode::I32X4LeU, Features::Simd);
+        case 92: return MatchedKeyword(data, n, Opcode::F64X2Mul, Features::Simd);
+        case 93: return MatchedKeyword(data, n, TokenType::Then);
+        case 94: return MatchedKeyword(data, n, Opcode::F64X2Sub, Features::Simd);
+        case 97: return MatchedKeyword(data, n, Opcode::F64X2Trunc, Features::Simd);
+        case 98: return MatchedKeyword(data, n, TokenType::Register);
+        case 99: return MatchedKeyword(data, n, Opcode::I16X8Splat, Features::Simd);
+        case 101: return MatchedKeyword(data, n, TokenType::Mut);
+        case 102: return MatchedKeyword(data, n, TokenType::Item);
+        case 104: return MatchedKeyword(data, n, TokenType::VarInstr, Opcode::ArrayGetS, Features::GC);
+        case 105: return MatchedKeyword(data, n, Opcode::I32X4MaxU, Features::Simd);
+        case 107: return MatchedKeyword(data, n, TokenType::SimdMemoryLaneInstr, Opcode::V128Load64Lane, Features::Simd);
+        case 108: return MatchedKeyword(data, n, TokenType::MemoryInstr, Opcode::I32AtomicStore16, Features::Threads);
+        case 109: return MatchedKeyword(data, n, Opcode::F32X4Floor, Features::Simd);
+        case 110: return MatchedKeyword(data, n, TokenType::MemoryInstr, Opcode::V128Load32X2S, Features::Simd);
+        case 111: return MatchedKeyword(data, n, TokenType::Memory);
+        case 112: return MatchedKeyword(data, n, TokenType::SimdMemoryLaneInstr, Opcode::V128Store32Lane, Features::Simd);
+        case 114: return MatchedKeyword(data, n, Opcode::I31GetU, Features::GC);
+        case 115: return MatchedKeyword(data, n, Opcode::F64ConvertI32U);
+        case 116: return MatchedKeyword(data, n, TokenType::MemoryInstr, Opcode::V128Load8X8S, Features::Simd);
+        case 119: return MatchedKeyword(data, n, Opcode::I64LeU);
+        case 122: return MatchedKeyword(data, n, Opcode::I8X16Abs, Features::Simd);
+        case 123: return MatchedKeyword(data, n, TokenType::StructFieldInstr, Opcode::StructGetU, Features::GC);
+        case 125: return MatchedKeyword(data, n, TokenType::MemoryInstr, Opcode::I64AtomicRmw8AndU, Features::Threads);
+        case 128: return MatchedKeyword(data, n, Opcode::I32X4MinS, Features::Simd);
+        case 131: return MatchedKeyword(data, n, TokenType::VarInstr, Opcode::BrOnNull, Features::FunctionReferences);
+        case 134: return MatchedKeyword(data, n, Opcode::I32TruncF32U);
+        case 135: return MatchedKeyword(data, n, Opcode::V128Andnot, Features::Simd);
+        case 136: return MatchedKeyword(data, n, TokenType::MemoryInstr, Opcode::I64AtomicStore16, Features::Threads);
+        case 139: return MatchedKeyword(data, n, TokenType::MemoryOptInstr, Opcode::MemorySize);
+        case 140: return MatchedKeyword(data, n, Opcode::I8X16Bitmask, Features::Simd);
+        case 141: return MatchedKeyword(data, n, TokenType::AssertReturn);
+        case 143: return MatchedKeyword(data, n, Opcode::I64X2GtS, Features::Simd);
+        case 144: return MatchedKeyword(data, n, TokenType::Null);
+        case 145: return MatchedKeyword(data, n, Opcode::I64ExtendI32S);
+        case 146: return MatchedKeyword(data, n, Opcode::I64X2Neg, Features::Simd);
+        case 147: return MatchedKeyword(data, n, Opcode::I8X16NarrowI16X8U, Features::Simd);
+        case 148: return MatchedKeyword(data, n, TokenType::MemoryInstr, Opcode::I64AtomicRmw16AndU, Features::Threads);
+        case 149: return MatchedKeyword(data, n, Opcode::I32X4MinU, Features::Simd);
+        case 150: return MatchedKeyword(data, n, Opcode::I64TruncF64U);
+        case 151: return MatchedKeyword(data, n, TokenType::HeapKind, HeapKind::Any);
+        case 153: return MatchedKeyword(data, n, Opcode::I64LtU);
+        case 154: return MatchedKeyword(data, n, TokenType::MemoryInstr, Opcode::I64Store16);
+        case 155: return MatchedKeyword(data, n, Opcode::I32X4TruncSatF32X4U, Features::Simd);
+        case 156: return MatchedKeyword(data, n, Opcode::I64X2ExtmulHighI32X4U, Features::Simd);
+        case 157: return MatchedKeyword(data, n, Opcode::F32X4Mul, Features::Simd);
+        case 158: return MatchedKeyword(data, n, TokenType::MemoryInstr, Opcode::I64AtomicRmw8AddU, Features::Threads);
+        case 160: return MatchedKeyword(data, n, Opcode::F64Sqrt);
+        case 162: return MatchedKeyword(data, n, TokenType::MemoryCopyInstr, Opcode::MemoryCopy, Features::BulkMemory);
+        case 163: return MatchedKeyword(data, n, Opcode::I16X8LtU, Features::Simd);
+        case 164: return MatchedKeyword(data, n, Opcode::I64X2ExtendLowI32X4S, Features::Simd);
+        case 166: return MatchedKeyword(data, n, TokenType::Result);
+        case 167: return MatchedKeyword(data, n, TokenType::MemoryInstr, Opcode::F64Store);
+        case 168: return MatchedKeyword(data, n, Opcode::I64X2ExtmulHighI32X4S, Features::Simd);
+        case 170: return MatchedKeyword(data, n, Opcode::I32X4ShrU, Features::Simd);
+        case 171: return MatchedKeyword(data, n, Opcode::F64X2Lt, Features::Simd);
+        case 173: return MatchedKeyword(data, n, TokenType::Shared);
+        case 174: return MatchedKeyword(data, n, TokenType::SimdMemoryLaneInstr, Opcode::V128Load16Lane, Features::Simd);
+        case 175: return MatchedKeyword(data, n, Opcode::I32X4TruncSatF32X4S, Features::Simd);
+        case 176: return MatchedKeyword(data, n, TokenType::End, Opcode::End);
+        case 178: return MatchedKeyword(data, n, Opcode::I16X8MinS, Features::Simd);
+        case 179: return MatchedKeyword(data, n, TokenType::AssertInvalid);
+        case 180: return MatchedKeyword(data, n, TokenType::MemoryInstr, Opcode::I64AtomicRmw16XorU, Features::Threads);
+        case 181: return MatchedKeyword(data, n, Opcode::I64Clz);
+        case 182: return MatchedKeyword(data, n, Opcode::I16X8ExtmulHighI8X16U, Features::Simd);
+        case 183: return MatchedKeyword(data, n, Opcode::I64X2Splat, Features::Simd);
+        case 184: return MatchedKeyword(data, n, Opcode::F32X4Splat, Features::Simd);
+        case 185: return MatchedKeyword(data, n, Opcode::I16X8Mul, Features::Simd);
+        case 191: return MatchedKeyword(data, n, TokenType::I32ConstInstr, Opcode::I32Const);
+        case 192: return MatchedKeyword(data, n, TokenType::MemoryInstr, Opcode::I64Store8);
+        case 193: return MatchedKeyword(data, n, Opcode::I32X4ExtendLowI16X8S, Features::Simd);
+        case 194: return MatchedKeyword(data, n, Opcode::I64X2ShrU, Features::Simd);
+        case 196: return MatchedKeyword(data, n, TokenType::MemoryInstr, Opcode::I32AtomicRmw8XchgU, Features::Threads);
+        case 197: return MatchedKeyword(data, n, Opcode::I64TruncF32U);
+        case 198: return MatchedKeyword(data, n, Opcode::I64TruncSatF32U, Features::SaturatingFloatToInt);
+        case 200: return MatchedKeyword(data, n, TokenType::Catch, Opcode::Catch, Features::Exceptions);
+        case 203: return MatchedKeyword(data, n, Opcode::F64X2Ne, Features::Simd);
+        case 204: return MatchedKeyword(data, n, Opcode::I32And);
+        case 206: return MatchedKeyword(data, n, TokenType::MemoryInstr, Opcode::I64AtomicRmwXchg, Features::Threads);
+        case 209: return MatchedKeyword(data, n, Opcode::F64ReinterpretI64);
+        case 210: return MatchedKeyword(data, n, Opcode::I16X8ExtmulHighI8X16S, Features::Simd);
+        case 211: return MatchedKeyword(data, n, Opcode::I16X8NarrowI32X4U, Features::Simd);
+        case 213: return MatchedKeyword(data, n, TokenType::CallIndirectInstr, Opcode::CallIndirect);
+        case 214: return MatchedKeyword(data, n, Opcode::I32TruncF64U);
+        case 215: return MatchedKeyword(data, n, TokenType::MemoryInstr, Opcode::V128Load64Splat, Features::Simd);
+        case 216: return MatchedKeyword(data, n, TokenType::MemoryInstr, Opcode::I64Store);
+        case 218: return MatchedKeyword(data, n, TokenType::MemoryInstr, Opcode::I32AtomicRmw16CmpxchgU, Features::Threads);
+        case 219: return MatchedKeyword(data, n, Opcode::F32X4Min, Features::Simd);
+        case 221: return MatchedKeyword(data, n, TokenType::SimdLaneInstr, Opcode::I64X2ExtractLane, Features::Simd);
+        case 222: return MatchedKeyword(data, n, Opcode::F32X4Trunc, Features::Simd);
+        case 223: return MatchedKeyword(data, n, Opcode::I31GetS, Features::GC);
+        case 224: return MatchedKeyword(data, n, Opcode::I16X8Eq, Features::Simd);
+        case 225: return MatchedKeyword(data, n, Opcode::RefEq, Features::GC);
+        case 227: return MatchedKeyword(data, n, Opcode::I16X8ExtendHighI8X16U, Features::Simd);
+        case 228: return MatchedKeyword(data, n, TokenType::MemoryInstr, Opcode::I64AtomicRmw32OrU, Features::Threads);
+        case 236: return MatchedKeyword(data, n, Opcode::F64ConvertI32U);
+        case 237: return MatchedKeyword(data, n, Opcode::I64Popcnt);
+        case 238: return MatchedKeyword(data, n, Opcode::F32ReinterpretI32);
+        case 239: return MatchedKeyword(data, n, Opcode::I8X16GtU, Features::Simd);
+        case 240: return MatchedKeyword(data, n, Opcode::I64Mul);
+        case 243: return MatchedKeyword(data, n, Opcode::F32DemoteF64);
+        case 245: return MatchedKeyword(data, n, Opcode::I32Mul);
+        case 246: return MatchedKeyword(data, n, Opcode::I16X8SubSatU, Features::Simd);
+        case 249: return MatchedKeyword(data, n, Opcode::I16X8ShrU, Features::Simd);
+        case 250: return MatchedKeyword(data, n, Opcode::Return);
+        case 252: return MatchedKeyword(data, n, Opcode::I8X16Splat, Features::Simd);
+        case 253: return MatchedKeyword(data, n, TokenType::MemoryInstr, Opcode::I64AtomicRmw32AddU, Features::Threads);
+        case 254: return MatchedKeyword(data, n, Opcode::F64X2Eq, Features::Simd);
+        case 255: return MatchedKeyword(data, n, Opcode::I64X2AllTrue, Features::Simd);
+        case 256: return MatchedKeyword(data, n, TokenType::TableInitInstr, Opcode::TableInit, Features::BulkMemory);
+        case 257: return MatchedKeyword(data, n, Opcode::F32X4Nearest, Features::Simd);
+        case 261: return MatchedKeyword(data, n, Opcode::F64Ne);
+        case 262: return MatchedKeyword(data, n, TokenType::SimdLaneInstr, Opcode::I32X4ExtractLane, Features::Simd);
+        case 263: return MatchedKeyword(data, n, TokenType::F32ConstInstr, Opcode::F32Const);
+        case 264: return MatchedKeyword(data, n, Opcode::F32Le);
+        case 266: return MatchedKeyword(data, n, Opcode::I32Extend16S, Features::SignExtension);
+        case 269: return MatchedKeyword(data, n, Opcode::I32X4ExtendLowI16X8U, Features::Simd);
+        case 270: return MatchedKeyword(data, n, Opcode::I64GtS);
+        case 272: return MatchedKeyword(data, n, Opcode::I32RemS);
+        case 274: return MatchedKeyword(data, n, Opcode::V128Not, Features::Simd);
+        case 278: return MatchedKeyword(data, n, TokenType::MemoryInstr, Opcode::I32AtomicRmw8AddU, Features::Threads);
+        case 279: return MatchedKeyword(data, n, Opcode::I64Eqz);
+        case 280: return MatchedKeyword(data, n, TokenType::MemoryInstr, Opcode::I32AtomicStore, Features::Threads);
+        case 283: return MatchedKeyword(data, n, TokenType::MemoryOptInstr, Opcode::MemoryGrow);
+        case 284: return MatchedKeyword(data, n, Opcode::I64ExtendI32U);
+        case 285: return MatchedKeyword(data, n, TokenType::MemoryInstr, Opcode::I64Load8S);
+        case 286: return MatchedKeyword(data, n, NumericType::I32);
+        case 288: return MatchedKeyword(data, n, Opcode::I8X16AvgrU, Features::Simd);
+        case 289: return MatchedKeyword(data, n, TokenType::VarInstr, Opcode::LocalGet);
+        case 292: return MatchedKeyword(data, n, TokenType::MemoryInstr, Opcode::I64AtomicRmw32SubU, Features::Threads);
+        case 293: return MatchedKeyword(data, n, TokenType::SimdMemoryLaneInstr, Opcode::V128Store16Lane, Features::Simd);
+        case 294: return MatchedKeyword(data, n, TokenType::MemoryInstr, Opcode::I64AtomicRmwOr, Features::Threads);
+        case 297: return MatchedKeyword(data, n, Opcode::I64RemS);
+        case 298: return MatchedKeyword(data, n, Opcode::I16X8ExtaddPairwiseI8X16S, Features::Simd);
+        case 300: return MatchedKeyword(data, n, ReferenceKind::Externref);
+        case 301: return MatchedKeyword(data, n, NumericType::F64);
+        case 302: return MatchedKeyword(data, n, Opcode::F64Mul);
+        case 303: return MatchedKeyword(data, n, TokenType::VarInstr, Opcode::TableGrow, Features::ReferenceTypes);
+        case 304: return MatchedKeyword(data, n, TokenType::MemoryInstr, Opcode::I32Load8U);
+        case 307: return MatchedKeyword(data, n, TokenType::VarInstr, Opcode::LocalTee);
+        case 309: return MatchedKeyword(data, n, Opcode::I8X16Popcnt, Features::Simd);
+        case 310: return MatchedKeyword(data, n, Opcode::I64TruncSatF32S, Features::SaturatingFloatToInt);
+        case 312: return MatchedKeyword(data, n, TokenType::Do);
+        case 315: return MatchedKeyword(data, n, TokenType::MemoryInstr, Opcode::I32AtomicRmw8CmpxchgU, Features::Threads);
+        case 317: return MatchedKeyword(data, n, TokenType::Export);
+        case 318: return MatchedKeyword(data, n, Opcode::I16X8Bitmask, Features::Simd);
+        case 319: return MatchedKeyword(data, n, TokenType::MemoryInstr, Opcode::I64Load16S);
+        case 321: return MatchedKeyword(data, n, Opcode::I32LtU);
+        case 324: return MatchedKeyword(data, n, TokenType::RefNullInstr, Opcode::RefNull, Features::ReferenceTypes);
+        case 327: return MatchedKeyword(data, n, NumericType::V128);
+        case 328: return MatchedKeyword(data, n, Opcode::I32ShrS);
+        case 329: return MatchedKeyword(data, n, TokenType::MemoryInstr, Opcode::I32AtomicLoad, Features::Threads);
+        case 330: return MatchedKeyword(data, n, TokenType::MemoryOptInstr, Opcode::MemoryFill, Features::BulkMemory);
+        case 332: return MatchedKeyword(data, n, Opcode::I16X8ShrS, Features::Simd);
+        case 333: return MatchedKeyword(data, n, Opcode::I64ShrS);
+        case 334: return MatchedKeyword(data, n, TokenType::MemoryInstr, Opcode::I32AtomicRmwOr, Features::Threads);
+        case 335: return MatchedKeyword(data, n, TokenType::VarInstr, Opcode::LocalGet);
+        case 338: return MatchedKeyword(data, n, Opcode::I64X2ShrS, Features::Simd);
+        case 339: return MatchedKeyword(data, n, TokenType::MemoryInstr, Opcode::V128Load64Zero, Features::Simd);
+        case 340: return MatchedKeyword(data, n, Opcode::MemoryGrow);
+        case 341: return MatchedKeyword(data, n, Opcode::I32X4TruncSatF64X2UZero, Features::Simd);
+        case 342: return MatchedKeyword(data, n, TokenType::SimdLaneInstr, Opcode::F32X4ExtractLane, Features::Simd);
+        case 343: return MatchedKeyword(data, n, Opcode::I8X16ShrS, Features::Simd);
+        case 346: return MatchedKeyword(data, n, Opcode::I8X16SubSatU, Features::Simd);
+        case 347: return MatchedKeyword(data, n, Opcode::F32Lt);
+        case 348: return MatchedKeyword(data, n, Opcode::I16X8Q15mulrSatS, Features::Simd);
+        case 349: return MatchedKeyword(data, n, Opcode::F64Nearest);
+        case 350: return MatchedKeyword(data, n, Opcode::I32X4AllTrue, Features::Simd);
+        case 351: return MatchedKeyword(data, n, Opcode::I32Sub);
+        case 353: return MatchedKeyword(data, n, Opcode::I16X8ExtmulLowI8X16U, Features::Simd);
+        case 354: return MatchedKeyword(data, n, Opcode::I8X16NarrowI16X8S, Features::Simd);
+        case 355: return MatchedKeyword(data, n, TokenType::MemoryInstr, Opcode::I32AtomicRmw16SubU, Features::Threads);
+        case 356: return MatchedKeyword(data, n, Opcode::I32TruncF32U);
+        case 357: return MatchedKeyword(data, n, TokenType::MemoryInstr, Opcode::I32AtomicRmw16AndU, Features::Threads);
+        case 358: return MatchedKeyword(data, n, TokenType::FuncBindInstr, Opcode::FuncBind, Features::FunctionReferences);
+        case 360: return MatchedKeyword(data, n, TokenType::HeapType2Instr, Opcode::RefTest, Features::GC);
+        case 361: return MatchedKeyword(data, n, TokenType::VarInstr, Opcode::BrIf);
+        case 364: return MatchedKeyword(data, n, Opcode::I8X16MinU, Features::Simd);
+        case 365: return MatchedKeyword(data, n, Opcode::F64ConvertI64S);
+        case 366: return MatchedKeyword(data, n, PackedType::I8);
+        case 367: return MatchedKeyword(data, n, Opcode::I16X8ExtendLowI8X16S, Features::Simd);
+        case 373: return MatchedKeyword(data, n, TokenType::Local);
+        case 374: return MatchedKeyword(data, n, TokenType::Delegate, Opcode::Delegate, Features::Exceptions);
+        case 375: return MatchedKeyword(data, n, Opcode::F64X2Ge, Features::Simd);
+        case 376: return MatchedKeyword(data, n, TokenType::RefFuncInstr, Opcode::RefFunc, Features::ReferenceTypes);
+        case 377: return MatchedKeyword(data, n, Opcode::F32ConvertI64U);
+        case 379: return MatchedKeyword(data, n, TokenType::VarInstr, Opcode::Throw, Features::Exceptions);
+        case 380: return MatchedKeyword(data, n, Opcode::F32X4Gt, Features::Simd);
+        case 382: return MatchedKeyword(data, n, NumericType::I64);
+        case 383: return MatchedKeyword(data, n, Opcode::F64ConvertI32S);
+        case 384: return MatchedKeyword(data, n, Opcode::F64X2Nearest, Features::Simd);
+        case 386: return MatchedKeyword(data, n, TokenType::MemoryInstr, Opcode::V128Store, Features::Simd);
+        case 387: return MatchedKeyword(data, n, TokenType::MemoryInstr, Opcode::I32Load8S);
+        case 390: return MatchedKeyword(data, n, Opcode::I32TruncSatF64S, Features::SaturatingFloatToInt);
+        case 392: return MatchedKeyword(data, n, ReferenceKind::Eqref);
+        case 395: return MatchedKeyword(data, n, TokenType::MemoryInstr, Opcode::I64AtomicLoad, Features::Threads);
+        case 396: return MatchedKeyword(data, n, Opcode::I64ExtendI32U);
+        case 397: return MatchedKeyword(data, n, Opcode::I64ShrU);
+        case 398: return MatchedKeyword(data, n, TokenType::MemoryInstr, Opcode::I64Load);
+        case 400: return MatchedKeyword(data, n, TokenType::VarInstr, Opcode::DataDrop, Features::BulkMemory);
+        case 401: return MatchedKeyword(data, n, Opcode::F32X4Ne, Features::Simd);
+        case 403: return MatchedKeyword(data, n, TokenType::MemoryInstr, Opcode::I64AtomicRmw32AndU, Features::Threads);
+        case 404: return MatchedKeyword(data, n, Opcode::I32X4ExtendHighI16X8U, Features::Simd);
+        case 409: return MatchedKeyword(data, n, Opcode::F64X2ConvertLowI32X4S, Features::Simd);
+        case 411: return MatchedKeyword(data, n, TokenType::NanArithmetic);
+        case 413: return MatchedKeyword(data, n, SimdShape::I8X16);
+        case 414: return MatchedKeyword(data, n, TokenType::Func, HeapKind::Func);
+        case 415: return MatchedKeyword(data, n, Opcode::I64DivS);
+        case 416: return MatchedKeyword(data, n, Opcode::I8X16MaxS, Features::Simd);
+        case 418: return MatchedKeyword(data, n, Opcode::I8X16Sub, Features::Simd);
+        case 419: return MatchedKeyword(data, n, TokenType::MemoryInstr, Opcode::MemoryAtomicNotify, Features::Threads);
+        case 420: return MatchedKeyword(data, n, TokenType::VarInstr, Opcode::LocalSet);
+        case 421: return MatchedKeyword(data, n, Opcode::I64TruncSatF64U, Features::SaturatingFloatToInt);
+        case 422: return MatchedKeyword(data, n, Opcode::F64X2Abs, Features::Simd);
+        case 424: return MatchedKeyword(data, n, Opcode::I32DivU);
+        case 425: return MatchedKeyword(data, n, TokenType::MemoryInstr, Opcode::V128Load32X2U, Features::Simd);
+        case 428: return MatchedKeyword(data, n, TokenType::I64ConstInstr, Opcode::I64Const);
+        case 432: return MatchedKeyword(data, n, Opcode::I32X4DotI16X8S, Features::Simd);
+        case 433: return MatchedKeyword(data, n, TokenType::MemoryInstr, Opcode::I64AtomicRmw8XorU, Features::Threads);
+        case 434: return MatchedKeyword(data, n, TokenType::VarInstr, Opcode::ArrayNewWithRtt, Features::GC);
+        case 436: return MatchedKeyword(data, n, Opcode::I64X2Eq, Features::Simd);
+        case 437: return MatchedKeyword(data, n, TokenType::VarInstr, Opcode::GlobalGet);
+        case 438: return MatchedKeyword(data, n, Opcode::I31New, Features::GC);
+        case 439: return MatchedKeyword(data, n, Opcode::F64Le);
+        case 441: return MatchedKeyword(data, n, TokenType::MemoryInstr, Opcode::I32AtomicRmw8XorU, Features::Threads);
+        case 444: return MatchedKeyword(data, n, Opcode::Nop);
+        case 445: return MatchedKeyword(data, n, TokenType::VarInstr, Opcode::StructNewWithRtt, Features::GC);
+        case 446: return MatchedKeyword(data, n, Opcode::I32X4GeU, Features::Simd);
+        case 449: return MatchedKeyword(data, n, TokenType::SimdLaneInstr, Opcode::I8X16ExtractLaneU, Features::Simd);
+        case 450: return MatchedKeyword(data, n, TokenType::VarInstr, Opcode::ArrayGet, Features::GC);
+        case 451: return MatchedKeyword(data, n, Opcode::I64TruncSatF64S, Features::SaturatingFloatToInt);
+        case 453: return MatchedKeyword(data, n, Opcode::F32Ceil);
+        case 454: return MatchedKeyword(data, n, Opcode::I64Ne);
+        case 456: return MatchedKeyword(data, n, Opcode::I8X16GeS, Features::Simd);
+        case 457: return MatchedKeyword(data, n, Opcode::F32X4DemoteF64X2Zero, Features::Simd);
+        case 458: return MatchedKeyword(data, n, Opcode::I32TruncSatF64U, Features::SaturatingFloatToInt);
+        case 459: return MatchedKeyword(data, n, Opcode::I32RemU);
+        case 461: return MatchedKeyword(data, n, Opcode::I32X4GeS, Features::Simd);
+        case 463: return MatchedKeyword(data, n, Opcode::I64ReinterpretF64);
+        case 467: return MatchedKeyword(data, n, TokenType::NanCanonical);
+        case 468: return MatchedKeyword(data, n, TokenType::MemoryInstr, Opcode::I32Load);
+        case 469: return MatchedKeyword(data, n, Opcode::F64X2Gt, Features::Simd);
+        case 471: return MatchedKeyword(data, n, Opcode::I32GtS);
+        case 472: return MatchedKeyword(data, n, Opcode::I32Or);
+        case 475: return MatchedKeyword(data, n, TokenType::SimdLaneInstr, Opcode::F32X4ReplaceLane, Features::Simd);
+        case 476: return MatchedKeyword(data, n, TokenType::VarInstr, Opcode::TableSize, Features::ReferenceTypes);
+        case 477: return MatchedKeyword(data, n, TokenType::MemoryInstr, Opcode::MemoryAtomicWait32, Features::Threads);
+        case 478: return MatchedKeyword(data, n, TokenType::MemoryInstr, Opcode::I32AtomicRmw16AddU, Features::Threads);
+        case 481: return MatchedKeyword(data, n, TokenType::BrTableInstr, Opcode::BrTable);
+        case 482: return MatchedKeyword(data, n, TokenType::MemoryInstr, Opcode::I32AtomicRmw8SubU, Features::Threads);
+        case 483: return MatchedKeyword(data, n, TokenType::VarInstr, Opcode::ReturnCall, Features::TailCall);
+        case 484: return MatchedKeyword(data, n, TokenType::MemoryInstr, Opcode::I64AtomicRmwAdd, Features::Threads);
+        case 487: return MatchedKeyword(data, n, Opcode::I16X8Sub, Features::Simd);
+        case 488: return MatchedKeyword(data, n, TokenType::Start);
+        case 489: return MatchedKeyword(data, n, Opcode::I8X16LeU, Features::Simd);
+        case 490: return MatchedKeyword(data, n, Opcode::F32X4ConvertI32X4S, Features::Simd);
+        case 491: return MatchedKeyword(data, n, Opcode::I64LtS);
+        case 492: return MatchedKeyword(data, n, Opcode::I16X8Neg, Features::Simd);
+        case 493: return MatchedKeyword(data, n, Opcode::I64X2GeS, Features::Simd);
+        case 494: return MatchedKeyword(data, n, Opcode::I8X16LeS, Features::Simd);
+        case 499: return MatchedKeyword(data, n, Opcode::F64Ceil);
+        case 501: return MatchedKeyword(data, n, SimdShape::F64X2);
+        case 502: return MatchedKeyword(data, n, Opcode::F64PromoteF32);
+        case 503: return MatchedKeyword(data, n, Opcode::I8X16GeU, Features::Simd);
+        case 504: return MatchedKeyword(data, n, TokenType::Tag);
+        case 505: return MatchedKeyword(data, n, Opcode::I32Xor);
+        case 506: return MatchedKeyword(data, n, Opcode::I64ReinterpretF64);
+        case 507: return MatchedKeyword(data, n, Opcode::I64DivU);
+        case 508: return MatchedKeyword(data, n, Opcode::F32ConvertI32U);
+        case 509: return MatchedKeyword(data, n, Opcode::RefIsNull, Features::ReferenceTypes);
+        case 510: return MatchedKeyword(data, n, Opcode::I32Eq);
+        case 511: return MatchedKeyword(data, n, TokenType::VarInstr, Opcode::ArrayGetU, Features::GC);
+        case 513: return MatchedKeyword(data, n, Opcode::I32X4Eq, Features::Simd);
+        case 514: return MatchedKeyword(data, n, TokenType::MemoryInstr, Opcode::I32Store16);
+        case 516: return MatchedKeyword(data, n, Opcode::I8X16AllTrue, Features::Simd);
+        case 518: return MatchedKeyword(data, n, TokenType::MemoryInstr, Opcode::I64AtomicLoad32U, Features::Threads);
+        case 519: return MatchedKeyword(data, n, TokenType::MemoryInstr, Opcode::I64AtomicRmwXor, Features::Threads);
+        case 520: return MatchedKeyword(data, n, Opcode::I64X2LtS, Features::Simd);
+        case 522: return MatchedKeyword(data, n, TokenType::Param);
+        case 523: return MatchedKeyword(data, n, Opcode::I32X4TruncSatF64X2SZero, Features::Simd);
+        case 524: return MatchedKeyword(data, n, SimdShape::I64X2);
+        case 525: return LexNan(data);
+        case 526: return MatchedKeyword(data, n, Opcode::I64X2Ne, Features::Simd);
+        case 527: return MatchedKeyword(data, n, Opcode::F64X2Splat, Features::Simd);
+        case 529: return MatchedKeyword(data, n, TokenType::MemoryInstr, Opcode::V128Load16X4S, Features::Simd);
+        case 530: return MatchedKeyword(data, n, TokenType::RttSubInstr, Opcode::RttSub, Features::GC);
+        case 534: return MatchedKeyword(data, n, Opcode::V128Xor, Features::Simd);
+        case 536: return MatchedKeyword(data, n, Opcode::I64RemU);
+        case 537: return MatchedKeyword(data, n, TokenType::MemoryInstr, Opcode::I64Load32S);
+        case 538: return MatchedKeyword(data, n, TokenType::Table);
+        case 539: return MatchedKeyword(data, n, TokenType::AssertUnlinkable);
+        case 540: return MatchedKeyword(data, n, TokenType::TableCopyInstr, Opcode::TableCopy, Features::BulkMemory);
+        case 541: return MatchedKeyword(data, n, SimdShape::F32X4);
+        case 543: return MatchedKeyword(data, n, Opcode::F64ConvertI64U);
+        case 548: return MatchedKeyword(data, n, Opcode::F32Add);
+        case 549: return MatchedKeyword(data, n, Opcode::I32WrapI64);
+        case 551: return MatchedKeyword(data, n, Opcode::I8X16Ne, Features::Simd);
+        case 552: return MatchedKeyword(data, n, Opcode::Unreachable);
+        case 554: return MatchedKeyword(data, n, TokenType::SimdLaneInstr, Opcode::F64X2ReplaceLane, Features::Simd);
+        case 557: return MatchedKeyword(data, n, Opcode::F64X2Pmin, Features::Simd);
+        case 559: return MatchedKeyword(data, n, NumericType::F32);
+        case 561: return MatchedKeyword(data, n, TokenType::SelectInstr, Opcode::Select);
+        case 562: return MatchedKeyword(data, n, TokenType::VarInstr, Opcode::StructNewDefaultWithRtt, Features::GC);
+        case 564: return MatchedKeyword(data, n, Opcode::I32TruncF32S);
+        case 565: return MatchedKeyword(data, n, Opcode::F32X4Div, Features::Simd);
+        case 566: return MatchedKeyword(data, n, Opcode::I8X16AddSatS, Features::Simd);
+        case 568: return MatchedKeyword(data, n, TokenType::SimdShuffleInstr, Opcode::I8X16Shuffle, Features::Simd);
+        case 570: return MatchedKeyword(data, n, Opcode::I32Eqz);
+        case 575: return MatchedKeyword(data, n, Opcode::I32X4GtS, Features::Simd);
+        case 576: return MatchedKeyword(data, n, Opcode::I16X8ExtendHighI8X16S, Features::Simd);
+        case 577: return MatchedKeyword(data, n, Opcode::I32LtS);
+        case 578: return MatchedKeyword(data, n, TokenType::MemoryInstr, Opcode::I64AtomicStore, Features::Threads);
+        case 579: return MatchedKeyword(data, n, TokenType::BrOnCastInstr, Opcode::BrOnCast, Features::GC);
+        case 580: return MatchedKeyword(data, n, TokenType::MemoryInstr, Opcode::I64AtomicRmw32CmpxchgU, Features::Threads);
+        case 581: return MatchedKeyword(data, n, TokenType::CallIndirectInstr, Opcode::ReturnCallIndirect, Features::TailCall);
+        case 582: return MatchedKeyword(data, n, ReferenceKind::Funcref);
+        case 584: return MatchedKeyword(data, n, Opcode::I32X4ExtendHighI16X8S, Features::Simd);
+        case 585: return MatchedKeyword(data, n, Opcode::F32X4Sqrt, Features::Simd);
+        case 586: return MatchedKeyword(data, n, Opcode::F64X2Sqrt, Features::Simd);
+        case 587: return MatchedKeyword(data, n, Opcode::V128Or,  Features::Simd);
+        case 588: return MatchedKeyword(data, n, Opcode::I32Clz);
+        case 589: return MatchedKeyword(data, n, Opcode::I32X4Sub, Features::Simd);
+        case 591: return MatchedKeyword(data, n, Opcode::F32ConvertI64S);
+        case 592: return MatchedKeyword(data, n, Opcode::F32Max);
+        case 593: return MatchedKeyword(data, n, TokenType::VarInstr, Opcode::ArrayNewDefaultWithRtt, Features::GC);
+        case 595: return MatchedKeyword(data, n, Opcode::I64X2ExtmulLowI32X4U, Features::Simd);
+        case 596: return MatchedKeyword(data, n, Opcode::I64Add);
+        case 597: return MatchedKeyword(data, n, Opcode::F64Floor);
+        case 598: return MatchedKeyword(data, n, Opcode::I16X8MinU, Features::Simd);
+        case 599: return MatchedKeyword(data, n, Opcode::I64Extend8S, Features::SignExtension);
+        case 600: return MatchedKeyword(data, n, Opcode::I64LeS);
+        case 603: return MatchedKeyword(data, n, Opcode::I32X4ExtmulHighI16X8U, Features::Simd);
+        case 604: return MatchedKeyword(data, n, Opcode::F32ConvertI64S);
+        case 605: return MatchedKeyword(data, n, Opcode::I8X16GtS, Features::Simd);
+        case 606: return MatchedKeyword(data, n, Opcode::I32TruncSatF64S, Features::SaturatingFloatToInt);
+        case 607: return MatchedKeyword(data, n, Opcode::I32WrapI64);
+        case 608: return MatchedKeyword(data, n, Opcode::I16X8GtU, Features::Simd);
+        case 609: return MatchedKeyword(data, n, Opcode::I64TruncF32U);
+        case 611: return MatchedKeyword(data, n, TokenType::MemoryInstr, Opcode::I64AtomicRmw16AddU, Features::Threads);
+        case 612: return MatchedKeyword(data, n, Opcode::F32Copysign);
+        case 613: return MatchedKeyword(data, n, TokenType::MemoryInstr, Opcode::I32AtomicRmwXor, Features::Threads);
+        case 614: return MatchedKeyword(data, n, TokenType::Ref);
+        case 617: return MatchedKeyword(data, n, Opcode::I32TruncF32S);
+        case 618: return MatchedKeyword(data, n, Opcode::I8X16Neg, Features::Simd);
+        case 620: return MatchedKeyword(data, n, TokenType::MemoryInstr, Opcode::I32AtomicRmw16OrU, Features::Threads);
+        case 622: return MatchedKeyword(data, n, TokenType::MemoryInstr, Opcode::V128Load8Splat, Features::Simd);
+        case 623: return MatchedKeyword(data, n, Opcode::F64Neg);
+        case 629: return MatchedKeyword(data, n, TokenType::MemoryInstr, Opcode::I64AtomicRmw8SubU, Features::Threads);
+        case 630: return MatchedKeyword(data, n, Opcode::F32X4Sub, Features::Simd);
+        case 631: return MatchedKeyword(data, n, Opcode::F32ConvertI32U);
+        case 632: return MatchedKeyword(data, n, Opcode::F32Div);
+        case 633: return MatchedKeyword(data, n, TokenType::MemoryInstr, Opcode::I64AtomicStore8, Features::Threads);
+        case 634: return MatchedKeyword(data, n, Opcode::I8X16AddSatU, Features::Simd);
+        case 635: return MatchedKeyword(data, n, Opcode::I16X8AllTrue, Features::Simd);
+        case 636: return MatchedKeyword(data, n, ReferenceKind::Funcref);
+        case 638: return MatchedKeyword(data, n, TokenType::VarInstr, Opcode::GlobalSet);
+        case 639: return MatchedKeyword(data, n, Opcode::I8X16SubSatS, Features::Simd);
+        case 641: return MatchedKeyword(data, n, Opcode::I64Sub);
+        case 642: return MatchedKeyword(data, n, Opcode::I16X8AvgrU, Features::Simd);
+        case 644: return MatchedKeyword(data, n, Opcode::I32TruncSatF32S, Features::SaturatingFloatToInt);
+        case 645: return MatchedKeyword(data, n, Opcode::I16X8Ne, Features::Simd);
+        case 646: return MatchedKeyword(data, n, Opcode::I64X2ExtendHighI32X4S, Features::Simd);
+        case 647: return MatchedKeyword(data, n, Opcode::I32X4ExtmulLowI16X8S, Features::Simd);
+        case 648: return MatchedKeyword(data, n, Opcode::I32X4Neg, Features::Simd);
+        case 649: return MatchedKeyword(data, n, Opcode::I16X8ExtmulLowI8X16S, Features::Simd);
+        case 650: return MatchedKeyword(data, n, Opcode::F32X4Add, Features::Simd);
+        case 651: return MatchedKeyword(data, n, Opcode::V128BitSelect, Features::Simd);
+        case 652: return MatchedKeyword(data, n, Opcode::I64Rotl);
+        case 653: return MatchedKeyword(data, n, Opcode::F32Sub);
+        case 654: return MatchedKeyword(data, n, TokenType::VarInstr, Opcode::ArraySet, Features::GC);
+        case 656: return MatchedKeyword(data, n, Opcode::F32X4Le, Features::Simd);
+        case 658: return MatchedKeyword(data, n, TokenType::HeapKind, HeapKind::Extern);
+        case 660: return MatchedKeyword(data, n, TokenType::MemoryInstr, Opcode::I32AtomicRmwAnd, Features::Threads);
+        case 663: return MatchedKeyword(data, n, TokenType::Global);
+        case 667: return MatchedKeyword(data, n, TokenType::Module);
+        case 670: return MatchedKeyword(data, n, Opcode::I64GeU);
+        case 671: return MatchedKeyword(data, n, Opcode::F64Abs);
+        case 674: return MatchedKeyword(data, n, Opcode::CallRef, Features::FunctionReferences);
+        case 675: return MatchedKeyword(data, n, Opcode::I32X4Bitmask, Features::Simd);
+        case 677: return MatchedKeyword(data, n, TokenType::Quote);
+        case 679: return MatchedKeyword(data, n, TokenType::MemoryInstr, Opcode::I64AtomicStore32, Features::Threads);
+        case 680: return MatchedKeyword(data, n, TokenType::Elem);
+        case 681: return MatchedKeyword(data, n, Opcode::I32X4ExtmulHighI16X8S, Features::Simd);
+        case 683: return MatchedKeyword(data, n, Opcode::I32X4LtS, Features::Simd);
+        case 686: return MatchedKeyword(data, n, Opcode::I8X16Add, Features::Simd);
+        case 689: return MatchedKeyword(data, n, Opcode::I32X4LtU, Features::Simd);
+        case 690: return MatchedKeyword(data, n, TokenType::VarInstr, Opcode::TableSet, Features::ReferenceTypes);
+        case 691: return MatchedKeyword(data, n, Opcode::I64ExtendI32S);
+        case 693: return MatchedKeyword(data, n, TokenType::MemoryInstr, Opcode::I32AtomicRmw8AndU, Features::Threads);
+        case 694: return MatchedKeyword(data, n, TokenType::MemoryInstr, Opcode::I64AtomicLoad16U, Features::Threads);
+        case 695: return MatchedKeyword(data, n, TokenType::SimdLaneInstr, Opcode::I16X8ReplaceLane, Features::Simd);
+        case 697: return MatchedKeyword(data, n, TokenType::Rtt);
+        case 699: return MatchedKeyword(data, n, TokenType::RefExtern);
+        case 700: return MatchedKeyword(data, n, Opcode::V128AnyTrue, Features::Simd);
+        case 703: return MatchedKeyword(data, n, TokenType::MemoryInstr, Opcode::I64AtomicRmw16SubU, Features::Threads);
+        case 705: return MatchedKeyword(data, n, TokenType::MemoryInstr, Opcode::I64AtomicRmw8CmpxchgU, Features::Threads);
+        case 708: return MatchedKeyword(data, n, Opcode::I32DivS);
+        case 709: return MatchedKeyword(data, n, Opcode::I16X8Shl, Features::Simd);
+        case 710: return MatchedKeyword(data, n, TokenType::MemoryInstr, Opcode::I32AtomicLoad8U, Features::Threads);
+        case 711: return MatchedKeyword(data, n, TokenType::SimdLaneInstr, Opcode::F64X2ExtractLane, Features::Simd);
+        case 712: return MatchedKeyword(data, n, Opcode::I64Rotr);
+        case 713: return MatchedKeyword(data, n, TokenType::Import);
+        case 714: return MatchedKeyword(data, n, TokenType::VarInstr, Opcode::Br);
+        case 715: return MatchedKeyword(data, n, Opcode::F64X2Le, Features::Simd);
+        case 716: return MatchedKeyword(data, n, TokenType::MemoryInstr, Opcode::I64AtomicLoad8U, Features::Threads);
+        case 721: return MatchedKeyword(data, n, TokenType::SimdLaneInstr, Opcode::I64X2ReplaceLane, Features::Simd);
+        case 722: return MatchedKeyword(data, n, SimdShape::I16X8);
+        case 726: return MatchedKeyword(data, n, TokenType::VarInstr, Opcode::TableGet, Features::ReferenceTypes);
+        case 727: return MatchedKeyword(data, n, Opcode::I8X16Swizzle, Features::Simd);
+        case 728: return MatchedKeyword(data, n, Opcode::I16X8LeU, Features::Simd);
+        case 729: return MatchedKeyword(data, n, TokenType::BlockInstr, Opcode::Try, Features::Exceptions);
+        case 730: return MatchedKeyword(data, n, Opcode::I32Popcnt);
+        case 731: return MatchedKeyword(data, n, Opcode::I64TruncF32S);
+        case 733: return MatchedKeyword(data, n, Opcode::I64TruncF32S);
+        case 734: return MatchedKeyword(data, n, Opcode::F32X4Ceil, Features::Simd);
+        case 736: return MatchedKeyword(data, n, ReferenceKind::Anyref);
+        case 738: return MatchedKeyword(data, n, TokenType::VarInstr, Opcode::LocalSet);
+        case 739: return MatchedKeyword(data, n, Opcode::F32Gt);
+        case 741: return MatchedKeyword(data, n, TokenType::MemoryInstr, Opcode::I64AtomicRmw8XchgU, Features::Threads);
+        case 742: return MatchedKeyword(data, n, TokenType::Array);
+        case 743: return MatchedKeyword(data, n, Opcode::F32Neg);
+        case 745: return MatchedKeyword(data, n, TokenType::MemoryInstr, Opcode::MemoryAtomicWait64, Features::Threads);
+        case 748: return MatchedKeyword(data, n, TokenType::VarInstr, Opcode::TableFill, Features::ReferenceTypes);
+        case 750: return MatchedKeyword(data, n, Opcode::F32Ge);
+        case 752: return MatchedKeyword(data, n, TokenType::AssertTrap);
+        case 753: return MatchedKeyword(data, n, Opcode::I32X4ExtaddPairwiseI16X8S, Features::Simd);
+        case 754: return MatchedKeyword(data, n, TokenType::MemoryInstr, Opcode::V128Load, Features::Simd);
+        case 756: return MatchedKeyword(data, n, Opcode::I32X4Shl, Features::Simd);
+        case 757: return MatchedKeyword(data, n, Opcode::F32Abs);
+        case 758: return MatchedKeyword(data, n, Opcode::F32X4Pmin, Features::Simd);
+        case 759: return MatchedKeyword(data, n, TokenType::MemoryInstr, Opcode::V128Load32Zero, Features::Simd);
+        case 761: return MatchedKeyword(data, n, Opcode::F32X4Ge, Features::Simd);
+        case 763: return MatchedKeyword(data, n, Opcode::F64Gt);
+        case 764: return MatchedKeyword(data, n, Opcode::I8X16MaxU, Features::Simd);
+        case 768: return MatchedKeyword(data, n, Opcode::I32TruncSatF32S, Features::SaturatingFloatToInt);
+        case 769: return MatchedKeyword(data, n, Opcode::I32ShrU);
+        case 771: return MatchedKeyword(data, n, Opcode::ReturnCallRef, Features::FunctionReferences);
+        case 774: return MatchedKeyword(data, n, Opcode::I32X4Ne, Features::Simd);
+        case 776: return MatchedKeyword(data, n, TokenType::StructFieldInstr, Opcode::StructGetS, Features::GC);
+        case 777: return MatchedKeyword(data, n, TokenType::VarInstr, Opcode::BrOnNonNull, Features::FunctionReferences);
+        case 778: return MatchedKeyword(data, n, TokenType::MemoryInstr, Opcode::I64AtomicRmw16OrU, Features::Threads);
+        case 779: return MatchedKeyword(data, n, TokenType::SimdConstInstr, Opcode::V128Const, Features::Simd);
+        case 781: return MatchedKeyword(data, n, Opcode::I32Shl);
+        case 784: return MatchedKeyword(data, n, Opcode::I32Ctz);
+        case 786: return MatchedKeyword(data, n, Opcode::F64Copysign);
+        case 787: return MatchedKeyword(data, n, TokenType::MemoryInstr, Opcode::F32Load);
+        case 788: return MatchedKeyword(data, n, TokenType::Binary);
+        case 791: return MatchedKeyword(data, n, Opcode::I8X16LtU, Features::Simd);
+        case 792: return MatchedKeyword(data, n, TokenType::MemoryInstr, Opcode::I64AtomicRmw16CmpxchgU, Features::Threads);
+        case 793: return MatchedKeyword(data, n, TokenType::BlockInstr, Opcode::Loop);
+        case 795: return MatchedKeyword(data, n, Opcode::F32Nearest);
+        case 801: return MatchedKeyword(data, n, Opcode::I8X16MinS, Features::Simd);
+        case 802: return MatchedKeyword(data, n, Opcode::F32ConvertI32S);
+        case 803: return MatchedKeyword(data, n, Opcode::I64Eq);
+        case 806: return MatchedKeyword(data, n, Opcode::I32X4ExtmulLowI16X8U, Features::Simd);
+        case 808: return MatchedKeyword(data, n, TokenType::MemoryInstr, Opcode::V128Load16Splat, Features::Simd);
+        case 810: return MatchedKeyword(data, n, Opcode::F64Lt);
+        case 812: return MatchedKeyword(data, n, TokenType::MemoryInstr, Opcode::I32AtomicRmw8OrU, Features::Threads);
+        case 814: return MatchedKeyword(data, n, Opcode::F64X2Neg, Features::Simd);
+        case 815: return MatchedKeyword(data, n, TokenType::MemoryInitInstr, Opcode::MemoryInit, Features::BulkMemory);
+        case 816: return MatchedKeyword(data, n, Opcode::F64X2ConvertLowI32X4U, Features::Simd);
+        case 817: return MatchedKeyword(data, n, TokenType::SimdMemoryLaneInstr, Opcode::V128Store64Lane, Features::Simd);
+        case 818: return MatchedKeyword(data, n, TokenType::MemoryInstr, Opcode::I64Load32U);
+        case 819: return MatchedKeyword(data, n, TokenType::SimdLaneInstr, Opcode::I16X8ExtractLaneU, Features::Simd);
+        case 820: return MatchedKeyword(data, n, Opcode::I32ReinterpretF32);
+        case 822: return MatchedKeyword(data, n, Opcode::I32Rotr);
+        case 824: return MatchedKeyword(data, n, Opcode::F64X2Max, Features::Simd);
+        case 825: return MatchedKeyword(data, n, Opcode::I64TruncF64S);
+        case 827: return MatchedKeyword(data, n, TokenType::HeapKind, HeapKind::I31);
+        case 829: return MatchedKeyword(data, n, Opcode::I16X8Abs, Features::Simd);
+        case 831: return MatchedKeyword(data, n, Opcode::I32X4ExtaddPairwiseI16X8U, Features::Simd);
+        case 832: return MatchedKeyword(data, n, Opcode::F32X4Max, Features::Simd);
+        case 833: return MatchedKeyword(data, n, TokenType::Float, LiteralKind::Infinity);
+        case 837: return MatchedKeyword(data, n, TokenType::Data);
+        case 838: return MatchedKeyword(data, n, Opcode::F32ConvertI32S);
+        case 839: return MatchedKeyword(data, n, Opcode::I64TruncF64U);
+        case 840: return MatchedKeyword(data, n, Opcode::I32GeS);
+        case 842: return MatchedKeyword(data, n, Opcode::F32X4ConvertI32X4U, Features::Simd);
+        case 843: return MatchedKeyword(data, n, Opcode::I64TruncF64S);
+        case 845: return MatchedKeyword(data, n, Opcode::F64X2Min, Features::Simd);
+        case 846: return MatchedKeyword(data, n, Opcode::I16X8MaxS, Features::Simd);
+        case 847: return MatchedKeyword(data, n, TokenType::VarInstr, Opcode::Rethrow, Features::Exceptions);
+        case 848: return MatchedKeyword(data, n, TokenType::AssertExhaustion);
+        case 849: return MatchedKeyword(data, n, Opcode::F64Add);
+        case 853: return MatchedKeyword(data, n, Opcode::F64Div);
+        case 855: return MatchedKeyword(data, n, Opcode::F32Floor);
+        case 856: return MatchedKeyword(data, n, TokenType::MemoryInstr, Opcode::I64AtomicRmw32XorU, Features::Threads);
+        case 857: return MatchedKeyword(data, n, Opcode::F32Ne);
+        case 859: return MatchedKeyword(data, n, TokenType::MemoryInstr, Opcode::I32Load16S);
+        case 860: return MatchedKeyword(data, n, Opcode::I64X2Mul, Features::Simd);
+        case 861: return MatchedKeyword(data, n, Opcode::F64Sub);
+        case 863: return MatchedKeyword(data, n, Opcode::I16X8ExtaddPairwiseI8X16U, Features::Simd);
+        case 864: return MatchedKeyword(data, n, TokenType::MemoryInstr, Opcode::I64AtomicRmwAnd, Features::Threads);
+        case 865: return MatchedKeyword(data, n, Opcode::I32TruncF64S);
+        case 866: return MatchedKeyword(data, n, Opcode::F32X4Pmax, Features::Simd);
+        case 867: return MatchedKeyword(data, n, TokenType::VarInstr, Opcode::ArrayLen, Features::GC);
+        case 868: return MatchedKeyword(data, n, Opcode::I64X2ExtendHighI32X4U, Features::Simd);
+        case 869: return MatchedKeyword(data, n, Opcode::F64X2Pmax, Features::Simd);
+        case 870: return MatchedKeyword(data, n, Opcode::F64Ge);
+        case 871: return MatchedKeyword(data, n, Opcode::I32X4MaxS, Features::Simd);
+        case 872: return MatchedKeyword(data, n, TokenType::VarInstr, Opcode::Call);
+        case 875: return MatchedKeyword(data, n, Opcode::I16X8AddSatU, Features::Simd);
+        case 878: return MatchedKeyword(data, n, Opcode::I64X2Abs, Features::Simd);
+        case 879: return MatchedKeyword(data, n, Opcode::I64Extend32S, Features::SignExtension);
+        case 880: return MatchedKeyword(data, n, TokenType::Declare);
+        case 881: return MatchedKeyword(data, n, TokenType::HeapTypeInstr, Opcode::RttCanon, Features::GC);
+        case 883: return MatchedKeyword(data, n, Opcode::I32TruncSatF32U, Features::SaturatingFloatToInt);
+        case 884: return MatchedKeyword(data, n, Opcode::F64X2PromoteLowF32X4, Features::Simd);
+        case 885: return MatchedKeyword(data, n, Opcode::I16X8GtS, Features::Simd);
+        case 886: return MatchedKeyword(data, n, Opcode::I64Shl);
+        case 887: return MatchedKeyword(data, n, TokenType::VarInstr, Opcode::GlobalGet);
+        case 888: return MatchedKeyword(data, n, Opcode::F64Eq);
+        case 889: return MatchedKeyword(data, n, Opcode::I64Or);
+        case 890: return MatchedKeyword(data, n, TokenType::HeapKind, HeapKind::Eq);
+        case 891: return MatchedKeyword(data, n, Opcode::F32Mul);
+        case 895: return MatchedKeyword(data, n, TokenType::Invoke);
+        case 897: return MatchedKeyword(data, n, Opcode::F32Sqrt);
+        case 898: return MatchedKeyword(data, n, Opcode::I16X8SubSatS, Features::Simd);
+        case 901: return MatchedKeyword(data, n, TokenType::StructFieldInstr, Opcode::StructGet, Features::GC);
+        case 902: return MatchedKeyword(data, n, Opcode::I64X2Sub, Features::Simd);
+        case 903: return MatchedKeyword(data, n, Opcode::I16X8GeS, Features::Simd);
+        case 904: return MatchedKeyword(data, n, TokenType::MemoryInstr, Opcode::I32Store8);
+        case 905: return MatchedKeyword(data, n, Opcode::I64X2ExtmulLowI32X4S, Features::Simd);
+        case 908: return MatchedKeyword(data, n, TokenType::BlockInstr, Opcode::Block);
+        case 909: return MatchedKeyword(data, n, TokenType::MemoryInstr, Opcode::I32AtomicRmwXchg, Features::Threads);
+        case 912: return MatchedKeyword(data, n, Opcode::I32X4GtU, Features::Simd);
+        case 913: return MatchedKeyword(data, n, PackedType::I16);
+        case 916: return MatchedKeyword(data, n, Opcode::I16X8MaxU, Features::Simd);
+        case 917: return MatchedKeyword(data, n, Opcode::I32TruncSatF32U, Features::SaturatingFloatToInt);
+        case 918: return MatchedKeyword(data, n, TokenType::SimdMemoryLaneInstr, Opcode::V128Load32Lane, Features::Simd);
+        case 920: return MatchedKeyword(data, n, TokenType::Offset);
+        case 921: return MatchedKeyword(data, n, Opcode::I32LeU);
+        case 923: return MatchedKeyword(data, n, Opcode::F32ConvertI64U);
+        case 924: return MatchedKeyword(data, n, TokenType::MemoryInstr, Opcode::I64Store32);
+        case 926: return MatchedKeyword(data, n, Opcode::I32GtU);
+        case 929: return MatchedKeyword(data, n, Opcode::I64X2Bitmask, Features::Simd);
+        case 931: return MatchedKeyword(data, n, Opcode::F64X2Add, Features::Simd);
+        case 932: return MatchedKeyword(data, n, Opcode::I32LeS);
+        case 935: return MatchedKeyword(data, n, Opcode::I32Rotl);
+        case 936: return MatchedKeyword(data, n, Opcode::I64GeS);
+        case 937: return MatchedKeyword(data, n, Opcode::F32X4Eq, Features::Simd);
+        case 938: return MatchedKeyword(data, n, TokenType::MemoryInstr, Opcode::I32AtomicRmw16XchgU, Features::Threads);
+        case 939: return MatchedKeyword(data, n, Opcode::I32GeU);
+        case 940: return MatchedKeyword(data, n, Opcode::I16X8GeU, Features::Simd);
+        case 941: return MatchedKeyword(data, n, Opcode::I32X4LeS, Features::Simd);
+        case 942: return MatchedKeyword(data, n, TokenType::MemoryInstr, Opcode::I64AtomicRmwSub, Features::Threads);
+        case 945: return MatchedKeyword(data, n, TokenType::MemoryInstr, Opcode::I64AtomicRmw16XchgU, Features::Threads);
+        case 949: return MatchedKeyword(data, n, TokenType::MemoryInstr, Opcode::I64AtomicRmw32XchgU, Features::Threads);
+        case 950: return MatchedKeyword(data, n, TokenType::MemoryInstr, Opcode::I64Load16U);
+        case 951: return MatchedKeyword(data, n, TokenType::MemoryInstr, Opcode::I32Load16U);
+        case 953: return MatchedKeyword(data, n, TokenType::StructFieldInstr, Opcode::StructSet, Features::GC);
+        case 955: return MatchedKeyword(data, n, TokenType::MemoryInstr, Opcode::V128Load16X4U, Features::Simd);
+        case 958: return MatchedKeyword(data, n, TokenType::MemoryInstr, Opcode::I32AtomicRmwSub, Features::Threads);
+        case 959: return LexNameEqNum(data, "align=", TokenType::AlignEqNat);
+        case 960: return MatchedKeyword(data, n, Opcode::F64ConvertI64U);
+        case 961: return MatchedKeyword(data, n, Opcode::I16X8LeS, Features::Simd);
+        case 962: return MatchedKeyword(data, n, Opcode::I64GtU);
+        case 963: return MatchedKeyword(data, n, TokenType::MemoryInstr, Opcode::I32AtomicStore8, Features::Threads);
+        case 964: return MatchedKeyword(data, n, TokenType::MemoryInstr, Opcode::I32AtomicRmwAdd, Features::Threads);
+        case 965: return MatchedKeyword(data, n, TokenType::SimdLaneInstr, Opcode::I8X16ExtractLaneS, Features::Simd);
+        case 970: return MatchedKeyword(data, n, TokenType::LetInstr, Opcode::Let, Features::FunctionReferences);
+        case 971: return MatchedKeyword(data, n, Opcode::I64X2LeS, Features::Simd);
+        case 973: return MatchedKeyword(data, n, Opcode::I32Add);
+        case 976: return MatchedKeyword(data, n, Opcode::I64TruncSatF64S, Features::SaturatingFloatToInt);
+        case 977: return MatchedKeyword(data, n, TokenType::Get);
+        case 978: return MatchedKeyword(data, n, Opcode::Drop);
+        case 979: return MatchedKeyword(data, n, Opcode::I32Extend8S, Features::SignExtension);
+        case 980: return MatchedKeyword(data, n, Opcode::I16X8Add, Features::Simd);
+        case 982: return MatchedKeyword(data, n, TokenType::MemoryInstr, Opcode::I32AtomicLoad16U, Features::Threads);
+        case 983: return MatchedKeyword(data, n, TokenType::MemoryInstr, Opcode::I32Store);
+        case 985: return MatchedKeyword(data, n, Opcode::I64And);
+        case 987: return MatchedKeyword(data, n, Opcode::F64Max);
+        case 990: return MatchedKeyword(data, n, Opcode::F32Eq);
+        case 992: return MatchedKeyword(data, n, Opcode::I8X16LtS, Features::Simd);
+        case 993: return MatchedKeyword(data, n, Opcode::I64TruncSatF64U, Features::SaturatingFloatToInt);
+        case 996: return MatchedKeyword(data, n, Opcode::I32X4Splat, Features::Simd);
+        case 999: return MatchedKeyword(data, n, Opcode::F32X4Abs, Features::Simd);
+        case 1000: return MatchedKeyword(data, n, Opcode::I32X4Abs, Features::Simd);
+        case 1001: return MatchedKeyword(data, n, Opcode::I32X4Add, Features::Simd);
+        case 1003: return MatchedKeyword(data, n, Opcode::I64TruncSatF32S, Features::SaturatingFloatToInt);
+        case 1004: return MatchedKeyword(data, n, Opcode::F64Min);
+        case 1005: return MatchedKeyword(data, n, Opcode::F64X2Ceil, Features::Simd);
+        case 1006: return MatchedKeyword(data, n, Opcode::I32ReinterpretF32);
+        case 1007: return MatchedKeyword(data, n, Opcode::F64Trunc);
+        case 1013: return MatchedKeyword(data, n, TokenType::CatchAll, Opcode::CatchAll, Features::Exceptions);
+        case 1017: return MatchedKeyword(data, n, TokenType::MemoryInstr, Opcode::V128Load8X8U, Features::Simd);
+        case 1019: return MatchedKeyword(data, n, Opcode::I32TruncF64S);
+        case 1020: return MatchedKeyword(data, n, TokenType::BlockInstr, Opcode::If);
+        case 1021: return MatchedKeyword(data, n, TokenType::MemoryInstr, Opcode::I64AtomicRmw8OrU, Features::Threads);
+        case 1022: return MatchedKeyword(data, n, TokenType::AssertMalformed);
+        default: break;
+      }
+    }
+  }
+  if (n > 6 && HasPrefix(data, "align=")) {
+    return LexNameEqNum(data, "align=", TokenType::AlignEqNat);
+  }
+  if (n > 6 && HasPrefix(data, "nan:0x")) {
+    return LexNan(data);
+  }
+  if (n > 7 && HasPrefix(data, "offset=")) {
+    return LexNameEqNum(data, "offset=", TokenType::OffsetEqNat);
+  }
+}
+break;
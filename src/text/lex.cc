@@ -16,8 +16,24 @@
 
 #include "wasp/text/read/lex.h"
 
+#include <algorithm>
 #include <cassert>
 
+#if defined(__SSE2__) || defined(_M_X64) || \
+    (defined(_M_IX86_FP) && _M_IX86_FP >= 2)
+#define WASP_LEX_SSE2 1
+#include <emmintrin.h>
+#else
+#define WASP_LEX_SSE2 0
+#endif
+
+#if defined(_MSC_VER)
+#include <intrin.h>
+#endif
+
+#include "wasp/base/macros.h"
+#include "wasp/base/utf8.h"
+
 namespace wasp::text {
 
 namespace {
@@ -70,6 +86,77 @@ bool IsDigit(int c) { return IsCharClass(c, CharClass::Digit); }
 bool IsHexDigit(int c) { return IsCharClass(c, CharClass::HexDigit); }
 bool IsReserved(int c) { return IsCharClass(c, CharClass::Reserved); }
 
+// The scanners below find the end of long runs of characters (whitespace,
+// comments and text) 16 bytes at a time, where SSE2 is available. SSE2 is part
+// of the x86-64 baseline, so this needs no runtime dispatch.
+
+#if WASP_LEX_SSE2
+
+// Returns the index of the lowest set bit. `x` must be non-zero.
+inline int CountTrailingZeroes(u32 x) {
+#if defined(_MSC_VER)
+  unsigned long index;
+  _BitScanForward(&index, x);
+  return static_cast<int>(index);
+#else
+  return __builtin_ctz(x);
+#endif
+}
+
+// Returns a mask with bit `i` set if byte `i` of `v` is one of `Cs`.
+template <char... Cs>
+u32 MatchMask(__m128i v) {
+  __m128i match = _mm_setzero_si128();
+  ((match = _mm_or_si128(match, _mm_cmpeq_epi8(v, _mm_set1_epi8(Cs)))), ...);
+  return static_cast<u32>(_mm_movemask_epi8(match));
+}
+
+#endif  // WASP_LEX_SSE2
+
+// Returns a pointer to the first byte in [p, end) that is one of `Cs`, or
+// `end` if there is none.
+template <char... Cs>
+const u8* FindFirstOf(const u8* p, const u8* end) {
+#if WASP_LEX_SSE2
+  for (; end - p >= 16; p += 16) {
+    auto v = _mm_loadu_si128(reinterpret_cast<const __m128i*>(p));
+    if (u32 mask = MatchMask<Cs...>(v)) {
+      return p + CountTrailingZeroes(mask);
+    }
+  }
+#endif
+  for (; p != end; ++p) {
+    if (((*p == static_cast<u8>(Cs)) || ...)) {
+      return p;
+    }
+  }
+  return end;
+}
+
+// Returns a pointer to the first byte in [p, end) that isn't one of `Cs`, or
+// `end` if there is none.
+template <char... Cs>
+const u8* FindFirstNotOf(const u8* p, const u8* end) {
+#if WASP_LEX_SSE2
+  for (; end - p >= 16; p += 16) {
+    auto v = _mm_loadu_si128(reinterpret_cast<const __m128i*>(p));
+    if (u32 mask = MatchMask<Cs...>(v) ^ 0xffff) {
+      return p + CountTrailingZeroes(mask);
+    }
+  }
+#endif
+  for (; p != end; ++p) {
+    if (!((*p == static_cast<u8>(Cs)) || ...)) {
+      return p;
+    }
+  }
+  return end;
+}
+
+void SkipTo(SpanU8* data, const u8* p) {
+  data->remove_prefix(p - data->begin());
+}
+
 auto PeekChar(SpanU8* data, span_extent_t offset = 0) -> int {
   if (offset >= data->size()) {
     return -1;
@@ -182,6 +269,7 @@ auto LexBlockComment(SpanU8* data) -> Token {
   MatchGuard guard{data};
   int nesting = 0;
   while (true) {
+    SkipTo(data, FindFirstOf<';', '('>(data->begin(), data->end()));
     switch (ReadChar(data)) {
       case -1:
         return Token(guard.loc(), TokenType::InvalidBlockComment);
@@ -214,16 +302,11 @@ auto LexId(SpanU8* data) -> Token {
 
 auto LexLineComment(SpanU8* data) -> Token {
   MatchGuard guard{data};
-  while (true) {
-    switch (ReadChar(data)) {
-      case -1:
-        return Token(guard.loc(), TokenType::InvalidLineComment);
-
-      case '\n':
-        return Token(guard.loc(), TokenType::LineComment);
-      default: break;
-    }
+  SkipTo(data, FindFirstOf<'\n'>(data->begin(), data->end()));
+  if (ReadChar(data) == -1) {
+    return Token(guard.loc(), TokenType::InvalidLineComment);
   }
+  return Token(guard.loc(), TokenType::LineComment);
 }
 
 auto LexNameEqNum(SpanU8* data, string_view sv, TokenType tt) -> Token {
@@ -249,7 +332,7 @@ auto LexInf(SpanU8* data) -> Token {
   if (MatchString(data, "inf") && NoTrailingReservedChars(data)) {
     return Token(guard.loc(), TokenType::Float, LiteralInfo::Infinity(sign));
   }
-  return LexReserved(data);
+  return LexReserved(guard.Reset());
 }
 
 auto LexNan(SpanU8* data) -> Token {
@@ -267,7 +350,7 @@ auto LexNan(SpanU8* data) -> Token {
       return Token(guard.loc(), TokenType::Float, LiteralInfo::Nan(sign));
     }
   }
-  return LexReserved(data);
+  return LexReserved(guard.Reset());
 }
 
 auto LexNumber(SpanU8* data, TokenType tt) -> Token {
@@ -321,13 +404,33 @@ auto LexHexNumber(SpanU8* data, TokenType tt) -> Token {
   return LexReserved(guard.Reset());
 }
 
+int HexDigitValue(int c) {
+  assert(IsHexDigit(c));
+  return IsDigit(c) ? c - '0' : (c | 0x20) - 'a' + 10;
+}
+
 auto LexText(SpanU8* data) -> Token {
   MatchGuard guard{data};
   MatchChar(data, '"');
   bool has_error = false;
   bool in_string = true;
   u32 byte_size = 0;
+
+  // A text without escapes is validated all at once at the end. Otherwise the
+  // unescaped runs and the decoded escapes are appended to a checker.
+  auto has_escapes = HasEscapes::No;
+  Utf8Checker utf8;
+  const u8* run_begin = data->begin();
+  const u8* run_end = run_begin;
+  auto append_run = [&](const u8* end) {
+    utf8.Append(ToStringView(MakeSpan(run_begin, end)));
+  };
+
   while (in_string) {
+    // Skip to the next character that needs attention.
+    const u8* pos = FindFirstOf<'"', '\\', '\n'>(data->begin(), data->end());
+    byte_size += static_cast<u32>(pos - data->begin());
+    SkipTo(data, pos);
     switch (ReadChar(data)) {
       case -1:
         has_error = true;
@@ -340,17 +443,23 @@ auto LexText(SpanU8* data) -> Token {
 
       case '"':
         in_string = false;
+        run_end = pos;
         break;
 
-      case '\\':
-        switch (ReadChar(data)) {
+      case '\\': {
+        has_escapes = HasEscapes::Yes;
+        append_run(pos);
+        int c = ReadChar(data);
+        switch (c) {
           case 't':
           case 'n':
           case 'r':
           case '"':
           case '\'':
           case '\\':
-            // Valid escape.
+            // Valid escape. These all decode to ASCII characters, which the
+            // checker treats alike.
+            utf8.Append(static_cast<u8>(c));
             byte_size++;
             break;
 
@@ -377,7 +486,8 @@ auto LexText(SpanU8* data) -> Token {
           case 'E':
           case 'F':  // Hex byte escape.
             if (IsHexDigit(PeekChar(data))) {
-              SkipChar(data);
+              utf8.Append(static_cast<u8>(HexDigitValue(c) << 4 |
+                                          HexDigitValue(ReadChar(data))));
               byte_size++;
               break;
             }
@@ -387,11 +497,12 @@ auto LexText(SpanU8* data) -> Token {
             has_error = true;
             break;
         }
+        run_begin = data->begin();
         break;
+      }
 
       default:
-        byte_size++;
-        break;
+        WASP_UNREACHABLE();
     }
   }
 
@@ -400,109 +511,129 @@ auto LexText(SpanU8* data) -> Token {
     return Token(loc, TokenType::InvalidText);
   }
 
-  return Token(loc, TokenType::Text, Text{ToStringView(loc), byte_size});
+  bool is_valid_utf8;
+  if (has_escapes == HasEscapes::Yes) {
+    append_run(run_end);
+    is_valid_utf8 = utf8.IsValid();
+  } else {
+    is_valid_utf8 = IsValidUtf8(ToStringView(MakeSpan(run_begin, run_end)));
+  }
+
+  return Token(loc, TokenType::Text,
+               Text{ToStringView(loc), byte_size, has_escapes,
+                    is_valid_utf8 ? Utf8Validity::Valid
+                                  : Utf8Validity::Invalid});
 }
 
 auto LexWhitespace(SpanU8* data) -> Token {
   MatchGuard guard{data};
-  while (true) {
-    switch (PeekChar(data)) {
-      case ' ':
-      case '\t':
-      case '\r':
-        SkipChar(data);
-        break;
-
-      case '\n':
-        SkipChar(data);
-        break;
+  SkipTo(data,
+         FindFirstNotOf<' ', '\t', '\r', '\n'>(data->begin(), data->end()));
+  return Token(guard.loc(), TokenType::Whitespace);
+}
 
-      default:
-        return Token(guard.loc(), TokenType::Whitespace);
-    }
-  }
+// The token for a keyword at `loc`, once it has been matched.
+auto KeywordToken(Location loc, TokenType tt) -> Token {
+  return Token(loc, tt);
 }
 
-auto LexKeyword(SpanU8* data, string_view sv, TokenType tt) -> Token {
-  MatchGuard guard{data};
-  if (MatchString(data, sv) && NoTrailingReservedChars(data)) {
-    return Token(guard.loc(), tt);
-  }
-  return LexReserved(guard.Reset());
+auto KeywordToken(Location loc, Opcode o, Features::Bits f = 0) -> Token {
+  return Token(loc, TokenType::BareInstr, OpcodeInfo{o, Features{f}});
 }
 
-auto LexKeyword(SpanU8* data, string_view sv, Opcode o, Features::Bits f = 0)
+auto KeywordToken(Location loc, TokenType tt, Opcode o, Features::Bits f = 0)
     -> Token {
-  MatchGuard guard{data};
-  if (MatchString(data, sv) && NoTrailingReservedChars(data)) {
-    return Token(guard.loc(), TokenType::BareInstr, OpcodeInfo{o, Features{f}});
-  }
-  return LexReserved(guard.Reset());
+  return Token(loc, tt, OpcodeInfo{o, Features{f}});
 }
 
-auto LexKeyword(SpanU8* data,
-                string_view sv,
-                TokenType tt,
-                Opcode o,
-                Features::Bits f = 0) -> Token {
-  MatchGuard guard{data};
-  if (MatchString(data, sv) && NoTrailingReservedChars(data)) {
-    return Token(guard.loc(), tt, OpcodeInfo{o, Features{f}});
-  }
-  return LexReserved(guard.Reset());
+auto KeywordToken(Location loc, NumericType nt) -> Token {
+  return Token(loc, TokenType::NumericType, nt);
 }
 
-auto LexKeyword(SpanU8* data, string_view sv, NumericType nt) -> Token {
-  MatchGuard guard{data};
-  if (MatchString(data, sv) && NoTrailingReservedChars(data)) {
-    return Token(guard.loc(), TokenType::NumericType, nt);
-  }
-  return LexReserved(guard.Reset());
+auto KeywordToken(Location loc, ReferenceKind rk) -> Token {
+  return Token(loc, TokenType::ReferenceKind, rk);
 }
 
-auto LexKeyword(SpanU8* data, string_view sv, ReferenceKind rk) -> Token {
-  MatchGuard guard{data};
-  if (MatchString(data, sv) && NoTrailingReservedChars(data)) {
-    return Token(guard.loc(), TokenType::ReferenceKind, rk);
-  }
-  return LexReserved(guard.Reset());
+auto KeywordToken(Location loc, TokenType tt, HeapKind hk) -> Token {
+  return Token(loc, tt, hk);
 }
 
-auto LexKeyword(SpanU8* data, string_view sv, TokenType tt, HeapKind hk)
-    -> Token {
+auto KeywordToken(Location loc, PackedType pt) -> Token {
+  return Token(loc, TokenType::PackedType, pt);
+}
+
+auto KeywordToken(Location loc, TokenType tt, LiteralKind lk) -> Token {
+  return Token(loc, tt, LiteralInfo{lk});
+}
+
+auto KeywordToken(Location loc, SimdShape ss) -> Token {
+  return Token(loc, TokenType::SimdShape, ss);
+}
+
+template <typename... Args>
+auto LexKeyword(SpanU8* data, string_view sv, Args... args) -> Token {
   MatchGuard guard{data};
   if (MatchString(data, sv) && NoTrailingReservedChars(data)) {
-    return Token(guard.loc(), tt, hk);
+    return KeywordToken(guard.loc(), args...);
   }
   return LexReserved(guard.Reset());
 }
 
-auto LexKeyword(SpanU8* data, string_view sv, PackedType pt) -> Token {
-  MatchGuard guard{data};
-  if (MatchString(data, sv) && NoTrailingReservedChars(data)) {
-    return Token(guard.loc(), TokenType::PackedType, pt);
+#if WASP_PERFECT_HASH_KEYWORDS
+
+// Used by keywords-hash-inl.cc.
+
+// The number of reserved characters at the start of `data`. A keyword must
+// span all of them.
+span_extent_t CountReservedChars(SpanU8* data) {
+  span_extent_t n = 0;
+  while (n < data->size() && IsReserved((*data)[n])) {
+    ++n;
   }
-  return LexReserved(guard.Reset());
+  return n;
 }
 
-auto LexKeyword(SpanU8* data, string_view sv, TokenType tt, LiteralKind lk)
-    -> Token {
-  MatchGuard guard{data};
-  if (MatchString(data, sv) && NoTrailingReservedChars(data)) {
-    return Token(guard.loc(), tt, LiteralInfo{lk});
+// Loads 8 bytes in little-endian order, keeping only the first `n`.
+u64 LoadKeywordWord(const u8* p, span_extent_t n) {
+  u64 word = 0;
+  for (int i = 0; i < 8; ++i) {
+    word |= u64{p[i]} << (i * 8);
   }
-  return LexReserved(guard.Reset());
+  return n >= 8 ? word : word & ((u64{1} << (n * 8)) - 1);
 }
 
-auto LexKeyword(SpanU8* data, string_view sv, SimdShape ss)
-    -> Token {
-  MatchGuard guard{data};
-  if (MatchString(data, sv) && NoTrailingReservedChars(data)) {
-    return Token(guard.loc(), TokenType::SimdShape, ss);
+// Hashes the first `n` bytes of `data`, using the length, the first 16 bytes
+// and (when longer) the last 8 bytes. That is enough to tell all keywords
+// apart. Must match Hash in gen-keywords.py.
+u32 HashKeyword(SpanU8* data, span_extent_t n) {
+  const u8* p = data->data();
+  u8 padded[16] = {};
+  if (data->size() < sizeof(padded)) {
+    std::copy(data->begin(), data->end(), padded);
+    p = padded;
   }
-  return LexReserved(guard.Reset());
+  u64 w0 = LoadKeywordWord(p, n);
+  u64 w1 = n > 8 ? LoadKeywordWord(p + 8, n - 8) : 0;
+  u64 w2 = n > 16 ? LoadKeywordWord(p + n - 8, 8) : 0;
+  u64 x = (n * 0x9e3779b97f4a7c15ull) ^ (w0 * 0xc2b2ae3d27d4eb4full) ^
+          (w1 * 0x165667b19e3779f9ull) ^ (w2 * 0x27d4eb2f165667c5ull);
+  return static_cast<u32>(((x ^ (x >> 32)) * 0x9e3779b97f4a7c15ull) >> 32);
 }
 
+bool HasPrefix(SpanU8* data, string_view sv) {
+  return ToStringView(*data).substr(0, sv.size()) == sv;
+}
+
+// The token for the keyword that spans the first `n` bytes of `data`.
+template <typename... Args>
+auto MatchedKeyword(SpanU8* data, span_extent_t n, Args... args) -> Token {
+  Location loc = data->first(n);
+  data->remove_prefix(n);
+  return KeywordToken(loc, args...);
+}
+
+#endif  // WASP_PERFECT_HASH_KEYWORDS
+
 }  // namespace
 
 auto Lex(SpanU8* data) -> Token {
@@ -594,7 +725,11 @@ auto Lex(SpanU8* data) -> Token {
       return LexId(data);
 
     default:
+#if WASP_PERFECT_HASH_KEYWORDS
+#include "src/text/keywords-hash-inl.cc"
+#else
 #include "src/text/keywords-inl.cc"
+#endif
   }
   if (IsReserved(PeekChar(data))) {
     return LexReserved(data);
@@ -16,7 +16,9 @@
 
 #include "wasp/text/read/name_map.h"
 
+#include <algorithm>
 #include <cassert>
+
 #include "wasp/base/macros.h"
 
 namespace wasp::text {
@@ -25,16 +27,26 @@ NameMap::NameMap() : stack_{0} {}
 
 void NameMap::Reset() {
   names_.clear();
+  shadowed_.clear();
+  innermost_.clear();
   stack_ = {0};
 }
 
 void NameMap::NewUnbound() {
   names_.push_back(nullopt);
+  shadowed_.push_back(kNone);
 }
 
 bool NameMap::NewBound(BindVar var) {
-  if (HasSinceLastPush(var)) {
-    return false;
+  auto [iter, inserted] = innermost_.emplace(var, names_.size());
+  if (!inserted) {
+    if (iter->second >= stack_.back()) {
+      return false;  // Already bound in this scope.
+    }
+    shadowed_.push_back(iter->second);
+    iter->second = names_.size();
+  } else {
+    shadowed_.push_back(kNone);
   }
   names_.push_back(var);
   return true;
@@ -46,43 +58,52 @@ void NameMap::Push() {
 
 void NameMap::Pop() {
   assert(stack_.size() > 1);
+  // Unbind the names in the innermost scope, restoring any they shadowed.
+  for (size_t i = names_.size(); i > stack_.back(); --i) {
+    auto&& opt_name = names_[i - 1];
+    if (opt_name) {
+      if (shadowed_[i - 1] == kNone) {
+        innermost_.erase(*opt_name);
+      } else {
+        innermost_[*opt_name] = shadowed_[i - 1];
+      }
+    }
+  }
   names_.resize(stack_.back());
+  shadowed_.resize(stack_.back());
   stack_.pop_back();
 }
 
 bool NameMap::Has(BindVar var) const {
-  return FindInRange(0, names_.size(), var).has_value();
+  return Find(var).has_value();
 }
 
 bool NameMap::HasSinceLastPush(BindVar var) const {
-  return FindInRange(stack_.back(), names_.size(), var).has_value();
+  auto found = Find(var);
+  return found && *found >= stack_.back();
 }
 
-optional<size_t> NameMap::FindInRange(size_t begin,
-                                      size_t end,
-                                      BindVar var) const {
-  for (size_t i = begin; i < end; ++i) {
-    auto&& opt_name = names_[i];
-    if (opt_name && opt_name == var) {
-      return i;
-    }
+optional<size_t> NameMap::Find(BindVar var) const {
+  auto iter = innermost_.find(var);
+  if (iter == innermost_.end()) {
+    return nullopt;
   }
-  return nullopt;
+  return iter->second;
 }
 
 optional<Index> NameMap::Get(BindVar var) const {
-  Index offset = 0;
-  size_t end = names_.size();
-  for (auto iter = stack_.rbegin(); iter != stack_.rend(); ++iter) {
-    size_t begin = *iter;
-    auto found = FindInRange(begin, end, var);
-    if (found) {
-      return offset + static_cast<Index>(*found - begin);
-    }
-    offset += static_cast<Index>(end - begin);
-    end = begin;
+  auto found = Find(var);
+  if (!found) {
+    return nullopt;
   }
-  return nullopt;
+
+  // Scopes are numbered from the outside in, but indexes count from the
+  // innermost scope outward. The name is in the last scope that begins at or
+  // before it; everything in the scopes after that one comes first.
+  auto scope = std::upper_bound(stack_.begin(), stack_.end(), *found) - 1;
+  size_t begin = *scope;
+  size_t end = scope + 1 == stack_.end() ? names_.size() : *(scope + 1);
+  return static_cast<Index>((names_.size() - end) + (*found - begin));
 }
 
 auto NameMap::Size() const -> Index {
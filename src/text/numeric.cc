@@ -15,3 +15,446 @@
 //
 
 #include "wasp/text/numeric.h"
+
+#include <cmath>
+
+#if defined(_MSC_VER)
+#include <intrin.h>
+#endif
+
+#include "absl/strings/numbers.h"
+
+#include "wasp/base/buffer.h"
+
+namespace wasp::text {
+
+namespace {
+
+// Float literals are parsed in place, skipping underscores as they go.
+// Decimal literals use the Eisel-Lemire algorithm, see "Number Parsing at a
+// Gigabyte per Second" (Lemire, 2021). In the rare case where the result
+// can't be determined from the first 19 digits, they fall back to Abseil's
+// parser on a copy of the literal. Hex literals are always exact, so they are
+// rounded directly.
+
+struct U128 {
+  u64 high;
+  u64 low;
+};
+
+U128 Multiply(u64 a, u64 b) {
+#if defined(__SIZEOF_INT128__)
+  unsigned __int128 result = static_cast<unsigned __int128>(a) * b;
+  return {static_cast<u64>(result >> 64), static_cast<u64>(result)};
+#else
+  u64 a_lo = a & 0xffff'ffff, a_hi = a >> 32;
+  u64 b_lo = b & 0xffff'ffff, b_hi = b >> 32;
+  u64 lo_lo = a_lo * b_lo;
+  u64 hi_lo = a_hi * b_lo;
+  u64 lo_hi = a_lo * b_hi;
+  u64 hi_hi = a_hi * b_hi;
+  u64 cross = (lo_lo >> 32) + (hi_lo & 0xffff'ffff) + lo_hi;
+  return {hi_hi + (hi_lo >> 32) + (cross >> 32),
+          (cross << 32) | (lo_lo & 0xffff'ffff)};
+#endif
+}
+
+// Returns the number of leading zero bits. `x` must be non-zero.
+int CountLeadingZeroes(u64 x) {
+#if defined(_MSC_VER)
+  unsigned long index;
+  _BitScanReverse64(&index, x);
+  return 63 - static_cast<int>(index);
+#else
+  return __builtin_clzll(x);
+#endif
+}
+
+constexpr int kMinPowerOfFive = -342;
+constexpr int kMaxPowerOfFive = 308;
+
+// 5^q for q in [kMinPowerOfFive, kMaxPowerOfFive], as 128-bit values with the
+// top bit set; {high, low}.
+constexpr u64 kPowersOfFive[][2] = {
+#include "src/text/powers-of-five-inl.cc"
+};
+
+static_assert(sizeof(kPowersOfFive) / sizeof(kPowersOfFive[0]) ==
+                  kMaxPowerOfFive - kMinPowerOfFive + 1,
+              "powers-of-five-inl.cc is out of date");
+
+// The Eisel-Lemire parameters for each float type, in addition to those in
+// FloatTraits.
+template <typename T>
+struct DecimalTraits {};
+
+template <>
+struct DecimalTraits<f32> {
+  // Any value w * 10^q, w < 10^19, is zero below this power and infinite
+  // above this one.
+  static constexpr int min_power_of_ten = -65;
+  static constexpr int max_power_of_ten = 38;
+  // Only these powers can produce a value exactly halfway between two floats.
+  static constexpr int min_round_to_even = -17;
+  static constexpr int max_round_to_even = 10;
+  // w * 10^q is correctly rounded by a single float operation when both are
+  // exact.
+  static constexpr u64 max_fast_mantissa = u64{1} << 24;
+  static constexpr int max_fast_power = 10;
+  static constexpr f32 powers_of_ten[] = {1e0f, 1e1f, 1e2f, 1e3f,
+                                          1e4f, 1e5f, 1e6f, 1e7f,
+                                          1e8f, 1e9f, 1e10f};
+};
+
+template <>
+struct DecimalTraits<f64> {
+  // See the comments in DecimalTraits<f32> above.
+  static constexpr int min_power_of_ten = -342;
+  static constexpr int max_power_of_ten = 308;
+  static constexpr int min_round_to_even = -4;
+  static constexpr int max_round_to_even = 23;
+  static constexpr u64 max_fast_mantissa = u64{1} << 53;
+  static constexpr int max_fast_power = 22;
+  static constexpr f64 powers_of_ten[] = {
+      1e0,  1e1,  1e2,  1e3,  1e4,  1e5,  1e6,  1e7,  1e8,  1e9,  1e10, 1e11,
+      1e12, 1e13, 1e14, 1e15, 1e16, 1e17, 1e18, 1e19, 1e20, 1e21, 1e22};
+};
+
+// A float as a biased exponent and a significand without its implicit bit.
+struct BinaryFloat {
+  u64 significand;
+  int exp;
+
+  bool operator==(const BinaryFloat& rhs) const {
+    return significand == rhs.significand && exp == rhs.exp;
+  }
+};
+
+template <typename T>
+auto ToFloat(bool negative, BinaryFloat f) -> T {
+  using Traits = FloatTraits<T>;
+  using Int = typename Traits::Int;
+  Int bits = (Int(f.exp) << Traits::exp_shift) | Int(f.significand);
+  if (negative) {
+    bits |= Traits::signbit;
+  }
+  return Bitcast<T>(bits);
+}
+
+template <typename T>
+auto MakeZero(bool negative) -> T {
+  return ToFloat<T>(negative, BinaryFloat{0, 0});
+}
+
+// Rounds w * 10^q to the nearest float, ties to even. Returns an infinite
+// exponent when the result overflows.
+template <typename T>
+auto EiselLemire(s64 q, u64 w) -> BinaryFloat {
+  using Traits = FloatTraits<T>;
+  using DTraits = DecimalTraits<T>;
+  constexpr int mantissa_bits = Traits::exp_shift;
+  constexpr int infinite_exp = Traits::exp_bias + Traits::exp_max;
+
+  if (w == 0 || q < DTraits::min_power_of_ten) {
+    return {0, 0};
+  }
+  if (q > DTraits::max_power_of_ten) {
+    return {0, infinite_exp};
+  }
+
+  int lz = CountLeadingZeroes(w);
+  w <<= lz;
+
+  // Only the top mantissa_bits + 3 bits of the product are needed: the
+  // implicit bit, a rounding bit and one bit that may be shifted out below.
+  // The second half of the power is only needed if those bits may still
+  // change.
+  const u64* power = kPowersOfFive[q - kMinPowerOfFive];
+  U128 product = Multiply(w, power[0]);
+  constexpr u64 precision_mask = ~u64{0} >> (mantissa_bits + 3);
+  if ((product.high & precision_mask) == precision_mask) {
+    U128 second = Multiply(w, power[1]);
+    product.low += second.high;
+    if (second.high > product.low) {
+      ++product.high;
+    }
+  }
+
+  int upper_bit = static_cast<int>(product.high >> 63);
+  int shift = upper_bit + 64 - mantissa_bits - 3;
+  BinaryFloat result;
+  result.significand = product.high >> shift;
+  // floor(q * log2(10)) + 63, plus the bias.
+  result.exp = static_cast<int>(((217706 * q) >> 16) + 63 + upper_bit - lz +
+                                Traits::exp_bias);
+
+  if (result.exp <= 0) {
+    // Subnormal, or zero. Ties can't happen here.
+    if (-result.exp + 1 >= 64) {
+      return {0, 0};
+    }
+    result.significand >>= -result.exp + 1;
+    result.significand += result.significand & 1;
+    result.significand >>= 1;
+    // Rounding up may produce the smallest normal value.
+    result.exp = result.significand < (u64{1} << mantissa_bits) ? 0 : 1;
+    result.significand &= ~(u64{1} << mantissa_bits);
+    return result;
+  }
+
+  // Round up, unless the value is exactly halfway and the significand is
+  // already even.
+  if (product.low <= 1 && q >= DTraits::min_round_to_even &&
+      q <= DTraits::max_round_to_even && (result.significand & 3) == 1 &&
+      (result.significand << shift) == product.high) {
+    result.significand &= ~u64{1};
+  }
+  result.significand += result.significand & 1;
+  result.significand >>= 1;
+  if (result.significand >= (u64{2} << mantissa_bits)) {
+    result.significand = u64{1} << mantissa_bits;
+    ++result.exp;
+  }
+  result.significand &= ~(u64{1} << mantissa_bits);
+  if (result.exp >= infinite_exp) {
+    return {0, infinite_exp};
+  }
+  return result;
+}
+
+// Parses the exponent after 'e' or 'p', which may have a sign and
+// underscores. Large exponents are clamped; the result is out of range or
+// zero either way.
+s64 ParseExponent(const u8* p, const u8* end) {
+  constexpr s64 kMaxExponent = 1 << 20;
+  bool negative = false;
+  if (p != end && (*p == '+' || *p == '-')) {
+    negative = *p == '-';
+    ++p;
+  }
+  s64 value = 0;
+  for (; p != end; ++p) {
+    if (*p != '_' && value < kMaxExponent) {
+      value = value * 10 + (*p - '0');
+    }
+  }
+  return negative ? -value : value;
+}
+
+template <typename T>
+auto SimpleAto(const char* str, T* value) -> bool;
+
+template <>
+auto SimpleAto<f32>(const char* str, f32* value) -> bool {
+  // Abseil's float conversions will silently convert large values into `inf`,
+  // which is not allowed by the Wasm text format. This function will only be
+  // used for normal values, so we know that if an `inf` is returned it is
+  // invalid.
+  return absl::SimpleAtof(str, value) && !std::isinf(*value);
+}
+
+template <>
+auto SimpleAto<f64>(const char* str, f64* value) -> bool {
+  // See the comment in SimpleAto<f32> above.
+  return absl::SimpleAtod(str, value) && !std::isinf(*value);
+}
+
+template <typename T>
+auto ParseFloatSlow(SpanU8 span) -> optional<T> {
+  Buffer buffer;
+  std::copy_if(span.begin(), span.end(), std::back_inserter(buffer),
+               [](u8 c) { return c != '_'; });
+  buffer.push_back(0);  // Always need to copy, to null-terminate.
+  T value;
+  if (!SimpleAto(reinterpret_cast<const char*>(buffer.data()), &value)) {
+    return nullopt;
+  }
+  return value;
+}
+
+template <typename T>
+auto ParseDecimalFloat(SpanU8 span, bool negative, const u8* p, const u8* end)
+    -> optional<T> {
+  using DTraits = DecimalTraits<T>;
+
+  // Read the literal as w * 10^q, keeping the first 19 significant digits of
+  // w, since those always fit in a u64.
+  constexpr int kMaxDigits = 19;
+  u64 w = 0;
+  int digits = 0;
+  s64 q = 0;
+  bool truncated = false;
+  for (; p != end && *p != '.' && (*p | 0x20) != 'e'; ++p) {
+    if (*p == '_') {
+      continue;
+    }
+    u32 digit = *p - '0';
+    if (digits < kMaxDigits) {
+      w = w * 10 + digit;
+      digits += w != 0;
+    } else {
+      truncated |= digit != 0;
+      ++q;
+    }
+  }
+  if (p != end && *p == '.') {
+    for (++p; p != end && (*p | 0x20) != 'e'; ++p) {
+      if (*p == '_') {
+        continue;
+      }
+      u32 digit = *p - '0';
+      if (digits < kMaxDigits) {
+        w = w * 10 + digit;
+        digits += w != 0;
+        --q;
+      } else {
+        truncated |= digit != 0;
+      }
+    }
+  }
+  if (p != end) {
+    q += ParseExponent(p + 1, end);
+  }
+
+  if (w == 0) {
+    return MakeZero<T>(negative);
+  }
+
+  if (!truncated && w <= DTraits::max_fast_mantissa &&
+      q >= -DTraits::max_fast_power && q <= DTraits::max_fast_power) {
+    T value = static_cast<T>(w);
+    if (q < 0) {
+      value /= DTraits::powers_of_ten[-q];
+    } else {
+      value *= DTraits::powers_of_ten[q];
+    }
+    return negative ? -value : value;
+  }
+
+  auto result = EiselLemire<T>(q, w);
+  if (truncated && !(result == EiselLemire<T>(q, w + 1))) {
+    // The dropped digits decide the rounding.
+    return ParseFloatSlow<T>(span);
+  }
+  if (result.exp == FloatTraits<T>::exp_bias + FloatTraits<T>::exp_max) {
+    return nullopt;
+  }
+  return ToFloat<T>(negative, result);
+}
+
+// Without branches, since hex digits are about as likely to be letters as
+// numbers: 'a'-'f' and 'A'-'F' have bit 6 set and low bits 1-6.
+u32 HexDigitToValue(u8 c) {
+  return (c & 0xf) + 9 * (c >> 6);
+}
+
+template <typename T>
+auto ParseHexFloat(bool negative, const u8* p, const u8* end) -> optional<T> {
+  using Traits = FloatTraits<T>;
+  using Int = typename Traits::Int;
+
+  // Read the literal as significand * 2^exp, keeping the first 61 to 64
+  // significant bits. `sticky` is set if any bit after those is set.
+  u64 significand = 0;
+  s64 exp = 0;
+  bool sticky = false;
+  for (; p != end && *p != '.' && (*p | 0x20) != 'p'; ++p) {
+    if (*p == '_') {
+      continue;
+    }
+    if (significand >> 60 == 0) {
+      significand = significand * 16 + HexDigitToValue(*p);
+    } else {
+      sticky |= *p != '0';
+      exp += 4;
+    }
+  }
+  if (p != end && *p == '.') {
+    for (++p; p != end && (*p | 0x20) != 'p'; ++p) {
+      if (*p == '_') {
+        continue;
+      }
+      if (significand >> 60 == 0) {
+        significand = significand * 16 + HexDigitToValue(*p);
+        exp -= 4;
+      } else {
+        sticky |= *p != '0';
+      }
+    }
+  }
+  if (p != end) {
+    exp += ParseExponent(p + 1, end);
+  }
+
+  if (significand == 0) {
+    return MakeZero<T>(negative);
+  }
+
+  // Normalize so the top bit is set; the value is then 1.f * 2^(exp + 63).
+  int lz = CountLeadingZeroes(significand);
+  significand <<= lz;
+  s64 biased_exp = exp - lz + 63 + Traits::exp_bias;
+  if (biased_exp >= Traits::exp_bias + Traits::exp_max) {
+    return nullopt;
+  }
+
+  // Keep the top exp_shift + 1 bits, or fewer for subnormals, and round the
+  // rest to nearest, ties to even.
+  constexpr int kBits = Traits::exp_shift + 1;
+  int shift = 64 - kBits;
+  if (biased_exp < 1) {
+    if (1 - biased_exp > kBits) {
+      return MakeZero<T>(negative);
+    }
+    shift += static_cast<int>(1 - biased_exp);
+    biased_exp = 0;
+  }
+  u64 kept = shift == 64 ? 0 : significand >> shift;
+  u64 rest = shift == 64 ? significand
+                         : significand & ((u64{1} << shift) - 1);
+  u64 half = u64{1} << (shift - 1);
+  if (rest > half || (rest == half && (sticky || (kept & 1)))) {
+    ++kept;
+  }
+
+  // `kept` includes the implicit bit, so adding it bumps the exponent field
+  // by one. This also handles rounding up to the next power of two.
+  Int bits = (biased_exp > 0 ? Int(biased_exp - 1) << Traits::exp_shift : 0) +
+             Int(kept);
+  if (bits >= Traits::exp_mask) {
+    return nullopt;
+  }
+  if (negative) {
+    bits |= Traits::signbit;
+  }
+  return Bitcast<T>(bits);
+}
+
+template <typename T>
+auto ParseFloatImpl(SpanU8 span) -> optional<T> {
+  const u8* p = span.data();
+  const u8* end = p + span.size();
+  bool negative = false;
+  if (p != end && (*p == '+' || *p == '-')) {
+    negative = *p == '-';
+    ++p;
+  }
+  if (end - p > 2 && p[0] == '0' && (p[1] | 0x20) == 'x') {
+    return ParseHexFloat<T>(negative, p + 2, end);
+  }
+  return ParseDecimalFloat<T>(span, negative, p, end);
+}
+
+}  // namespace
+
+template <>
+auto ParseFloat<f32>(SpanU8 span) -> optional<f32> {
+  return ParseFloatImpl<f32>(span);
+}
+
+template <>
+auto ParseFloat<f64>(SpanU8 span) -> optional<f64> {
+  return ParseFloatImpl<f64>(span);
+}
+
+}  // namespace wasp::text
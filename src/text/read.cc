@@ -200,8 +200,10 @@ auto ReadText(Tokenizer& tokenizer, ReadCtx& ctx) -> OptAt<Text> {
 
 auto ReadUtf8Text(Tokenizer& tokenizer, ReadCtx& ctx) -> OptAt<Text> {
   WASP_TRY_READ(text, ReadText(tokenizer, ctx));
-  // TODO: The lexer could validate utf-8 while reading characters.
-  if (!IsValidUtf8(text->ToString())) {
+  bool is_valid = text->utf8 == Utf8Validity::Unknown
+                      ? IsValidUtf8(text->ToString())
+                      : text->utf8 == Utf8Validity::Valid;
+  if (!is_valid) {
     ctx.errors.OnError(text.loc(), "Invalid UTF-8 encoding");
     return nullopt;
   }
@@ -85,28 +85,33 @@ auto ResolveCtx::GetFieldNameMap(Index index) -> NameMap* {
 void FunctionTypeMap::BeginModule() {
   list_.clear();
   deferred_list_.clear();
+  index_.Clear();
+  deferred_index_.Clear();
 }
 
 void FunctionTypeMap::Define(BoundFunctionType bound_type) {
   list_.push_back(ToFunctionType(bound_type));
+  index_.Insert(list_, static_cast<Index>(list_.size() - 1));
 }
 
 void FunctionTypeMap::SkipIndex() {
   list_.push_back(nullopt);
+  index_.Insert(list_, static_cast<Index>(list_.size() - 1));
 }
 
 Index FunctionTypeMap::Use(FunctionType type) {
-  auto iter = FindIter(list_, type);
-  if (iter != list_.end()) {
-    return static_cast<Index>(iter - list_.begin());
+  auto hash = Hash(type);
+  if (auto index = index_.Find(list_, type, hash)) {
+    return *index;
   }
 
-  iter = FindIter(deferred_list_, type);
-  if (iter != deferred_list_.end()) {
-    return static_cast<Index>(list_.size() + (iter - deferred_list_.begin()));
+  if (auto index = deferred_index_.Find(deferred_list_, type, hash)) {
+    return static_cast<Index>(list_.size() + *index);
   }
 
   deferred_list_.push_back(type);
+  deferred_index_.Insert(deferred_list_,
+                         static_cast<Index>(deferred_list_.size() - 1));
   return static_cast<Index>(list_.size() + deferred_list_.size() - 1);
 }
 
@@ -119,9 +124,11 @@ auto FunctionTypeMap::EndModule() -> DefinedTypeList {
   for (auto&& deferred : deferred_list_) {
     assert(deferred.has_value());
     list_.push_back(*deferred);
+    index_.Insert(list_, static_cast<Index>(list_.size() - 1));
     defined_types.push_back(ToDefinedType(*deferred));
   }
   deferred_list_.clear();
+  deferred_index_.Clear();
   return defined_types;
 }
 
@@ -152,13 +159,84 @@ DefinedType FunctionTypeMap::ToDefinedType(const FunctionType& unbound_type) {
 }
 
 // static
-FunctionTypeMap::List::const_iterator FunctionTypeMap::FindIter(
-    const List& list,
-    const FunctionType& type) {
-  return std::find_if(list.begin(), list.end(),
-                      [&](const optional<FunctionType>& ft) {
-                        return ft && IsSame(type, *ft);
-                      });
+size_t FunctionTypeMap::Hash(const FunctionType& type) {
+  // Must agree with IsSame, so this ignores locations. Anything that isn't
+  // cheap to hash only contributes its variant index; IsSame sorts out the
+  // (rare) collisions.
+  size_t hash = type.params.size();
+  auto combine = [&](size_t value) {
+    hash ^= value + 0x9e3779b97f4a7c15ull + (hash << 6) + (hash >> 2);
+  };
+  auto combine_value_types = [&](const ValueTypeList& value_types) {
+    for (const auto& value_type : value_types) {
+      combine(value_type->type.index());
+      if (value_type->is_numeric_type()) {
+        combine(static_cast<size_t>(value_type->numeric_type().value()));
+      } else if (value_type->is_reference_type()) {
+        const auto& reference_type = value_type->reference_type();
+        combine(reference_type->type.index());
+        if (reference_type->is_reference_kind()) {
+          combine(
+              static_cast<size_t>(reference_type->reference_kind().value()));
+        } else {
+          combine(static_cast<size_t>(reference_type->ref()->null));
+        }
+      }
+    }
+  };
+  combine_value_types(type.params);
+  combine(type.results.size());
+  combine_value_types(type.results);
+  return hash;
+}
+
+void FunctionTypeMap::HashIndex::Clear() {
+  heads.clear();
+  next.clear();
+}
+
+void FunctionTypeMap::HashIndex::Insert(const List& list, Index index) {
+  assert(index == next.size());
+  next.push_back(kNone);
+  if (!list[index]) {
+    return;
+  }
+
+  auto [iter, inserted] = heads.emplace(Hash(*list[index]), index);
+  if (inserted) {
+    return;
+  }
+
+  // Append to the end of the chain, unless an identical type is already in
+  // it. Chains are kept in index order, so Find returns the first match.
+  Index current = iter->second;
+  while (true) {
+    if (IsSame(*list[current], *list[index])) {
+      return;
+    }
+    if (next[current] == kNone) {
+      next[current] = index;
+      return;
+    }
+    current = next[current];
+  }
+}
+
+auto FunctionTypeMap::HashIndex::Find(const List& list,
+                                      const FunctionType& type,
+                                      size_t hash) const -> optional<Index> {
+  auto iter = heads.find(hash);
+  if (iter == heads.end()) {
+    return nullopt;
+  }
+
+  for (Index current = iter->second; current != kNone;
+       current = next[current]) {
+    if (IsSame(*list[current], type)) {
+      return current;
+    }
+  }
+  return nullopt;
 }
 
 // static
@@ -32,11 +32,16 @@ void Text::AppendToBuffer(Buffer& buffer) const {
       // The rest are zero.
   };
 
-  buffer.reserve(buffer.size() + byte_size);
-
   // Remove surrounding quotes.
   assert(text.size() >= 2 && text[0] == '"' && text[text.size() - 1] == '"');
-  string_view input = text.substr(1, text.size() - 2);
+  string_view input = contents();
+
+  if (has_escapes == HasEscapes::No) {
+    buffer.insert(buffer.end(), input.begin(), input.end());
+    return;
+  }
+
+  buffer.reserve(buffer.size() + byte_size);
 
   // Unescape characters.
   for (auto p = input.begin(), end = input.end(); p < end; ++p) {
@@ -66,6 +71,9 @@ void Text::AppendToBuffer(Buffer& buffer) const {
 }
 
 auto Text::ToString() const -> std::string {
+  if (has_escapes == HasEscapes::No) {
+    return std::string(contents());
+  }
   Buffer buffer;
   AppendToBuffer(buffer);
   return std::string(reinterpret_cast<const char*>(buffer.data()),
@@ -17,7 +17,6 @@
 #include <cassert>
 #include <fstream>
 #include <iostream>
-#include <iterator>
 #include <map>
 #include <set>
 #include <string>
@@ -36,7 +35,7 @@
 #include "wasp/base/string_view.h"
 #include "wasp/binary/lazy_expression.h"
 #include "wasp/binary/lazy_module.h"
-#include "wasp/binary/lazy_module_utils.h"
+#include "wasp/binary/module_index.h"
 #include "wasp/binary/name_section/sections.h"
 #include "wasp/binary/sections.h"
 
@@ -75,8 +74,7 @@ struct Tool {
   Options options;
   LazyModule module;
   std::map<Index, string_view> function_names;
-  std::map<string_view, Index> name_to_function;
-  Index imported_function_count = 0;
+  ModuleIndex module_index;
   std::set<std::pair<Index, Index>> call_graph;
 };
 
@@ -115,13 +113,13 @@ int Main(span<const string_view> args) {
     parser.PrintHelpAndExit(1);
   }
 
-  auto optbuf = ReadFile(filename);
-  if (!optbuf) {
+  auto optfile = MapFile(filename);
+  if (!optfile) {
     Format(&std::cerr, "Error reading file %s.\n", filename);
     return 1;
   }
 
-  SpanU8 data{*optbuf};
+  SpanU8 data = optfile->data();
   Tool tool{data, options};
   int result = tool.Run();
   tool.errors.PrintTo(std::cerr);
@@ -146,13 +144,9 @@ int Tool::Run() {
 }
 
 void Tool::DoPrepass() {
-  ForEachFunctionName(module, [this](const IndexNamePair& pair) {
-    name_to_function.insert(std::make_pair(pair.second, pair.first));
-  });
-
-  CopyFunctionNames(module,
-                    std::inserter(function_names, function_names.end()));
-  imported_function_count = GetImportCount(module, ExternalKind::Function);
+  module_index = IndexModule(module);
+  function_names.insert(module_index.function_names.begin(),
+                        module_index.function_names.end());
 }
 
 void Tool::GetFunctionIndex() {
@@ -161,9 +155,8 @@ void Tool::GetFunctionIndex() {
     return;
   }
   // Search by name.
-  auto iter = name_to_function.find(*options.function);
-  if (iter != name_to_function.end()) {
-    options.function_index = iter->second;
+  if (auto index = module_index.FindFunction(*options.function)) {
+    options.function_index = index;
     return;
   }
 
@@ -179,7 +172,8 @@ void Tool::CalculateCallGraph() {
       auto known = section->known();
       if (known->id == SectionId::Code) {
         auto section = ReadCodeSection(known, module.ctx);
-        for (auto code : enumerate(section.sequence, imported_function_count)) {
+        auto first_index = module_index.imported_function_count;
+        for (auto code : enumerate(section.sequence, first_index)) {
           for (const auto& instr :
                ReadExpression(code.value->body, module.ctx)) {
             if (instr->opcode == Opcode::Call) {
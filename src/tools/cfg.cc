@@ -26,6 +26,7 @@
 
 #include "src/tools/argparser.h"
 #include "src/tools/binary_errors.h"
+#include "src/tools/index_file.h"
 #include "wasp/base/concat.h"
 #include "wasp/base/enumerate.h"
 #include "wasp/base/features.h"
@@ -37,7 +38,7 @@
 #include "wasp/binary/formatters.h"
 #include "wasp/binary/lazy_expression.h"
 #include "wasp/binary/lazy_module.h"
-#include "wasp/binary/lazy_module_utils.h"
+#include "wasp/binary/module_index.h"
 #include "wasp/binary/name_section/sections.h"
 #include "wasp/binary/sections.h"
 
@@ -52,6 +53,7 @@ struct Options {
   Features features;
   string_view function;
   string_view output_filename;
+  std::string index_filename;
 };
 
 using BBID = u32;
@@ -101,8 +103,7 @@ struct Tool {
   BinaryErrors errors;
   Options options;
   LazyModule module;
-  std::map<string_view, Index> name_to_function;
-  Index imported_function_count = 0;
+  ModuleIndex module_index;
   std::vector<Label> labels;
   std::vector<BasicBlock> cfg;
   BBID start_bbid = InvalidBBID;
@@ -113,6 +114,7 @@ int Main(span<const string_view> args) {
   string_view filename;
   Options options;
   options.features.EnableAll();
+  bool use_index = false;
 
   ArgParser parser{"wasp cfg"};
   parser
@@ -122,6 +124,8 @@ int Main(span<const string_view> args) {
            [&](string_view arg) { options.output_filename = arg; })
       .Add('f', "--function", "<func>", "generate CFG for <func>",
            [&](string_view arg) { options.function = arg; })
+      .Add("--index", "cache the module index in <filename>.index",
+           [&]() { use_index = true; })
       .Add("<filename>", "input wasm file", [&](string_view arg) {
         if (filename.empty()) {
           filename = arg;
@@ -141,13 +145,17 @@ int Main(span<const string_view> args) {
     parser.PrintHelpAndExit(1);
   }
 
-  auto optbuf = ReadFile(filename);
-  if (!optbuf) {
+  if (use_index) {
+    options.index_filename = concat(filename, ".index");
+  }
+
+  auto optfile = MapFile(filename);
+  if (!optfile) {
     Format(&std::cerr, "Error reading file %s.\n", filename);
     return 1;
   }
 
-  SpanU8 data{*optbuf};
+  SpanU8 data = optfile->data();
   Tool tool{data, options};
   int result = tool.Run();
   tool.errors.PrintTo(std::cerr);
@@ -178,17 +186,17 @@ int Tool::Run() {
 }
 
 void Tool::DoPrepass() {
-  ForEachFunctionName(module, [this](const IndexNamePair& pair) {
-    name_to_function.insert(std::make_pair(pair.second, pair.first));
-  });
-  imported_function_count = GetImportCount(module, ExternalKind::Function);
+  if (options.index_filename.empty()) {
+    module_index = IndexModule(module);
+  } else {
+    module_index = LoadModuleIndex(module, options.index_filename);
+  }
 }
 
 optional<Index> Tool::GetFunctionIndex() {
   // Search by name.
-  auto iter = name_to_function.find(options.function);
-  if (iter != name_to_function.end()) {
-    return iter->second;
+  if (auto index = module_index.FindFunction(options.function)) {
+    return index;
   }
 
   // Try to convert the string to an integer and search by index.
@@ -196,18 +204,8 @@ optional<Index> Tool::GetFunctionIndex() {
 }
 
 optional<Code> Tool::GetCode(Index find_index) {
-  for (auto section : module.sections) {
-    if (section->is_known()) {
-      auto known = section->known();
-      if (known->id == SectionId::Code) {
-        auto section = ReadCodeSection(known, module.ctx);
-        for (auto code : enumerate(section.sequence, imported_function_count)) {
-          if (code.index == find_index) {
-            return code.value;
-          }
-        }
-      }
-    }
+  if (auto code = module_index.GetCode(find_index, module.ctx)) {
+    return code->value();
   }
   return nullopt;
 }
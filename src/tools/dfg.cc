@@ -25,6 +25,7 @@
 
 #include "src/tools/argparser.h"
 #include "src/tools/binary_errors.h"
+#include "src/tools/index_file.h"
 #include "wasp/base/concat.h"
 #include "wasp/base/enumerate.h"
 #include "wasp/base/errors_nop.h"
@@ -37,7 +38,7 @@
 #include "wasp/binary/formatters.h"
 #include "wasp/binary/lazy_expression.h"
 #include "wasp/binary/lazy_module.h"
-#include "wasp/binary/lazy_module_utils.h"
+#include "wasp/binary/module_index.h"
 #include "wasp/binary/name_section/sections.h"
 #include "wasp/binary/sections.h"
 
@@ -54,6 +55,7 @@ struct Options {
   Features features;
   string_view function;
   string_view output_filename;
+  std::string index_filename;
 };
 
 using BBID = u32;
@@ -145,8 +147,7 @@ struct Tool {
   LazyModule module;
   std::vector<DefinedType> defined_types;
   std::vector<Function> functions;
-  std::map<string_view, Index> name_to_function;
-  Index imported_function_count = 0;
+  ModuleIndex module_index;
   std::vector<Label> labels;
   std::vector<Block> bbs;
   std::vector<Value> values;
@@ -161,6 +162,7 @@ int Main(span<const string_view> args) {
   string_view filename;
   Options options;
   options.features.EnableAll();
+  bool use_index = false;
 
   ArgParser parser{"wasp dfg"};
   parser
@@ -170,6 +172,8 @@ int Main(span<const string_view> args) {
            [&](string_view arg) { options.output_filename = arg; })
       .Add('f', "--function", "<func>", "generate DFG for <func>",
            [&](string_view arg) { options.function = arg; })
+      .Add("--index", "cache the module index in <filename>.index",
+           [&]() { use_index = true; })
       .Add("<filename>", "input wasm file", [&](string_view arg) {
         if (filename.empty()) {
           filename = arg;
@@ -189,13 +193,17 @@ int Main(span<const string_view> args) {
     parser.PrintHelpAndExit(1);
   }
 
-  auto optbuf = ReadFile(filename);
-  if (!optbuf) {
+  if (use_index) {
+    options.index_filename = concat(filename, ".index");
+  }
+
+  auto optfile = MapFile(filename);
+  if (!optfile) {
     Format(&std::cerr, "Error reading file %s.\n", filename);
     return 1;
   }
 
-  SpanU8 data{*optbuf};
+  SpanU8 data = optfile->data();
   Tool tool{data, options};
   int result = tool.Run();
   tool.errors.PrintTo(std::cerr);
@@ -227,9 +235,11 @@ int Tool::Run() {
 }
 
 void Tool::DoPrepass() {
-  ForEachFunctionName(module, [this](const IndexNamePair& pair) {
-    name_to_function.insert(std::make_pair(pair.second, pair.first));
-  });
+  if (options.index_filename.empty()) {
+    module_index = IndexModule(module);
+  } else {
+    module_index = LoadModuleIndex(module, options.index_filename);
+  }
 
   for (auto section : module.sections) {
     if (section->is_known()) {
@@ -248,7 +258,6 @@ void Tool::DoPrepass() {
               functions.push_back(Function{import->index()});
             }
           }
-          imported_function_count = static_cast<Index>(functions.size());
           break;
 
         case SectionId::Function: {
@@ -267,9 +276,8 @@ void Tool::DoPrepass() {
 // TODO(binji): share code with cfg.cc
 optional<Index> Tool::GetFunctionIndex() {
   // Search by name.
-  auto iter = name_to_function.find(options.function);
-  if (iter != name_to_function.end()) {
-    return iter->second;
+  if (auto index = module_index.FindFunction(options.function)) {
+    return index;
   }
 
   // Try to convert the string to an integer and search by index.
@@ -291,18 +299,8 @@ optional<FunctionType> Tool::GetFunctionType(Index func_index) {
 }
 
 optional<Code> Tool::GetCode(Index find_index) {
-  for (auto section : module.sections) {
-    if (section->is_known()) {
-      auto known = section->known();
-      if (known->id == SectionId::Code) {
-        auto section = ReadCodeSection(known, module.ctx);
-        for (auto code : enumerate(section.sequence, imported_function_count)) {
-          if (code.index == find_index) {
-            return code.value;
-          }
-        }
-      }
-    }
+  if (auto code = module_index.GetCode(find_index, module.ctx)) {
+    return code->value();
   }
   return nullopt;
 }
@@ -27,6 +27,7 @@
 #include "src/tools/binary_errors.h"
 #include "wasp/base/concat.h"
 #include "wasp/base/enumerate.h"
+#include "wasp/base/errors_nop.h"
 #include "wasp/base/features.h"
 #include "wasp/base/file.h"
 #include "wasp/base/formatters.h"
@@ -39,8 +40,10 @@
 #include "wasp/binary/lazy_module.h"
 #include "wasp/binary/linking_section/formatters.h"
 #include "wasp/binary/linking_section/sections.h"
+#include "wasp/binary/module_index.h"
 #include "wasp/binary/name_section/formatters.h"
 #include "wasp/binary/name_section/sections.h"
+#include "wasp/binary/read/read_ctx.h"
 #include "wasp/binary/sections.h"
 #include "wasp/binary/visitor.h"
 
@@ -114,6 +117,7 @@ struct Tool {
     visit::Result OnData(const At<DataSegment>&);
 
     visit::Result SkipUnless(bool);
+    void PrintCode(const At<Code>&);
 
     Tool& tool;
     Pass pass;
@@ -183,6 +187,7 @@ struct Tool {
   SpanU8 data;
   BinaryErrors errors;
   LazyModule module;
+  ModuleIndex module_index;
   std::vector<DefinedType> defined_types;
   std::vector<Function> functions;
   std::map<Index, string_view> function_names;
@@ -244,13 +249,13 @@ int Main(span<const string_view> args) {
   }
 
   for (auto filename : filenames) {
-    auto optbuf = ReadFile(filename);
-    if (!optbuf) {
+    auto optfile = MapFile(filename);
+    if (!optfile) {
       Format(&std::cerr, "Error reading file %s.\n", filename);
       continue;
     }
 
-    SpanU8 data{*optbuf};
+    SpanU8 data = optfile->data();
     Tool tool{filename, data, options};
     tool.Run();
     tool.errors.PrintTo(std::cerr);
@@ -362,8 +367,20 @@ void Tool::DoPrepass() {
                 break;
             }
           }
+          break;
         }
 
+        case SectionId::Code:
+          if (options.function) {
+            // Find each body now, so only the requested one is read later.
+            // Any errors will be reported when the section is visited.
+            ErrorsNop nop_errors;
+            ReadCtx ctx{options.features, nop_errors};
+            module_index.imported_function_count = imported_function_count;
+            IndexCodeSection(module_index, known, ctx);
+          }
+          break;
+
         default:
           break;
       }
@@ -750,17 +767,22 @@ visit::Result Tool::Visitor::BeginDataCountSection(DataCountSection section) {
 visit::Result Tool::Visitor::BeginCodeSection(LazyCodeSection section) {
   index = tool.imported_function_count;
   tool.DoCount(pass, section.count);
-  return SkipUnless(tool.ShouldPrintDetails(pass) || pass == Pass::Disassemble);
+  if (!(tool.ShouldPrintDetails(pass) || pass == Pass::Disassemble)) {
+    return visit::Result::Skip;
+  }
+  if (auto func_index = tool.options.func_index) {
+    // Read only the requested function, rather than every body before it.
+    if (auto code = tool.module_index.GetCode(*func_index, tool.module.ctx)) {
+      index = *func_index;
+      PrintCode(*code);
+    }
+    return visit::Result::Skip;
+  }
+  return visit::Result::Ok;
 }
 
 visit::Result Tool::Visitor::BeginCode(const At<Code>& code) {
-  if (!tool.options.func_index || index == tool.options.func_index) {
-    if (pass == Pass::Details) {
-      PrintF(" - func[%d] size=%d\n", index, code->body->data.size());
-    } else {
-      tool.Disassemble(section_index, index, code);
-    }
-  }
+  PrintCode(code);
   ++index;
   // Skip iterating over instructions.
   return visit::Result::Skip;
@@ -793,6 +815,14 @@ visit::Result Tool::Visitor::SkipUnless(bool b) {
   return b ? visit::Result::Ok : visit::Result::Skip;
 }
 
+void Tool::Visitor::PrintCode(const At<Code>& code) {
+  if (pass == Pass::Details) {
+    PrintF(" - func[%d] size=%d\n", index, code->body->data.size());
+  } else {
+    tool.Disassemble(section_index, index, code);
+  }
+}
+
 void Tool::DoNameSection(Pass pass,
                          SectionIndex section_index,
                          LazyNameSection section) {
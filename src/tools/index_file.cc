@@ -0,0 +1,53 @@
+//
+// Copyright 2020 WebAssembly Community Group participants
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//     http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+//
+
+#include "src/tools/index_file.h"
+
+#include <fstream>
+#include <iostream>
+#include <string>
+#include <utility>
+
+#include "absl/strings/str_format.h"
+
+#include "wasp/base/buffer.h"
+#include "wasp/base/file.h"
+
+namespace wasp::tools {
+
+auto LoadModuleIndex(binary::LazyModule& module, string_view filename)
+    -> binary::ModuleIndex {
+  if (auto file = MapFile(filename)) {
+    if (auto index = binary::ReadModuleIndex(file->data(), module)) {
+      return std::move(*index);
+    }
+  }
+
+  auto index = binary::IndexModule(module);
+  Buffer buffer;
+  binary::WriteModuleIndex(index, module.data, buffer);
+  std::ofstream fstream(std::string{filename},
+                        std::ios_base::out | std::ios_base::binary);
+  if (!fstream) {
+    absl::Format(&std::cerr, "Unable to write index file %s.\n", filename);
+    return index;
+  }
+  auto span = ToStringView(buffer);
+  fstream.write(span.data(), span.size());
+  return index;
+}
+
+}  // namespace wasp::tools
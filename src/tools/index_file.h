@@ -0,0 +1,34 @@
+//
+// Copyright 2020 WebAssembly Community Group participants
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//     http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+//
+
+#ifndef SRC_TOOLS_INDEX_FILE_H_
+#define SRC_TOOLS_INDEX_FILE_H_
+
+#include "wasp/base/string_view.h"
+#include "wasp/binary/lazy_module.h"
+#include "wasp/binary/module_index.h"
+
+namespace wasp::tools {
+
+// Returns the index of `module`, read from `filename` if it was saved there
+// for the same module contents. Otherwise the index is rebuilt and saved to
+// `filename`, so the next run can skip building it.
+auto LoadModuleIndex(binary::LazyModule& module, string_view filename)
+    -> binary::ModuleIndex;
+
+}  // namespace wasp::tools
+
+#endif  // SRC_TOOLS_INDEX_FILE_H_
@@ -16,11 +16,11 @@
 
 #include <algorithm>
 #include <cstdint>
-#include <fstream>
-#include <functional>
 #include <iostream>
-#include <map>
+#include <memory>
 #include <string>
+#include <tuple>
+#include <utility>
 #include <vector>
 
 #include "absl/strings/str_format.h"
@@ -28,27 +28,27 @@
 #include "src/tools/argparser.h"
 #include "src/tools/binary_errors.h"
 #include "wasp/base/concat.h"
-#include "wasp/base/enumerate.h"
+#include "wasp/base/errors_buffer.h"
+#include "wasp/base/errors_nop.h"
 #include "wasp/base/features.h"
 #include "wasp/base/file.h"
 #include "wasp/base/formatters.h"
-#include "wasp/base/hash.h"
 #include "wasp/base/hashmap.h"
 #include "wasp/base/optional.h"
+#include "wasp/base/parallel_for.h"
 #include "wasp/base/str_to_u32.h"
 #include "wasp/base/string_view.h"
 #include "wasp/base/types.h"
 #include "wasp/binary/formatters.h"
 #include "wasp/binary/lazy_expression.h"
 #include "wasp/binary/lazy_module.h"
-#include "wasp/binary/visitor.h"
+#include "wasp/binary/read/read_ctx.h"
+#include "wasp/binary/sections.h"
 
 namespace wasp {
 namespace tools {
 namespace pattern {
 
-const size_t kMaxPatternSize = 5;
-
 using absl::PrintF;
 using absl::Format;
 
@@ -56,38 +56,101 @@ using namespace ::wasp::binary;
 
 using Instructions = std::vector<Instruction>;
 
+// Longer patterns are very unlikely to repeat, and each length adds another
+// rolling hash per instruction.
+constexpr Index kMaxPatternLength = 64;
+
 struct Options {
   Features features;
   string_view function;
   string_view output_filename;
   u32 max = 10;
+  Index max_length = 5;
+  Index num_threads = 1;
+  // Immediates that are ignored when comparing instructions, so e.g.
+  // `local.get 0` and `local.get 1` are counted as the same instruction.
+  bool normalize_indexes = false;
+  bool normalize_offsets = false;
+  bool normalize_constants = false;
 };
 
-struct Tool {
-  explicit Tool(SpanU8 data, Options);
+// A pattern is identified by its length and a rolling hash of the
+// fingerprints of its instructions, so counting one doesn't require copying
+// its instructions. Different patterns may share a hash, but with 64 bits
+// that is rare enough not to matter for statistics.
+struct PatternKey {
+  u64 hash;
+  Index length;
 
-  int Run();
+  friend bool operator==(const PatternKey& lhs, const PatternKey& rhs) {
+    return lhs.hash == rhs.hash && lhs.length == rhs.length;
+  }
 
-  struct Visitor : visit::SkipVisitor {
-    explicit Visitor(Tool&);
+  template <typename H>
+  friend H AbslHashValue(H h, const PatternKey& key) {
+    return H::combine(std::move(h), key.hash, key.length);
+  }
+};
 
-    visit::Result OnSection(At<Section>);
-    visit::Result BeginCodeSection(LazyCodeSection);
-    visit::Result BeginCode(const At<Code>&);
+// Where a pattern was first seen, so its instructions can be read again to
+// print it.
+struct Occurrence {
+  Index function;  // Index into Tool::functions.
+  Index start;     // Index of the pattern's first instruction.
 
-    Tool& tool;
-  };
+  friend bool operator<(const Occurrence& lhs, const Occurrence& rhs) {
+    return std::make_pair(lhs.function, lhs.start) <
+           std::make_pair(rhs.function, rhs.start);
+  }
+};
 
+struct PatternInfo {
+  u64 count = 0;
+  Occurrence first;
+};
+
+using PatternMap = flat_hash_map<PatternKey, PatternInfo>;
+
+// The state used by one thread when counting patterns. The per-thread counts
+// are merged when all functions have been counted.
+struct Counter {
+  PatternMap patterns;
+  u64 total_instructions = 0;
+  std::vector<u64> prefix_hashes;
+};
+
+struct File {
+  explicit File(string_view filename, MappedFile, const Features&);
+
+  MappedFile file;
   BinaryErrors errors;
-  Options options;
   LazyModule module;
+};
 
-  flat_hash_map<Instructions, u64> patterns;
-  u64 total_instructions = 0;
+struct Function {
+  Index file;
+  SpanU8 body;
+};
+
+struct Tool {
+  explicit Tool(Options);
+
+  void AddFile(string_view filename, MappedFile);
+  int Run();
+  void CountFunction(Counter&, Index function);
+  PatternMap MergeCounters();
+  Instructions ReadPattern(const PatternKey&, const PatternInfo&);
+
+  Options options;
+  std::vector<u64> powers;  // kHashBase to the power of each pattern length.
+  std::vector<std::unique_ptr<File>> files;
+  std::vector<Function> functions;
+  std::vector<ErrorsBuffer> function_errors;
+  std::vector<Counter> counters;
 };
 
 int Main(span<const string_view> args) {
-  string_view filename;
+  std::vector<string_view> filenames;
   Options options;
   options.features.EnableAll();
 
@@ -99,54 +162,219 @@ int Main(span<const string_view> args) {
            [&](string_view arg) { options.output_filename = arg; })
       .Add('d', "--display", "<int>", "maximum to display",
            [&](string_view arg) { options.max = StrToU32(arg).value_or(10); })
-      .Add("<filename>", "input wasm file", [&](string_view arg) {
-        if (filename.empty()) {
-          filename = arg;
-        } else {
-          Format(&std::cerr, "Filename already given\n");
-        }
-      });
+      .Add('l', "--length", "<int>",
+           "maximum number of instructions in a pattern (2 to 64, default 5)",
+           [&](string_view arg) {
+             auto length = StrToU32(arg);
+             if (!length || *length < 2 || *length > kMaxPatternLength) {
+               Format(&std::cerr, "Invalid pattern length %s.\n", arg);
+               parser.PrintHelpAndExit(1);
+             }
+             options.max_length = *length;
+           })
+      .Add("--normalize-indexes",
+           "treat instructions that differ only by an index as the same",
+           [&]() { options.normalize_indexes = true; })
+      .Add("--normalize-offsets",
+           "treat memory accesses that differ only by offset as the same",
+           [&]() { options.normalize_offsets = true; })
+      .Add("--normalize-constants",
+           "treat constants that differ only by value as the same",
+           [&]() { options.normalize_constants = true; })
+      .Add('j', "--jobs", "<N>",
+           "count patterns using <N> threads (0 means one per core)",
+           [&](string_view arg) {
+             auto num_threads = StrToU32(arg);
+             if (!num_threads) {
+               Format(&std::cerr, "Invalid number of jobs %s.\n", arg);
+               parser.PrintHelpAndExit(1);
+             }
+             options.num_threads = *num_threads;
+             if (options.num_threads == 0) {
+               options.num_threads = DefaultThreadCount();
+             }
+           })
+      .Add("<filenames...>", "input wasm files",
+           [&](string_view arg) { filenames.push_back(arg); });
   parser.Parse(args);
 
-  if (filename.empty()) {
+  if (filenames.empty()) {
     Format(&std::cerr, "No filename given.\n");
     parser.PrintHelpAndExit(1);
   }
 
-  auto optbuf = ReadFile(filename);
-  if (!optbuf) {
-    Format(&std::cerr, "Error reading file %s.\n", filename);
-    return 1;
+  Tool tool{options};
+  for (auto filename : filenames) {
+    auto optfile = MapFile(filename);
+    if (!optfile) {
+      Format(&std::cerr, "Error reading file %s.\n", filename);
+      return 1;
+    }
+    tool.AddFile(filename, std::move(*optfile));
   }
 
-  SpanU8 data{*optbuf};
-  Tool tool{data, options};
-
   int result = tool.Run();
-  tool.errors.PrintTo(std::cerr);
+  for (auto& file : tool.files) {
+    file->errors.PrintTo(std::cerr);
+  }
   return result;
 }
 
-Tool::Tool(SpanU8 data, Options options)
-    : errors{data},
-      options{options},
-      module{ReadLazyModule(data, options.features, errors)} {}
+File::File(string_view filename, MappedFile file, const Features& features)
+    : file{std::move(file)},
+      errors{filename, this->file.data()},
+      module{ReadLazyModule(this->file.data(), features, errors)} {}
+
+// An arbitrary odd multiplier for the polynomial rolling hash.
+constexpr u64 kHashBase = 0x9e3779b97f4a7c15ull;
+
+// 64-bit FNV-1a.
+constexpr u64 kFnvOffset = 0xcbf29ce484222325ull;
+constexpr u64 kFnvPrime = 0x100000001b3ull;
+
+u64 HashBytes(u64 hash, SpanU8 bytes) {
+  for (u8 byte : bytes) {
+    hash = (hash ^ byte) * kFnvPrime;
+  }
+  return hash;
+}
+
+// The splitmix64 finalizer, so that fingerprints of similar instructions
+// don't produce similar rolling hashes.
+u64 Mix(u64 x) {
+  x = (x ^ (x >> 30)) * 0xbf58476d1ce4e5b9ull;
+  x = (x ^ (x >> 27)) * 0x94d049bb133111ebull;
+  return x ^ (x >> 31);
+}
+
+// Returns the location of the immediate that should be ignored when
+// comparing this instruction, if any.
+Location NormalizedImmediate(const Instruction& instr, const Options& options) {
+  if (options.normalize_indexes && instr.has_index_immediate()) {
+    return instr.index_immediate().loc();
+  } else if (options.normalize_offsets && instr.has_mem_arg_immediate()) {
+    return instr.mem_arg_immediate()->offset.loc();
+  } else if (options.normalize_constants) {
+    if (instr.has_s32_immediate()) {
+      return instr.s32_immediate().loc();
+    } else if (instr.has_s64_immediate()) {
+      return instr.s64_immediate().loc();
+    } else if (instr.has_f32_immediate()) {
+      return instr.f32_immediate().loc();
+    } else if (instr.has_f64_immediate()) {
+      return instr.f64_immediate().loc();
+    } else if (instr.has_v128_immediate()) {
+      return instr.v128_immediate().loc();
+    }
+  }
+  return {};
+}
+
+// Clears the immediate that NormalizedImmediate ignores, for printing.
+void Normalize(Instruction& instr, const Options& options) {
+  if (options.normalize_indexes && instr.has_index_immediate()) {
+    instr.index_immediate() = At<Index>{0};
+  } else if (options.normalize_offsets && instr.has_mem_arg_immediate()) {
+    instr.mem_arg_immediate()->offset = 0;
+  } else if (options.normalize_constants) {
+    if (instr.has_s32_immediate()) {
+      instr.s32_immediate() = At<s32>{0};
+    } else if (instr.has_s64_immediate()) {
+      instr.s64_immediate() = At<s64>{0};
+    } else if (instr.has_f32_immediate()) {
+      instr.f32_immediate() = At<f32>{0};
+    } else if (instr.has_f64_immediate()) {
+      instr.f64_immediate() = At<f64>{0};
+    } else if (instr.has_v128_immediate()) {
+      instr.v128_immediate() = At<v128>{v128{}};
+    }
+  }
+}
+
+// Hashes the instruction's encoding, leaving out any normalized immediate.
+u64 Fingerprint(const At<Instruction>& instr, const Options& options) {
+  SpanU8 bytes = instr.loc();
+  Location hole = NormalizedImmediate(*instr, options);
+  u64 hash = kFnvOffset;
+  if (hole.empty()) {
+    hash = HashBytes(hash, bytes);
+  } else {
+    auto before = static_cast<size_t>(hole.data() - bytes.data());
+    hash = HashBytes(hash, bytes.subspan(0, before));
+    hash = HashBytes(hash, bytes.subspan(before + hole.size()));
+  }
+  return Mix(hash);
+}
+
+Tool::Tool(Options options) : options{options} {
+  powers.push_back(1);
+  for (Index length = 1; length <= options.max_length; ++length) {
+    powers.push_back(powers.back() * kHashBase);
+  }
+}
+
+void Tool::AddFile(string_view filename, MappedFile file) {
+  files.push_back(
+      std::make_unique<File>(filename, std::move(file), options.features));
+  auto file_index = static_cast<Index>(files.size() - 1);
+  auto& module = files.back()->module;
+
+  // Besides the code section, only the data count section is needed, to read
+  // bulk memory instructions.
+  for (auto section : module.sections) {
+    if (section->is_known()) {
+      auto known = section->known();
+      if (known->id == SectionId::DataCount) {
+        ReadDataCountSection(known, module.ctx);
+      } else if (known->id == SectionId::Code) {
+        for (auto code : ReadCodeSection(known, module.ctx).sequence) {
+          functions.push_back(Function{file_index, code->body->data});
+        }
+      }
+    }
+  }
+}
 
 int Tool::Run() {
-  Visitor visitor{*this};
-  visit::Visit(module, visitor);
+  auto function_count = static_cast<Index>(functions.size());
+  Index num_threads =
+      std::max(1u, std::min(options.num_threads, function_count));
+  function_errors.resize(function_count);
+  counters.resize(num_threads);
+  ParallelFor(function_count, num_threads, [&](Index worker, Index index) {
+    CountFunction(counters[worker], index);
+  });
+
+  for (Index index = 0; index < function_count; ++index) {
+    function_errors[index].ReplayTo(files[functions[index].file]->errors);
+  }
 
-  using pair = std::pair<Instructions, u64>;
-  std::vector<pair> sorted(options.max);
+  u64 total_instructions = 0;
+  for (const auto& counter : counters) {
+    total_instructions += counter.total_instructions;
+  }
+  auto patterns = MergeCounters();
+
+  // Most frequent first, breaking ties by where the pattern first appears.
+  using pair = std::pair<PatternKey, PatternInfo>;
+  auto order = [](const pair& p) {
+    return std::make_tuple(~p.second.count, p.second.first.function,
+                           p.second.first.start, p.first.length);
+  };
+  std::vector<pair> sorted(std::min<size_t>(options.max, patterns.size()));
   std::partial_sort_copy(
       patterns.begin(), patterns.end(), sorted.begin(), sorted.end(),
-      [](const pair& lhs, const pair& rhs) { return lhs.second > rhs.second; });
+      [&](const pair& lhs, const pair& rhs) {
+        return order(lhs) < order(rhs);
+      });
 
   for (const auto& pattern : sorted) {
-    if (pattern.second > 1) {
-      u64 pattern_instructions = u64(pattern.first.size()) * pattern.second;
-      PrintF("%d: [%d] %s %.2f%%\n", pattern.second, pattern.first.size(),
-             concat(pattern.first),
+    if (pattern.second.count > 1) {
+      u64 pattern_instructions =
+          u64(pattern.first.length) * pattern.second.count;
+      PrintF("%d: [%d] %s %.2f%%\n", pattern.second.count,
+             pattern.first.length,
+             concat(ReadPattern(pattern.first, pattern.second)),
              100.0 * pattern_instructions / total_instructions);
     }
   }
@@ -154,49 +382,70 @@ int Tool::Run() {
   return 0;
 }
 
-Tool::Visitor::Visitor(Tool& tool) : tool{tool} {}
-
-visit::Result Tool::Visitor::OnSection(At<Section> section) {
-  return section->id() == SectionId::Code ? visit::Result::Ok
-                                          : visit::Result::Skip;
+void Tool::CountFunction(Counter& counter, Index function_index) {
+  const auto& function = functions[function_index];
+  ReadCtx ctx{options.features, function_errors[function_index]};
+  ctx.declared_data_count =
+      files[function.file]->module.ctx.declared_data_count;
+
+  // prefix_hashes[i] is the rolling hash of the first i instructions, so the
+  // hash of instructions [start, end) can be found without rehashing them.
+  auto& prefix_hashes = counter.prefix_hashes;
+  prefix_hashes.assign(1, 0);
+  for (const auto& instr : ReadExpression(function.body, ctx)) {
+    prefix_hashes.push_back(prefix_hashes.back() * kHashBase +
+                            Fingerprint(instr, options));
+    auto end = static_cast<Index>(prefix_hashes.size() - 1);
+    Index max_length = std::min(options.max_length, end);
+    for (Index length = 2; length <= max_length; ++length) {
+      Index start = end - length;
+      u64 hash = prefix_hashes[end] - prefix_hashes[start] * powers[length];
+      auto& info = counter.patterns[PatternKey{hash, length}];
+      // Each thread is handed functions in increasing order, so the first
+      // occurrence it sees is also its earliest.
+      if (info.count++ == 0) {
+        info.first = Occurrence{function_index, start};
+      }
+    }
+    ++counter.total_instructions;
+  }
 }
 
-visit::Result Tool::Visitor::BeginCodeSection(LazyCodeSection) {
-  return visit::Result::Ok;
+PatternMap Tool::MergeCounters() {
+  PatternMap patterns = std::move(counters[0].patterns);
+  for (size_t i = 1; i < counters.size(); ++i) {
+    for (const auto& [key, info] : counters[i].patterns) {
+      auto& merged = patterns[key];
+      if (merged.count == 0 || info.first < merged.first) {
+        merged.first = info.first;
+      }
+      merged.count += info.count;
+    }
+    counters[i].patterns.clear();
+  }
+  return patterns;
 }
 
-visit::Result Tool::Visitor::BeginCode(const At<Code>& code) {
-  Instructions instructions;
+Instructions Tool::ReadPattern(const PatternKey& key, const PatternInfo& info) {
+  const auto& function = functions[info.first.function];
+  ErrorsNop errors;
+  ReadCtx ctx{options.features, errors};
+  ctx.declared_data_count =
+      files[function.file]->module.ctx.declared_data_count;
 
-  auto instrs = ReadExpression(code->body, tool.module.ctx);
-  for (auto it = instrs.begin(), end = instrs.end(); it != end; ++it) {
-    auto instr = *it;
-#if 0
-    // Make all offsets and indexes 0.
-    if (instr.has_mem_arg_immediate()) {
-      instr.mem_arg_immediate().offset = 0;
-    } else if (instr.has_index_immediate()) {
-      instr.index_immediate() = 0;
+  Instructions instructions;
+  Index index = 0;
+  for (const auto& instr : ReadExpression(function.body, ctx)) {
+    if (index++ < info.first.start) {
+      continue;
     }
-#endif
-
     instructions.push_back(instr);
-
-    if (instructions.size() > kMaxPatternSize) {
-      instructions.erase(instructions.begin());
-    }
-    if (instructions.size() > 1) {
-      Instructions slice;
-      slice.push_back(instructions[0]);
-      for (size_t i = 1; i < instructions.size(); ++i) {
-        slice.push_back(instructions[i]);
-        ++tool.patterns[slice];
-      }
+    Normalize(instructions.back(), options);
+    if (instructions.size() == key.length) {
+      break;
     }
-    ++tool.total_instructions;
   }
-  // Skip iterating over instructions.
-  return visit::Result::Skip;
+  return instructions;
 }
 
 }  // namespace pattern
@@ -18,10 +18,17 @@
 
 #include <algorithm>
 #include <array>
+#include <chrono>
+#include <condition_variable>
+#include <filesystem>
 #include <fstream>
 #include <iostream>
 #include <map>
+#include <mutex>
+#include <numeric>
+#include <sstream>
 #include <string>
+#include <system_error>
 #include <vector>
 
 #include "absl/strings/str_format.h"
@@ -33,11 +40,15 @@
 #include "wasp/base/file.h"
 #include "wasp/base/formatters.h"
 #include "wasp/base/optional.h"
+#include "wasp/base/parallel_for.h"
+#include "wasp/base/str_to_u32.h"
 #include "wasp/base/string_view.h"
 #include "wasp/binary/formatters.h"
 #include "wasp/valid/valid_ctx.h"
 #include "wasp/valid/validate_visitor.h"
 
+namespace fs = std::filesystem;
+
 namespace wasp {
 namespace tools {
 namespace validate {
@@ -47,9 +58,17 @@ using absl::PrintF;
 
 using namespace ::wasp::binary;
 
+using Clock = std::chrono::steady_clock;
+using Seconds = std::chrono::duration<double>;
+
 struct Options {
   Features features;
   bool verbose = false;
+  bool ordered = true;
+  bool summary = false;
+  Index num_threads = 1;
+  Index num_slowest = 10;
+  u64 max_in_flight_bytes = u64{1024} << 20;
 };
 
 struct Tool {
@@ -65,6 +84,149 @@ struct Tool {
   valid::ValidateVisitor visitor;
 };
 
+enum class Status { Unreadable, Valid, Invalid };
+
+struct FileResult {
+  Status status = Status::Unreadable;
+  std::string errors;
+  Seconds duration{};
+};
+
+// Limits the total size of the files that are being validated at once. A
+// file that is larger than the limit is allowed when nothing else is in
+// flight, so it can't block forever.
+class ByteBudget {
+ public:
+  explicit ByteBudget(u64 limit) : limit_{limit} {}
+
+  void Acquire(u64 size) {
+    std::unique_lock<std::mutex> lock{mutex_};
+    cv_.wait(lock, [&]() {
+      return in_flight_ == 0 || in_flight_ + size <= limit_;
+    });
+    in_flight_ += size;
+  }
+
+  void Release(u64 size) {
+    {
+      std::lock_guard<std::mutex> lock{mutex_};
+      in_flight_ -= size;
+    }
+    cv_.notify_all();
+  }
+
+ private:
+  std::mutex mutex_;
+  std::condition_variable cv_;
+  u64 limit_;
+  u64 in_flight_ = 0;
+};
+
+// Prints the result of each file as it finishes. In ordered mode, a result
+// is held back until the results of all previous files have been printed.
+class Reporter {
+ public:
+  explicit Reporter(span<const string_view> filenames,
+                    const std::vector<FileResult>& results,
+                    const Options& options)
+      : filenames_{filenames},
+        results_{results},
+        options_{options},
+        done_(filenames.size()) {}
+
+  void Finish(Index index) {
+    std::lock_guard<std::mutex> lock{mutex_};
+    if (!options_.ordered) {
+      Print(index);
+      return;
+    }
+    done_[index] = true;
+    while (next_ < done_.size() && done_[next_]) {
+      Print(next_++);
+    }
+  }
+
+ private:
+  void Print(Index index) {
+    auto filename = filenames_[index];
+    const auto& result = results_[index];
+    if (result.status == Status::Unreadable) {
+      Format(&std::cerr, "Error reading file %s.\n", filename);
+      return;
+    }
+
+    bool valid = result.status == Status::Valid;
+    if (!valid || options_.verbose) {
+      PrintF("[%4s] %s\n", valid ? " OK " : "FAIL", filename);
+      std::cerr << result.errors;
+    }
+  }
+
+  span<const string_view> filenames_;
+  const std::vector<FileResult>& results_;
+  const Options& options_;
+  std::mutex mutex_;
+  std::vector<bool> done_;
+  Index next_ = 0;
+};
+
+FileResult ValidateFile(string_view filename,
+                        const Options& options,
+                        ByteBudget& budget) {
+  // Pipes and other special files have no size; don't count them.
+  std::error_code ec;
+  u64 size = fs::file_size(fs::path{filename}, ec);
+  if (ec) {
+    size = 0;
+  }
+
+  FileResult result;
+  budget.Acquire(size);
+  // Don't count the time spent waiting for the budget, so the slowest files
+  // are the ones that are slow to validate.
+  auto start = Clock::now();
+  if (auto optfile = MapFile(filename)) {
+    Tool tool{filename, optfile->data(), options};
+    result.status = tool.Run() ? Status::Valid : Status::Invalid;
+    std::ostringstream stream;
+    tool.errors.PrintTo(stream);
+    result.errors = stream.str();
+  }
+  result.duration = Clock::now() - start;
+  budget.Release(size);
+  return result;
+}
+
+void PrintSummary(span<const string_view> filenames,
+                  const std::vector<FileResult>& results,
+                  Seconds duration,
+                  const Options& options) {
+  std::array<size_t, 3> counts{};
+  for (const auto& result : results) {
+    counts[static_cast<size_t>(result.status)]++;
+  }
+  PrintF("%zu files in %.3fs: %zu valid, %zu invalid, %zu unreadable\n",
+         results.size(), duration.count(),
+         counts[static_cast<size_t>(Status::Valid)],
+         counts[static_cast<size_t>(Status::Invalid)],
+         counts[static_cast<size_t>(Status::Unreadable)]);
+
+  std::vector<Index> order(results.size());
+  std::iota(order.begin(), order.end(), 0);
+  auto count = std::min<size_t>(options.num_slowest, order.size());
+  std::partial_sort(order.begin(), order.begin() + count, order.end(),
+                    [&](Index lhs, Index rhs) {
+                      return results[lhs].duration > results[rhs].duration;
+                    });
+  if (count > 0) {
+    PrintF("Slowest files:\n");
+  }
+  for (size_t i = 0; i < count; ++i) {
+    PrintF("  %8.3fs %s\n", results[order[i]].duration.count(),
+           filenames[order[i]]);
+  }
+}
+
 int Main(span<const string_view> args) {
   std::vector<string_view> filenames;
   Options options;
@@ -75,6 +237,45 @@ int Main(span<const string_view> args) {
            [&]() { parser.PrintHelpAndExit(0); })
       .Add('v', "--verbose", "print filename and whether it was valid",
            [&]() { options.verbose = true; })
+      .Add('j', "--jobs", "<N>",
+           "validate using <N> threads (0 means one per core); files are "
+           "validated concurrently, and a single file's functions are "
+           "validated in parallel",
+           [&](string_view arg) {
+             auto num_threads = StrToU32(arg);
+             if (!num_threads) {
+               Format(&std::cerr, "Invalid number of jobs %s.\n", arg);
+               parser.PrintHelpAndExit(1);
+             }
+             options.num_threads = *num_threads;
+             if (options.num_threads == 0) {
+               options.num_threads = DefaultThreadCount();
+             }
+           })
+      .Add("--stream", "print results as files finish, instead of in order",
+           [&]() { options.ordered = false; })
+      .Add("--max-memory", "<MiB>",
+           "limit the size of the files validated at once (default 1024)",
+           [&](string_view arg) {
+             auto max_memory = StrToU32(arg);
+             if (!max_memory) {
+               Format(&std::cerr, "Invalid memory limit %s.\n", arg);
+               parser.PrintHelpAndExit(1);
+             }
+             options.max_in_flight_bytes = u64{*max_memory} << 20;
+           })
+      .Add("--summary", "print a summary and the slowest files at the end",
+           [&]() { options.summary = true; })
+      .Add("--slowest", "<N>",
+           "number of slowest files to print in the summary (default 10)",
+           [&](string_view arg) {
+             auto num_slowest = StrToU32(arg);
+             if (!num_slowest) {
+               Format(&std::cerr, "Invalid number of files %s.\n", arg);
+               parser.PrintHelpAndExit(1);
+             }
+             options.num_slowest = *num_slowest;
+           })
       .AddFeatureFlags(options.features)
       .Add("<filenames...>", "input wasm files",
            [&](string_view arg) { filenames.push_back(arg); });
@@ -85,25 +286,29 @@ int Main(span<const string_view> args) {
     parser.PrintHelpAndExit(1);
   }
 
-  bool ok = true;
-  for (auto filename : filenames) {
-    auto optbuf = ReadFile(filename);
-    if (!optbuf) {
-      Format(&std::cerr, "Error reading file %s.\n", filename);
-      ok = false;
-      continue;
-    }
+  // Spread the threads over the files first; any that are left over are used
+  // to validate each file's functions.
+  auto file_count = static_cast<Index>(filenames.size());
+  Index file_threads = std::min(options.num_threads, file_count);
+  Options file_options = options;
+  file_options.num_threads = std::max(1u, options.num_threads / file_threads);
 
-    SpanU8 data{*optbuf};
-    Tool tool{filename, data, options};
-    bool valid = tool.Run();
-    if (!valid || options.verbose) {
-      PrintF("[%4s] %s\n", valid ? " OK " : "FAIL", filename);
-      tool.errors.PrintTo(std::cerr);
-    }
-    ok &= valid;
+  auto start = Clock::now();
+  std::vector<FileResult> results(file_count);
+  ByteBudget budget{options.max_in_flight_bytes};
+  Reporter reporter{filenames, results, options};
+  ParallelFor(file_count, file_threads, [&](Index, Index index) {
+    results[index] = ValidateFile(filenames[index], file_options, budget);
+    reporter.Finish(index);
+  });
+
+  if (options.summary) {
+    PrintSummary(filenames, results, Clock::now() - start, options);
   }
 
+  bool ok = std::all_of(results.begin(), results.end(), [](const auto& r) {
+    return r.status == Status::Valid;
+  });
   return ok ? 0 : 1;
 }
 
@@ -113,7 +318,7 @@ Tool::Tool(string_view filename, SpanU8 data, Options options)
       data{data},
       errors{data},
       module{ReadLazyModule(data, options.features, errors)},
-      visitor{options.features, errors} {}
+      visitor{options.features, errors, options.num_threads} {}
 
 bool Tool::Run() {
   if (module.magic && module.version) {
@@ -17,6 +17,7 @@
 #include <filesystem>
 #include <fstream>
 #include <iostream>
+#include <vector>
 
 #include "absl/strings/str_format.h"
 
@@ -24,22 +25,28 @@
 #include "src/tools/binary_errors.h"
 #include "wasp/base/buffer.h"
 #include "wasp/base/errors.h"
+#include "wasp/base/errors_nop.h"
 #include "wasp/base/features.h"
 #include "wasp/base/file.h"
 #include "wasp/base/formatters.h"
+#include "wasp/base/parallel_for.h"
 #include "wasp/base/span.h"
+#include "wasp/base/str_to_u32.h"
 #include "wasp/base/string_view.h"
 #include "wasp/binary/encoding.h"
 #include "wasp/binary/formatters.h"
+#include "wasp/binary/lazy_expression.h"
+#include "wasp/binary/lazy_module.h"
 #include "wasp/binary/read.h"
 #include "wasp/binary/read/read_ctx.h"
+#include "wasp/binary/sections.h"
 #include "wasp/binary/types.h"
+#include "wasp/binary/visitor.h"
 #include "wasp/convert/to_text.h"
 #include "wasp/text/formatters.h"
 #include "wasp/text/types.h"
 #include "wasp/text/write.h"
-#include "wasp/valid/valid_ctx.h"
-#include "wasp/valid/validate.h"
+#include "wasp/valid/validate_visitor.h"
 
 namespace fs = std::filesystem;
 
@@ -54,6 +61,7 @@ struct Options {
   Features features;
   bool validate = true;
   optional<std::string> output_filename;
+  Index num_threads = 1;
 };
 
 struct Tool {
@@ -62,10 +70,26 @@ struct Tool {
   enum class PrintChars { No, Yes };
 
   int Run();
+  void WriteModule(std::ostream&);
+
+  template <typename Sequence>
+  void WriteItems(Sequence&&);
+  template <typename T>
+  void WriteItem(const At<T>&);
+  void Flush();
+
+  // Text is written to `out` whenever this much has been buffered, so the
+  // memory used is proportional to one function body rather than the whole
+  // module.
+  static constexpr size_t kFlushSize = 64 * 1024;
 
   std::string filename;
   Options options;
   SpanU8 data;
+  convert::TextCtx convert_context;
+  text::WriteCtx write_context;
+  Buffer buffer;
+  std::ostream* out = nullptr;
 };
 
 int Main(span<const string_view> args) {
@@ -80,6 +104,19 @@ int Main(span<const string_view> args) {
            [&](string_view arg) { options.output_filename = arg; })
       .Add("--no-validate", "Don't validate before writing",
            [&]() { options.validate = false; })
+      .Add('j', "--jobs", "<N>",
+           "validate function bodies using <N> threads (0 means one per core)",
+           [&](string_view arg) {
+             auto num_threads = StrToU32(arg);
+             if (!num_threads) {
+               Format(&std::cerr, "Invalid number of jobs %s.\n", arg);
+               parser.PrintHelpAndExit(1);
+             }
+             options.num_threads = *num_threads;
+             if (options.num_threads == 0) {
+               options.num_threads = DefaultThreadCount();
+             }
+           })
       .AddFeatureFlags(options.features)
       .Add("<filename>", "input wasm file", [&](string_view arg) {
         if (filename.empty()) {
@@ -95,8 +132,8 @@ int Main(span<const string_view> args) {
     parser.PrintHelpAndExit(1);
   }
 
-  auto optbuf = ReadFile(filename);
-  if (!optbuf) {
+  auto optfile = MapFile(filename);
+  if (!optfile) {
     Format(&std::cerr, "Error reading file %s.\n", filename);
     return 1;
   }
@@ -107,7 +144,7 @@ int Main(span<const string_view> args) {
         fs::path(filename).replace_extension(".wat").string();
   }
 
-  SpanU8 data{*optbuf};
+  SpanU8 data = optfile->data();
   Tool tool{filename, data, options};
   return tool.Run();
 }
@@ -117,31 +154,27 @@ Tool::Tool(string_view filename, SpanU8 data, Options options)
 
 int Tool::Run() {
   BinaryErrors errors{data};
-  binary::ReadCtx read_context{options.features, errors};
-  auto binary_module = binary::ReadModule(data, read_context);
-  if (errors.HasError()) {
-    errors.PrintTo(std::cerr);
-    return 1;
-  }
-
-  if (options.validate) {
-    valid::ValidCtx validate_context{options.features, errors};
-    valid::Validate(validate_context, *binary_module);
+  auto module = binary::ReadLazyModule(data, options.features, errors);
 
-    if (errors.HasError()) {
-      errors.PrintTo(std::cerr);
-      return 1;
+  // Read the whole module once before writing anything, so errors are
+  // reported instead of partial output. A missing magic or version has
+  // already been reported.
+  if (module.magic && module.version) {
+    if (options.validate) {
+      valid::ValidateVisitor visitor{options.features, errors,
+                                     options.num_threads};
+      binary::visit::Visit(module, visitor);
+    } else {
+      binary::visit::Visitor visitor;
+      binary::visit::Visit(module, visitor);
     }
   }
 
-  convert::TextCtx convert_context;
-  auto text_module = convert::ToText(convert_context, *binary_module);
-
-  text::WriteCtx write_context;
-  Buffer buffer;
-  text::Write(write_context, text_module, std::back_inserter(buffer));
+  if (errors.HasError()) {
+    errors.PrintTo(std::cerr);
+    return 1;
+  }
 
-  auto span = ToStringView(buffer);
   if (options.output_filename) {
     std::ofstream fstream(*options.output_filename,
                           std::ios_base::out | std::ios_base::binary);
@@ -149,15 +182,131 @@ int Tool::Run() {
       Format(&std::cerr, "Unable to open file %s.\n", *options.output_filename);
       return 1;
     }
-
-    fstream.write(span.data(), span.size());
+    WriteModule(fstream);
   } else {
-    std::cout.write(span.data(), span.size());
+    WriteModule(std::cout);
   }
 
   return 0;
 }
 
+void Tool::WriteModule(std::ostream& stream) {
+  // The module was already read without errors, so they can be ignored here.
+  ErrorsNop errors;
+  auto module = binary::ReadLazyModule(data, options.features, errors);
+  auto& ctx = module.ctx;
+
+  std::vector<binary::KnownSection> known_sections;
+  for (auto&& section : module.sections) {
+    if (section->is_known()) {
+      known_sections.push_back(section->known());
+    }
+  }
+  auto find_section =
+      [&](binary::SectionId id) -> optional<binary::KnownSection> {
+    for (auto&& known : known_sections) {
+      if (known.id == id) {
+        return known;
+      }
+    }
+    return nullopt;
+  };
+
+  // Needed to read memory.init and data.drop instructions.
+  if (auto sec = find_section(binary::SectionId::DataCount)) {
+    binary::ReadDataCountSection(*sec, ctx);
+  }
+
+  out = &stream;
+  buffer.reserve(2 * kFlushSize);
+
+  // Write the items in the same order as convert::ToText: everything but the
+  // functions in section order (with tags after globals), then the functions.
+  if (auto sec = find_section(binary::SectionId::Type)) {
+    WriteItems(binary::ReadTypeSection(*sec, ctx).sequence);
+  }
+  if (auto sec = find_section(binary::SectionId::Import)) {
+    WriteItems(binary::ReadImportSection(*sec, ctx).sequence);
+  }
+  if (auto sec = find_section(binary::SectionId::Table)) {
+    WriteItems(binary::ReadTableSection(*sec, ctx).sequence);
+  }
+  if (auto sec = find_section(binary::SectionId::Memory)) {
+    WriteItems(binary::ReadMemorySection(*sec, ctx).sequence);
+  }
+  if (auto sec = find_section(binary::SectionId::Global)) {
+    WriteItems(binary::ReadGlobalSection(*sec, ctx).sequence);
+  }
+  if (auto sec = find_section(binary::SectionId::Tag)) {
+    WriteItems(binary::ReadTagSection(*sec, ctx).sequence);
+  }
+  if (auto sec = find_section(binary::SectionId::Export)) {
+    WriteItems(binary::ReadExportSection(*sec, ctx).sequence);
+  }
+  if (auto sec = find_section(binary::SectionId::Start)) {
+    if (auto start = binary::ReadStartSection(*sec, ctx)) {
+      WriteItem(convert::ToText(convert_context, *start));
+    }
+  }
+  if (auto sec = find_section(binary::SectionId::Element)) {
+    WriteItems(binary::ReadElementSection(*sec, ctx).sequence);
+  }
+  if (auto sec = find_section(binary::SectionId::Data)) {
+    WriteItems(binary::ReadDataSection(*sec, ctx).sequence);
+  }
+
+  // Only the function types are kept; each body is decoded, converted and
+  // written before reading the next one.
+  std::vector<At<binary::Function>> functions;
+  if (auto sec = find_section(binary::SectionId::Function)) {
+    for (auto&& function : binary::ReadFunctionSection(*sec, ctx).sequence) {
+      functions.push_back(function);
+    }
+  }
+  if (auto sec = find_section(binary::SectionId::Code)) {
+    Index index = 0;
+    for (auto&& code : binary::ReadCodeSection(*sec, ctx).sequence) {
+      if (index >= functions.size()) {
+        break;
+      }
+      auto function = convert::ToText(convert_context, functions[index++]);
+      binary::UnpackedCode unpacked{code->locals, {}};
+      for (auto&& instr : binary::ReadExpression(*code->body, ctx)) {
+        unpacked.body.instructions.push_back(instr);
+      }
+      binary::EndCode(code->body->data.last(0), ctx);
+      WriteItem(
+          convert::ToText(convert_context, At{code.loc(), unpacked}, function));
+    }
+  }
+
+  Flush();
+}
+
+template <typename Sequence>
+void Tool::WriteItems(Sequence&& sequence) {
+  for (auto&& item : sequence) {
+    WriteItem(convert::ToText(convert_context, item));
+  }
+}
+
+template <typename T>
+void Tool::WriteItem(const At<T>& item) {
+  text::Write(write_context, text::ModuleItem{item},
+              text::BufferInserter{buffer});
+  // The converted item is no longer needed, so neither are its strings.
+  convert_context.arena.Clear();
+  if (buffer.size() >= kFlushSize) {
+    Flush();
+  }
+}
+
+void Tool::Flush() {
+  auto span = ToStringView(buffer);
+  out->write(span.data(), span.size());
+  buffer.clear();
+}
+
 }  // namespace wasm2wat
 }  // namespace tools
 }  // namespace wasp
@@ -27,7 +27,9 @@
 #include "wasp/base/features.h"
 #include "wasp/base/file.h"
 #include "wasp/base/formatters.h"
+#include "wasp/base/parallel_for.h"
 #include "wasp/base/span.h"
+#include "wasp/base/str_to_u32.h"
 #include "wasp/base/string_view.h"
 #include "wasp/binary/encoding.h"
 #include "wasp/binary/formatters.h"
@@ -59,6 +61,7 @@ using absl::Format;
 struct Options {
   Features features;
   bool validate = true;
+  Index num_threads = 1;
   std::string output_filename;
 };
 
@@ -86,6 +89,19 @@ int Main(span<const string_view> args) {
            [&](string_view arg) { options.output_filename = arg; })
       .Add("--no-validate", "Don't validate before writing",
            [&]() { options.validate = false; })
+      .Add('j', "--jobs", "<N>",
+           "encode function bodies using <N> threads (0 means one per core)",
+           [&](string_view arg) {
+             auto num_threads = StrToU32(arg);
+             if (!num_threads) {
+               Format(&std::cerr, "Invalid number of jobs %s.\n", arg);
+               parser.PrintHelpAndExit(1);
+             }
+             options.num_threads = *num_threads;
+             if (options.num_threads == 0) {
+               options.num_threads = DefaultThreadCount();
+             }
+           })
       .AddFeatureFlags(options.features)
       .Add("<filename>", "input wasm file", [&](string_view arg) {
         if (filename.empty()) {
@@ -101,8 +117,8 @@ int Main(span<const string_view> args) {
     parser.PrintHelpAndExit(1);
   }
 
-  auto optbuf = ReadFile(filename);
-  if (!optbuf) {
+  auto optfile = MapFile(filename);
+  if (!optfile) {
     Format(&std::cerr, "Error reading file %s.\n", filename);
     return 1;
   }
@@ -113,7 +129,7 @@ int Main(span<const string_view> args) {
         fs::path(filename).replace_extension(".wasm").string();
   }
 
-  SpanU8 data{*optbuf};
+  SpanU8 data = optfile->data();
   Tool tool{filename, data, options};
   return tool.Run();
 }
@@ -151,7 +167,8 @@ int Tool::Run() {
   }
 
   Buffer buffer;
-  Write(binary_module, std::back_inserter(buffer));
+  WriteModule(binary_module, buffer, binary::CompactSizes::Yes,
+              options.num_threads);
 
   std::ofstream fstream(options.output_filename,
                         std::ios_base::out | std::ios_base::binary);
@@ -16,6 +16,7 @@
 
 #include "wasp/valid/valid_ctx.h"
 
+#include <algorithm>
 #include <cassert>
 
 namespace wasp::valid {
@@ -25,8 +26,8 @@ Label::Label(LabelType label_type,
              StackTypeSpan result_types,
              Index type_stack_limit)
     : label_type{label_type},
-      param_types{param_types.begin(), param_types.end()},
-      result_types{result_types.begin(), result_types.end()},
+      param_types{param_types},
+      result_types{result_types},
       type_stack_limit{type_stack_limit},
       unreachable{false} {}
 
@@ -61,6 +62,53 @@ bool ValidCtx::IsArrayType(Index index) const {
   return index < types.size() && types[index].is_array_type();
 }
 
+auto ValidCtx::GetStackFunctionType(Index index) -> const StackFunctionType& {
+  assert(IsFunctionType(index));
+  // Types are usually added by validating the type section, but may be added
+  // directly too, so fill in the cache lazily.
+  while (stack_function_types.size() <= index) {
+    const auto& type = types[stack_function_types.size()];
+    if (type.is_function_type()) {
+      const auto& function_type = type.function_type();
+      stack_function_types.push_back(
+          StackFunctionType{ToStackTypeList(function_type->param_types),
+                            ToStackTypeList(function_type->result_types)});
+    } else {
+      stack_function_types.emplace_back();
+    }
+  }
+  return stack_function_types[index];
+}
+
+auto ValidCtx::GetSingleTypeSpan(StackType type) -> StackTypeSpan {
+  static const StackType numeric_types[] = {
+      StackType::I32(), StackType::I64(), StackType::F32(),
+      StackType::F64(), StackType::V128(),
+  };
+  if (type.is_value_type() && type.value_type().is_numeric_type()) {
+    switch (type.value_type().numeric_type()) {
+      case NumericType::I32:
+        return StackTypeSpan{&numeric_types[0], 1};
+      case NumericType::I64:
+        return StackTypeSpan{&numeric_types[1], 1};
+      case NumericType::F32:
+        return StackTypeSpan{&numeric_types[2], 1};
+      case NumericType::F64:
+        return StackTypeSpan{&numeric_types[3], 1};
+      case NumericType::V128:
+        return StackTypeSpan{&numeric_types[4], 1};
+    }
+  }
+
+  // There are rarely more than a handful of other single types in a module.
+  auto iter = std::find(single_types.begin(), single_types.end(), type);
+  if (iter == single_types.end()) {
+    single_types.push_back(type);
+    return StackTypeSpan{&single_types.back(), 1};
+  }
+  return StackTypeSpan{&*iter, 1};
+}
+
 void SameTypes::Reset(Index size) {
   disjoint_set_.Reset(size);
   assume_.clear();
@@ -85,10 +85,12 @@ bool BeginCode(ValidCtx& ctx, Location loc) {
 
     assert(defined_type.is_function_type());
     const auto& function_type = defined_type.function_type();
+    const auto& stack_function_type =
+        ctx.GetStackFunctionType(function.type_index);
     ctx.locals.Append(function_type->param_types);
-    ctx.label_stack.push_back(
-        Label{LabelType::Function, ToStackTypeList(function_type->param_types),
-              ToStackTypeList(function_type->result_types), 0});
+    ctx.label_stack.push_back(Label{LabelType::Function,
+                                    stack_function_type.param_types,
+                                    stack_function_type.result_types, 0});
     return true;
   } else {
     // Not valid, but try to continue anyway.
@@ -174,7 +176,7 @@ bool Validate(ValidCtx& ctx,
   new_context.label_stack.push_back(
       Label{LabelType::Function,
             {},
-            ToStackTypeList(binary::ValueTypeList{expected_type}),
+            new_context.GetSingleTypeSpan(StackType{expected_type}),
             0});
 
   for (auto&& instruction : value->instructions) {
@@ -73,40 +73,49 @@ bool AllTrue(T first, Args... rest) {
   return !!first & AllTrue(rest...);
 }
 
-optional<FunctionType> GetFunctionType(ValidCtx& ctx, At<Index> index) {
+// The Get*Type functions below return pointers into the ValidCtx rather
+// than copies, since they're called for most call, block and gc instructions.
+const FunctionType* GetFunctionType(ValidCtx& ctx, At<Index> index) {
   if (!ValidateIndex(ctx, index, static_cast<Index>(ctx.types.size()),
                      "type index")) {
-    return nullopt;
+    return nullptr;
   }
   if (!ctx.types[index].is_function_type()) {
     ctx.errors->OnError(index.loc(), "Expected a function type");
-    return nullopt;
+    return nullptr;
+  }
+  return &ctx.types[index].function_type().value();
+}
+
+const StackFunctionType* GetStackFunctionType(ValidCtx& ctx, At<Index> index) {
+  if (!GetFunctionType(ctx, index)) {
+    return nullptr;
   }
-  return ctx.types[index].function_type();
+  return &ctx.GetStackFunctionType(index);
 }
 
-optional<StructType> GetStructType(ValidCtx& ctx, At<Index> index) {
+const StructType* GetStructType(ValidCtx& ctx, At<Index> index) {
   if (!ValidateIndex(ctx, index, static_cast<Index>(ctx.types.size()),
                      "type index")) {
-    return nullopt;
+    return nullptr;
   }
   if (!ctx.types[index].is_struct_type()) {
     ctx.errors->OnError(index.loc(), "Expected a struct type");
-    return nullopt;
+    return nullptr;
   }
-  return ctx.types[index].struct_type();
+  return &ctx.types[index].struct_type().value();
 }
 
-optional<ArrayType> GetArrayType(ValidCtx& ctx, At<Index> index) {
+const ArrayType* GetArrayType(ValidCtx& ctx, At<Index> index) {
   if (!ValidateIndex(ctx, index, static_cast<Index>(ctx.types.size()),
                      "type index")) {
-    return nullopt;
+    return nullptr;
   }
   if (!ctx.types[index].is_array_type()) {
     ctx.errors->OnError(index.loc(), "Expected an array type");
-    return nullopt;
+    return nullptr;
   }
-  return ctx.types[index].array_type();
+  return &ctx.types[index].array_type().value();
 }
 
 optional<FieldType> GetStructFieldType(ValidCtx& ctx,
@@ -161,19 +170,31 @@ optional<PackedType> GetStructFieldPackedType(ValidCtx& ctx,
   return GetFieldPackedType(ctx, loc, *field_type);
 }
 
-optional<FunctionType> GetBlockTypeSignature(ValidCtx& ctx,
-                                             BlockType block_type) {
+// The types refer to storage owned by the ValidCtx, so they can be stored
+// in a Label.
+struct BlockSignature {
+  StackTypeSpan param_types;
+  StackTypeSpan result_types;
+};
+
+optional<BlockSignature> GetBlockTypeSignature(ValidCtx& ctx,
+                                               BlockType block_type) {
   if (block_type.is_void()) {
-    return FunctionType{};
+    return BlockSignature{};
   } else if (block_type.is_value_type()) {
     const auto& value_type = block_type.value_type();
     if (!Validate(ctx, value_type)) {
       return nullopt;
     }
-    return FunctionType{{}, {value_type}};
+    return BlockSignature{{}, ctx.GetSingleTypeSpan(StackType{value_type})};
   } else {
     assert(block_type.is_index());
-    return GetFunctionType(ctx, block_type.index());
+    auto* function_type = GetStackFunctionType(ctx, block_type.index());
+    if (!function_type) {
+      return nullopt;
+    }
+    return BlockSignature{function_type->param_types,
+                          function_type->result_types};
   }
 }
 
@@ -259,8 +280,9 @@ Function MaybeDefault(optional<Function> value) {
   return value.value_or(Function{0});
 }
 
-FunctionType MaybeDefault(optional<FunctionType> value) {
-  return value.value_or(FunctionType{});
+const StackFunctionType& MaybeDefault(const StackFunctionType* value) {
+  static const StackFunctionType empty;
+  return value ? *value : empty;
 }
 
 TableType MaybeDefault(optional<TableType> value) {
@@ -335,10 +357,10 @@ Label* GetFunctionLabel(ValidCtx&);
 
 bool CheckResultTypes(ValidCtx& ctx,
                       Location loc,
-                      const FunctionType& function_type) {
+                      const StackFunctionType& function_type) {
   auto* label = GetFunctionLabel(ctx);
   assert(label != nullptr);
-  auto caller = ToStackTypeList(function_type.result_types);
+  StackTypeSpan caller = function_type.result_types;
   auto callee = label->br_types();
 
   if (!IsMatch(ctx, callee, caller)) {
@@ -439,17 +461,17 @@ auto PopTypedReference(ValidCtx& ctx, Location loc)
 }
 
 auto PopFunctionReference(ValidCtx& ctx, Location loc)
-    -> std::pair<optional<StackType>, std::optional<FunctionType>> {
+    -> std::pair<optional<StackType>, const StackFunctionType*> {
   auto [stack_type, index] = PopTypedReference(ctx, loc);
   if (stack_type && !stack_type->is_any() && index) {
-    return {stack_type, GetFunctionType(ctx, *index)};
+    return {stack_type, GetStackFunctionType(ctx, *index)};
   } else {
-    return {stack_type, nullopt};
+    return {stack_type, nullptr};
   }
 }
 
 auto PopStructReference(ValidCtx& ctx, Location loc, const At<Index>& expected)
-    -> std::pair<optional<StackType>, std::optional<StructType>> {
+    -> std::pair<optional<StackType>, const StructType*> {
   auto [stack_type, index] = PopTypedReference(ctx, loc);
   if (stack_type) {
     if (index && !IsMatch(ctx, HeapType{expected}, HeapType{*index})) {
@@ -460,12 +482,12 @@ auto PopStructReference(ValidCtx& ctx, Location loc, const At<Index>& expected)
     }
     return {stack_type, GetStructType(ctx, expected)};
   } else {
-    return {stack_type, nullopt};
+    return {stack_type, nullptr};
   }
 }
 
 auto PopArrayReference(ValidCtx& ctx, Location loc, const At<Index>& expected)
-    -> std::pair<optional<StackType>, std::optional<ArrayType>> {
+    -> std::pair<optional<StackType>, const ArrayType*> {
   auto [stack_type, index] = PopTypedReference(ctx, loc);
   if (stack_type) {
     if (index && !IsMatch(ctx, HeapType{expected}, HeapType{*index})) {
@@ -476,7 +498,7 @@ auto PopArrayReference(ValidCtx& ctx, Location loc, const At<Index>& expected)
     }
     return {stack_type, GetArrayType(ctx, expected)};
   } else {
-    return {stack_type, nullopt};
+    return {stack_type, nullptr};
   }
 }
 
@@ -491,9 +513,9 @@ bool PopAndPushTypes(ValidCtx& ctx,
 
 bool PopAndPushTypes(ValidCtx& ctx,
                      Location loc,
-                     const FunctionType& function_type) {
-  return PopAndPushTypes(ctx, loc, ToStackTypeList(function_type.param_types),
-                         ToStackTypeList(function_type.result_types));
+                     const StackFunctionType& function_type) {
+  return PopAndPushTypes(ctx, loc, function_type.param_types,
+                         function_type.result_types);
 }
 
 void SetUnreachable(ValidCtx& ctx) {
@@ -521,14 +543,11 @@ Label* GetFunctionLabel(ValidCtx& ctx) {
 bool PushLabel(ValidCtx& ctx,
                Location loc,
                LabelType label_type,
-               const FunctionType& type) {
-  auto stack_param_types = ToStackTypeList(type.param_types);
-  auto stack_result_types = ToStackTypeList(type.result_types);
-  bool valid = PopTypes(ctx, loc, stack_param_types);
-  ctx.label_stack.emplace_back(label_type, stack_param_types,
-                               stack_result_types,
+               const BlockSignature& sig) {
+  bool valid = PopTypes(ctx, loc, sig.param_types);
+  ctx.label_stack.emplace_back(label_type, sig.param_types, sig.result_types,
                                static_cast<Index>(ctx.type_stack.size()));
-  PushTypes(ctx, stack_param_types);
+  PushTypes(ctx, sig.param_types);
   return valid;
 }
 
@@ -555,7 +574,8 @@ bool CheckTypeStackEmpty(ValidCtx& ctx, Location loc) {
 
 bool Catch(ValidCtx& ctx, Location loc, At<Index> index) {
   auto tag_type = GetTagType(ctx, index);
-  auto function_type = GetFunctionType(ctx, MaybeDefault(tag_type).type_index);
+  auto* function_type =
+      GetStackFunctionType(ctx, MaybeDefault(tag_type).type_index);
   auto& top_label = TopLabel(ctx);
   bool valid = true;
   if (top_label.label_type != LabelType::Try &&
@@ -566,7 +586,7 @@ bool Catch(ValidCtx& ctx, Location loc, At<Index> index) {
   valid &= PopTypes(ctx, loc, top_label.result_types);
   valid &= CheckTypeStackEmpty(ctx, loc);
   ResetTypeStackToLimit(ctx);
-  PushTypes(ctx, ToStackTypeList(MaybeDefault(function_type).param_types));
+  PushTypes(ctx, MaybeDefault(function_type).param_types);
   top_label.label_type = LabelType::Catch;
   top_label.unreachable = false;
   return valid;
@@ -685,7 +705,8 @@ bool BrTable(ValidCtx& ctx,
 
 bool Call(ValidCtx& ctx, Location loc, At<Index> function_index) {
   auto function = GetFunction(ctx, function_index);
-  auto function_type = GetFunctionType(ctx, MaybeDefault(function).type_index);
+  auto* function_type =
+      GetStackFunctionType(ctx, MaybeDefault(function).type_index);
   return AllTrue(function, function_type,
                  PopAndPushTypes(ctx, loc, MaybeDefault(function_type)));
 }
@@ -694,7 +715,7 @@ bool CallIndirect(ValidCtx& ctx,
                   Location loc,
                   const At<CallIndirectImmediate>& immediate) {
   auto table_type = GetTableType(ctx, immediate->table_index);
-  auto function_type = GetFunctionType(ctx, immediate->index);
+  auto* function_type = GetStackFunctionType(ctx, immediate->index);
   bool valid = PopType(ctx, loc, StackType::I32());
   return AllTrue(table_type, function_type, valid,
                  PopAndPushTypes(ctx, loc, MaybeDefault(function_type)));
@@ -1227,10 +1248,10 @@ bool AtomicRmw(ValidCtx& ctx,
 
 bool ReturnCall(ValidCtx& ctx, Location loc, At<Index> function_index) {
   auto function = GetFunction(ctx, function_index);
-  auto function_type = GetFunctionType(ctx, MaybeDefault(function).type_index);
+  auto* function_type =
+      GetStackFunctionType(ctx, MaybeDefault(function).type_index);
   bool valid = CheckResultTypes(ctx, loc, MaybeDefault(function_type));
-  valid &= PopTypes(ctx, loc,
-                    ToStackTypeList(MaybeDefault(function_type).param_types));
+  valid &= PopTypes(ctx, loc, MaybeDefault(function_type).param_types);
   SetUnreachable(ctx);
   return AllTrue(function, function_type, valid);
 }
@@ -1239,20 +1260,19 @@ bool ReturnCallIndirect(ValidCtx& ctx,
                         Location loc,
                         const At<CallIndirectImmediate>& immediate) {
   auto table_type = GetTableType(ctx, 0);
-  auto function_type = GetFunctionType(ctx, immediate->index);
+  auto* function_type = GetStackFunctionType(ctx, immediate->index);
   bool valid = CheckResultTypes(ctx, loc, MaybeDefault(function_type));
   valid &= PopType(ctx, loc, StackType::I32());
-  valid &= PopTypes(ctx, loc,
-                    ToStackTypeList(MaybeDefault(function_type).param_types));
+  valid &= PopTypes(ctx, loc, MaybeDefault(function_type).param_types);
   SetUnreachable(ctx);
   return AllTrue(table_type, function_type, valid);
 }
 
 bool Throw(ValidCtx& ctx, Location loc, At<Index> index) {
   auto tag_type = GetTagType(ctx, index);
-  auto function_type = GetFunctionType(ctx, MaybeDefault(tag_type).type_index);
-  bool valid = PopTypes(
-      ctx, loc, ToStackTypeList(MaybeDefault(function_type).param_types));
+  auto* function_type =
+      GetStackFunctionType(ctx, MaybeDefault(tag_type).type_index);
+  bool valid = PopTypes(ctx, loc, MaybeDefault(function_type).param_types);
   SetUnreachable(ctx);
   return AllTrue(tag_type, function_type, valid);
 }
@@ -1292,7 +1312,7 @@ bool BrOnNonNull(ValidCtx& ctx, Location loc, const At<Index>& depth) {
 
   const auto* label = GetLabel(ctx, depth);
   auto label_ = MaybeDefault(label);
-  auto& label_types = label_.br_types();
+  auto label_types = label_.br_types();
 
   // BrOnNonNull is [t* (ref null ht)] => [t*],
   //   where label is [t* (ref ht)]
@@ -1357,15 +1377,14 @@ bool ReturnCallRef(ValidCtx& ctx, Location loc) {
   }
 
   bool valid = CheckResultTypes(ctx, loc, MaybeDefault(function_type));
-  valid &= PopTypes(ctx, loc,
-                    ToStackTypeList(MaybeDefault(function_type).param_types));
+  valid &= PopTypes(ctx, loc, MaybeDefault(function_type).param_types);
   SetUnreachable(ctx);
   return AllTrue(function_type, valid);
 }
 
 bool FuncBind(ValidCtx& ctx, Location loc, At<FuncBindImmediate> immediate) {
   auto new_type_index = immediate->index;
-  auto [stack_type, old_function_type] = PopFunctionReference(ctx, loc);
+  auto [stack_type, old_type_index] = PopTypedReference(ctx, loc);
   if (!stack_type) {
     return false;
   }
@@ -1376,7 +1395,9 @@ bool FuncBind(ValidCtx& ctx, Location loc, At<FuncBindImmediate> immediate) {
     return true;
   }
 
-  auto new_function_type = GetFunctionType(ctx, new_type_index);
+  auto* old_function_type =
+      old_type_index ? GetFunctionType(ctx, *old_type_index) : nullptr;
+  auto* new_function_type = GetFunctionType(ctx, new_type_index);
   if (!old_function_type || !new_function_type) {
     return false;
   }
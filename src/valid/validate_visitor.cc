@@ -16,13 +16,103 @@
 
 #include "wasp/valid/validate_visitor.h"
 
+#include <algorithm>
 #include <cassert>
+#include <functional>
+#include <vector>
+
+#include "wasp/base/errors_buffer.h"
+#include "wasp/base/parallel_for.h"
+#include "wasp/binary/lazy_expression.h"
+#include "wasp/binary/read.h"
+#include "wasp/binary/read/read_ctx.h"
 
 namespace wasp::valid {
 
+namespace {
+
+bool Contains(SpanU8 outer, SpanU8 inner) {
+  return std::less_equal<>{}(outer.begin(), inner.begin()) &&
+         std::less_equal<>{}(inner.end(), outer.end());
+}
+
+struct CodeResult {
+  ErrorsBuffer errors;
+  bool valid = true;
+};
+
+// Validate a single function body, the same way that binary::visit::Visit
+// and ValidateVisitor would.
+bool ValidateCode(ValidCtx& ctx, const At<binary::Code>& code) {
+  if (!(BeginCode(ctx, code.loc()) &&
+        Validate(ctx, code->locals, RequireDefaultable::Yes))) {
+    return false;
+  }
+
+  binary::ReadCtx read_ctx{ctx.features, *ctx.errors};
+  read_ctx.declared_data_count = ctx.declared_data_count;
+  for (auto&& instr : binary::ReadExpression(*code->body, read_ctx)) {
+    if (!Validate(ctx, instr)) {
+      return false;
+    }
+  }
+  binary::EndCode(code->body->data.last(0), read_ctx);
+  return true;
+}
+
+bool ValidateCodes(ValidCtx& ctx,
+                   const std::vector<At<binary::Code>>& codes,
+                   Index num_threads) {
+  Index count = static_cast<Index>(codes.size());
+  Index first_code_count = ctx.code_count;
+  std::vector<CodeResult> results(count);
+
+  // Each worker gets its own copy of the module-level state; only the
+  // function-level state (locals, type stack, label stack) is modified.
+  std::vector<ValidCtx> worker_ctxs;
+  worker_ctxs.reserve(std::min(num_threads, count));
+  for (Index i = 0; i < std::min(num_threads, count); ++i) {
+    worker_ctxs.emplace_back(ctx, *ctx.errors);
+  }
+
+  ParallelFor(count, num_threads, [&](Index worker, Index index) {
+    ValidCtx& worker_ctx = worker_ctxs[worker];
+    CodeResult& result = results[index];
+    worker_ctx.errors = &result.errors;
+    worker_ctx.code_count = first_code_count + index;
+    result.valid = ValidateCode(worker_ctx, codes[index]);
+  });
+
+  // Report the errors in function order. Sequential validation stops at the
+  // first invalid function, so do the same here.
+  ctx.code_count = first_code_count + count;
+  for (const auto& result : results) {
+    result.errors.ReplayTo(*ctx.errors);
+    if (!result.valid) {
+      return false;
+    }
+  }
+  return true;
+}
+
+}  // namespace
+
 ValidateVisitor::ValidateVisitor(Features features, Errors& errors)
     : ctx{features, errors}, features{features}, errors{errors} {}
 
+ValidateVisitor::ValidateVisitor(Features features,
+                                 Errors& errors,
+                                 Index num_threads)
+    : ctx{features, errors},
+      features{features},
+      errors{errors},
+      num_threads{num_threads} {}
+
+auto ValidateVisitor::BeginModule(binary::LazyModule& module) -> Result {
+  module_data = module.data;
+  return Result::Ok;
+}
+
 auto ValidateVisitor::BeginTypeSection(binary::LazyTypeSection sec) -> Result {
   return FailUnless(valid::BeginTypeSection(ctx, sec.count.value_or(0)));
 }
@@ -80,6 +170,33 @@ auto ValidateVisitor::OnDataCount(const At<binary::DataCount>& data_count)
 }
 
 auto ValidateVisitor::BeginCode(const At<binary::Code>& code) -> Result {
+  if (num_threads > 1) {
+    // Validated in EndCodeSection instead, or sooner if the copies get large.
+    if (pending_codes.empty() && !errors.HasError()) {
+      // No errors refer to the previous batch's copies, so they can go.
+      pending_code_copies.clear();
+      pending_copy_size = 0;
+    }
+    if (Contains(module_data, code.loc())) {
+      pending_codes.push_back(code);
+    } else {
+      // The body may be gone by the end of the code section, so read it again
+      // from a copy.
+      pending_code_copies.push_back(ToBuffer(code.loc()));
+      pending_copy_size += code.loc().size();
+      SpanU8 data = pending_code_copies.back();
+      binary::ReadCtx read_ctx{features, errors};
+      auto copy = binary::Read<binary::Code>(&data, read_ctx);
+      assert(copy.has_value());
+      pending_codes.push_back(*copy);
+      if (pending_copy_size >= max_pending_copy_size) {
+        if (!ValidatePendingCodes()) {
+          return Result::Fail;
+        }
+      }
+    }
+    return Result::Skip;
+  }
   return FailUnless(valid::BeginCode(ctx, code.loc()) &&
                     Validate(ctx, code->locals, RequireDefaultable::Yes));
 }
@@ -89,10 +206,23 @@ auto ValidateVisitor::OnInstruction(const At<binary::Instruction>& instruction)
   return FailUnless(Validate(ctx, instruction));
 }
 
+auto ValidateVisitor::EndCodeSection(binary::LazyCodeSection) -> Result {
+  return FailUnless(ValidatePendingCodes());
+}
+
 auto ValidateVisitor::OnData(const At<binary::DataSegment>& segment) -> Result {
   return FailUnless(Validate(ctx, segment));
 }
 
+bool ValidateVisitor::ValidatePendingCodes() {
+  if (pending_codes.empty()) {
+    return true;
+  }
+  bool valid = ValidateCodes(ctx, pending_codes, num_threads);
+  pending_codes.clear();
+  return valid;
+}
+
 auto ValidateVisitor::FailUnless(bool b) -> Result {
   return b ? Result::Ok : Result::Fail;
 }
@@ -0,0 +1,128 @@
+//
+// Copyright 2020 WebAssembly Community Group participants
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//     http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+//
+
+#include "wasp/base/arena.h"
+
+#include <string>
+#include <vector>
+
+#include "gtest/gtest.h"
+#include "wasp/base/buffer.h"
+
+using namespace ::wasp;
+
+TEST(ArenaTest, Add) {
+  Arena arena;
+  std::string str = "hello";
+  auto copy = arena.Add(string_view{str});
+  str = "HELLO";
+  EXPECT_EQ("hello", copy);
+  EXPECT_EQ(5u, arena.size());
+
+  Buffer buffer{1, 2, 3};
+  auto bytes = arena.Add(SpanU8{buffer});
+  buffer[0] = 0;
+  EXPECT_EQ((Buffer{1, 2, 3}), Buffer(bytes.begin(), bytes.end()));
+  EXPECT_EQ(8u, arena.size());
+}
+
+TEST(ArenaTest, AddEmpty) {
+  Arena arena;
+  EXPECT_EQ("", arena.Add(""_sv));
+  EXPECT_EQ(0u, arena.chunk_count());
+}
+
+TEST(ArenaTest, StableAddresses) {
+  Arena arena{16};
+  std::vector<string_view> copies;
+  for (int i = 0; i < 100; ++i) {
+    auto str = std::to_string(i);
+    copies.push_back(arena.Add(string_view{str}));
+  }
+  for (int i = 0; i < 100; ++i) {
+    EXPECT_EQ(std::to_string(i), copies[i]);
+  }
+  // Many small copies share each chunk.
+  EXPECT_LT(arena.chunk_count(), 20u);
+}
+
+TEST(ArenaTest, LargeCopy) {
+  Arena arena{16};
+  auto small = arena.Add("abc"_sv);
+  auto large = arena.Add("0123456789abcdefghij"_sv);
+  auto small2 = arena.Add("def"_sv);
+  EXPECT_EQ("abc", small);
+  EXPECT_EQ("0123456789abcdefghij", large);
+  EXPECT_EQ("def", small2);
+  // The large copy gets its own chunk, and the current one is still used.
+  EXPECT_EQ(2u, arena.chunk_count());
+  EXPECT_EQ(small.data() + 3, small2.data());
+}
+
+TEST(ArenaTest, Intern) {
+  Arena arena;
+  auto env1 = arena.Intern("env"_sv);
+  auto env2 = arena.Intern("env"_sv);
+  auto other = arena.Intern("other"_sv);
+  EXPECT_EQ(env1.data(), env2.data());
+  EXPECT_EQ("other", other);
+  EXPECT_EQ(8u, arena.size());
+
+  // Add never returns an interned copy.
+  EXPECT_NE(env1.data(), arena.Add("env"_sv).data());
+}
+
+TEST(ArenaTest, Clear) {
+  Arena arena{16};
+  arena.Add("0123456789abcdefghij"_sv);
+  auto first = arena.Intern("abc"_sv);
+  arena.Clear();
+  EXPECT_EQ(0u, arena.size());
+  EXPECT_EQ(1u, arena.chunk_count());
+
+  // The remaining chunk is reused from the start, and interned strings are
+  // forgotten.
+  auto second = arena.Intern("def"_sv);
+  EXPECT_EQ(first.data(), second.data());
+  EXPECT_EQ("def", arena.Intern("def"_sv));
+}
+
+TEST(ArenaTest, Move) {
+  Arena arena{16};
+  auto abc = arena.Intern("abc"_sv);
+
+  Arena moved{std::move(arena)};
+  EXPECT_EQ("abc", abc);
+  EXPECT_EQ(abc.data(), moved.Intern("abc"_sv).data());
+  EXPECT_EQ(3u, moved.size());
+  EXPECT_EQ(1u, moved.chunk_count());
+
+  // The moved-from arena starts over with chunks of its own, rather than
+  // writing into the moved arena's current chunk.
+  EXPECT_EQ(0u, arena.size());
+  EXPECT_EQ(0u, arena.chunk_count());
+  auto def = arena.Add("def"_sv);
+  auto ghi = moved.Add("ghi"_sv);
+  EXPECT_EQ("def", def);
+  EXPECT_EQ("ghi", ghi);
+  EXPECT_EQ(abc.data() + 3, ghi.data());
+
+  arena = std::move(moved);
+  EXPECT_EQ(6u, arena.size());
+  EXPECT_EQ(0u, moved.size());
+  EXPECT_EQ(0u, moved.chunk_count());
+  EXPECT_EQ(abc.data(), arena.Intern("abc"_sv).data());
+}
@@ -0,0 +1,98 @@
+//
+// Copyright 2020 WebAssembly Community Group participants
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//     http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+//
+
+#include "wasp/base/errors.h"
+
+#include <string>
+#include <vector>
+
+#include "gtest/gtest.h"
+#include "wasp/base/errors_context_guard.h"
+
+using namespace ::wasp;
+
+namespace {
+
+class LogErrors : public Errors {
+ public:
+  bool HasError() const override { return false; }
+
+  std::vector<std::string> log;
+
+ protected:
+  void HandlePushContext(Location loc, string_view desc) override {
+    log.push_back("push " + std::string{desc});
+  }
+  void HandlePopContext() override { log.push_back("pop"); }
+  void HandleOnError(Location loc, string_view message) override {
+    log.push_back("error " + std::string{message});
+  }
+};
+
+}  // namespace
+
+TEST(ErrorsTest, ContextGuard_NoError) {
+  LogErrors errors;
+  {
+    ErrorsContextGuard outer{errors, {}, "outer"};
+    ErrorsContextGuard inner{errors, {}, "inner"};
+  }
+  EXPECT_EQ((std::vector<std::string>{}), errors.log);
+}
+
+TEST(ErrorsTest, ContextGuard_Error) {
+  LogErrors errors;
+  {
+    ErrorsContextGuard outer{errors, {}, "outer"};
+    {
+      ErrorsContextGuard unused{errors, {}, "unused"};
+    }
+    ErrorsContextGuard inner{errors, {}, "inner"};
+    errors.OnError({}, "1");
+    errors.OnError({}, "2");
+  }
+  EXPECT_EQ((std::vector<std::string>{"push outer", "push inner", "error 1",
+                                      "error 2", "pop", "pop"}),
+            errors.log);
+}
+
+TEST(ErrorsTest, ContextGuard_PopContext) {
+  LogErrors errors;
+  {
+    ErrorsContextGuard outer{errors, {}, "outer"};
+    ErrorsContextGuard inner{errors, {}, "inner"};
+    inner.PopContext();
+    errors.OnError({}, "1");
+  }
+  EXPECT_EQ((std::vector<std::string>{"push outer", "error 1", "pop"}),
+            errors.log);
+}
+
+TEST(ErrorsTest, ContextGuard_MixedWithPushContext) {
+  LogErrors errors;
+  {
+    ErrorsContextGuard outer{errors, {}, "outer"};
+    errors.PushContext({}, "eager");
+    {
+      ErrorsContextGuard inner{errors, {}, "inner"};
+      errors.OnError({}, "1");
+    }
+    errors.PopContext();
+  }
+  EXPECT_EQ((std::vector<std::string>{"push outer", "push eager", "push inner",
+                                      "error 1", "pop", "pop", "pop"}),
+            errors.log);
+}
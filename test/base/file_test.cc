@@ -0,0 +1,111 @@
+//
+// Copyright 2020 WebAssembly Community Group participants
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//     http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+//
+
+#include "wasp/base/file.h"
+
+#include <fstream>
+#include <string>
+#include <thread>
+#include <utility>
+
+#include "gtest/gtest.h"
+
+#if !defined(_WIN32)
+#include <sys/stat.h>
+#include <unistd.h>
+#endif
+
+using namespace ::wasp;
+
+namespace {
+
+std::string WriteTempFile(string_view name, SpanU8 contents) {
+  std::string filename = testing::TempDir() + std::string{name};
+  std::ofstream stream{filename, std::ios::out | std::ios::binary};
+  stream.write(reinterpret_cast<const char*>(contents.data()),
+               contents.size());
+  return filename;
+}
+
+}  // namespace
+
+TEST(FileTest, ReadFile) {
+  auto filename = WriteTempFile("wasp_read_file", "\0asm\x01\0\0\0"_su8);
+  auto optbuf = ReadFile(filename);
+  ASSERT_TRUE(optbuf.has_value());
+  EXPECT_EQ((Buffer{0, 'a', 's', 'm', 1, 0, 0, 0}), *optbuf);
+}
+
+TEST(FileTest, MapFile) {
+  auto filename = WriteTempFile("wasp_map_file", "\0asm\x01\0\0\0"_su8);
+  auto optfile = MapFile(filename);
+  ASSERT_TRUE(optfile.has_value());
+  EXPECT_EQ("\0asm\x01\0\0\0"_su8, optfile->data());
+}
+
+TEST(FileTest, MapFile_Move) {
+  auto filename = WriteTempFile("wasp_map_file_move", "hello"_su8);
+  auto optfile = MapFile(filename);
+  ASSERT_TRUE(optfile.has_value());
+
+  MappedFile file = std::move(*optfile);
+  EXPECT_EQ("hello"_su8, file.data());
+  EXPECT_TRUE(optfile->data().empty());
+  EXPECT_FALSE(optfile->is_mapped());
+}
+
+TEST(FileTest, MapFile_Empty) {
+  auto filename = WriteTempFile("wasp_map_file_empty", SpanU8{});
+  auto optfile = MapFile(filename);
+  ASSERT_TRUE(optfile.has_value());
+  EXPECT_TRUE(optfile->data().empty());
+}
+
+TEST(FileTest, MapFile_Buffer) {
+  MappedFile file{Buffer{1, 2, 3}};
+  EXPECT_FALSE(file.is_mapped());
+  EXPECT_EQ(3u, file.data().size());
+}
+
+TEST(FileTest, MapFile_Missing) {
+  EXPECT_FALSE(MapFile(testing::TempDir() + "wasp_no_such_file").has_value());
+}
+
+#if !defined(_WIN32)
+TEST(FileTest, MapFile_Pipe) {
+  std::string filename = testing::TempDir() + "wasp_map_file_pipe";
+  unlink(filename.c_str());
+  ASSERT_EQ(0, mkfifo(filename.c_str(), 0600));
+
+  // More than a pipe's buffer, so the writer blocks until it is read.
+  Buffer contents(256 * 1024);
+  for (size_t i = 0; i < contents.size(); ++i) {
+    contents[i] = static_cast<u8>(i * 7);
+  }
+  std::thread writer{[&]() {
+    std::ofstream stream{filename, std::ios::out | std::ios::binary};
+    stream.write(reinterpret_cast<const char*>(contents.data()),
+                 contents.size());
+  }};
+
+  auto optfile = MapFile(filename);
+  writer.join();
+  unlink(filename.c_str());
+  ASSERT_TRUE(optfile.has_value());
+  EXPECT_FALSE(optfile->is_mapped());
+  EXPECT_EQ(SpanU8{contents}, optfile->data());
+}
+#endif
@@ -16,7 +16,11 @@
 
 #include "wasp/base/utf8.h"
 
+#include <algorithm>
 #include <cassert>
+#include <cstring>
+#include <string>
+#include <vector>
 
 #include "gtest/gtest.h"
 
@@ -169,3 +173,83 @@ TEST(Utf8Test, invalid_4_bytes) {
     assert_is_valid_utf8(false, 4, cu0, 0x80, 0x80, 0x80);
   }
 }
+
+namespace {
+
+// Some sequences, valid and invalid, to place at every offset of a longer
+// string. The SIMD validators process 16 or 32 bytes at a time, so this
+// checks sequences that straddle two blocks, and that end the string early.
+const char* const kSequences[] = {
+    "\xc3\xa9",         "\xe6\x97\xa5",     "\xf0\x9f\x98\x80",
+    "\xf4\x8f\xbf\xbf", "\x80",             "\xbf\x80",
+    "\xc1\xbf",         "\xc3",             "\xe0\x9f\xbf",
+    "\xe0\xa0",         "\xed\xa0\x80",     "\xef\xbf",
+    "\xf0\x8f\xbf\xbf", "\xf4\x90\x80\x80", "\xf5\x80\x80\x80",
+    "\xf0\x90\x80",     "\xff",             "\xc3\xa9\xa9",
+};
+
+std::vector<Utf8Validator> SupportedValidators() {
+  std::vector<Utf8Validator> result;
+  for (auto validator :
+       {Utf8Validator::Portable, Utf8Validator::Sse41, Utf8Validator::Avx2}) {
+    if (IsSupported(validator)) {
+      result.push_back(validator);
+    }
+  }
+  return result;
+}
+
+}  // end anonymous namespace
+
+TEST(Utf8Test, validators_agree_at_every_offset) {
+  for (auto validator : SupportedValidators()) {
+    for (const char* sequence : kSequences) {
+      for (size_t length : {16, 31, 32, 33, 64, 70}) {
+        for (size_t offset = 0; offset < length; ++offset) {
+          std::string s(length, 'a');
+          std::memcpy(&s[offset], sequence,
+                      std::min(strlen(sequence), length - offset));
+          EXPECT_EQ(IsValidUtf8(s, Utf8Validator::Portable),
+                    IsValidUtf8(s, validator))
+              << "validator " << static_cast<int>(validator) << ", offset "
+              << offset << ", length " << length;
+        }
+      }
+    }
+  }
+}
+
+TEST(Utf8Test, validators_long_strings) {
+  std::string valid;
+  for (int i = 0; i < 100; ++i) {
+    valid += "_ZN4core3fmt9Formatter3pad17h";
+    valid += "\xc3\xa9\xe6\x97\xa5\xf0\x9f\x98\x80";
+  }
+  for (auto validator : SupportedValidators()) {
+    EXPECT_TRUE(IsValidUtf8(valid, validator));
+    for (size_t i = 0; i < valid.size(); i += 7) {
+      std::string invalid = valid;
+      invalid[i] = '\xff';
+      EXPECT_FALSE(IsValidUtf8(invalid, validator)) << i;
+    }
+  }
+}
+
+TEST(Utf8Test, checker) {
+  Utf8Checker checker;
+  EXPECT_TRUE(checker.IsValid());
+
+  // U+65E5, split between a string and single bytes.
+  checker.Append("abc\xe6"_sv);
+  EXPECT_FALSE(checker.IsValid());
+  checker.Append(u8{0x97});
+  EXPECT_FALSE(checker.IsValid());
+  checker.Append(u8{0xa5});
+  EXPECT_TRUE(checker.IsValid());
+
+  // Once invalid, always invalid.
+  checker.Append(u8{0x80});
+  EXPECT_FALSE(checker.IsValid());
+  checker.Append("abc"_sv);
+  EXPECT_FALSE(checker.IsValid());
+}
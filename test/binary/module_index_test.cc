@@ -0,0 +1,189 @@
+//
+// Copyright 2019 WebAssembly Community Group participants
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//     http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+//
+
+#include "wasp/binary/module_index.h"
+
+#include <cstring>
+
+#include "gtest/gtest.h"
+#include "test/binary/constants.h"
+#include "test/test_utils.h"
+#include "wasp/binary/read/read_ctx.h"
+
+using namespace ::wasp;
+using namespace ::wasp::binary;
+using namespace ::wasp::binary::test;
+using namespace ::wasp::test;
+
+namespace {
+
+SpanU8 GetModuleData() {
+  return "\0asm\x01\0\0\0"
+         "\x01\x04\x01\x60\0\0"          // 1 type: params:[] results:[]
+         "\x02\x0b\x01\0\x06import\0\0"  // 1 import: func mod:"" name:"import"
+         "\x03\x03\x02\0\0"              // 2 funcs: type 0, type 0
+         "\x07\x0a\x01\x06"
+         "export\0\x01"  // 1 export: func 1 name:"export"
+         "\x0a\x0a\x02"
+         "\x02\0\x0b"              // code 0: empty
+         "\x05\x01\x01\x7f\x01\x0b"  // code 1: 1 i32 local, nop
+         "\0\x10\x04name"            // "name" section
+         "\x01\x09\x01\x02\x06"
+         "custom"_su8;  // func 2, name "custom"
+}
+
+}  // namespace
+
+TEST(BinaryModuleIndexTest, Sections) {
+  Features features;
+  TestErrors errors;
+  auto module = ReadLazyModule(GetModuleData(), features, errors);
+  auto index = IndexModule(module);
+
+  ASSERT_EQ(6u, index.sections.size());
+  EXPECT_EQ(SectionId::Type, index.sections[0]->id());
+  EXPECT_EQ(SectionId::Code, index.sections[4]->id());
+  EXPECT_TRUE(index.sections[5]->is_custom());
+
+  auto code_section = index.FindSection(SectionId::Code);
+  ASSERT_TRUE(code_section.has_value());
+  EXPECT_EQ(index.sections[4].loc(), code_section->loc());
+  EXPECT_FALSE(index.FindSection(SectionId::Data).has_value());
+  ExpectNoErrors(errors);
+}
+
+TEST(BinaryModuleIndexTest, Counts) {
+  Features features;
+  TestErrors errors;
+  auto module = ReadLazyModule(GetModuleData(), features, errors);
+  auto index = IndexModule(module);
+
+  EXPECT_EQ(1u, index.GetImportCount(ExternalKind::Function));
+  EXPECT_EQ(0u, index.GetImportCount(ExternalKind::Table));
+  EXPECT_EQ(0u, index.GetImportCount(ExternalKind::Memory));
+  EXPECT_EQ(0u, index.GetImportCount(ExternalKind::Global));
+  EXPECT_EQ(0u, index.GetImportCount(ExternalKind::Tag));
+  EXPECT_EQ(3u, index.GetFunctionCount());
+  EXPECT_EQ(2u, index.codes.size());
+  ExpectNoErrors(errors);
+}
+
+TEST(BinaryModuleIndexTest, FunctionNames) {
+  Features features;
+  TestErrors errors;
+  auto module = ReadLazyModule(GetModuleData(), features, errors);
+  auto index = IndexModule(module);
+
+  EXPECT_EQ((std::vector<IndexNamePair>{
+                {0, "import"}, {1, "export"}, {2, "custom"}}),
+            index.function_names);
+  EXPECT_EQ(0u, index.FindFunction("import"));
+  EXPECT_EQ(1u, index.FindFunction("export"));
+  EXPECT_EQ(2u, index.FindFunction("custom"));
+  EXPECT_EQ(nullopt, index.FindFunction("missing"));
+  ExpectNoErrors(errors);
+}
+
+TEST(BinaryModuleIndexTest, GetCode) {
+  Features features;
+  TestErrors errors;
+  auto module = ReadLazyModule(GetModuleData(), features, errors);
+  auto index = IndexModule(module);
+
+  // Read out of order; function 0 is imported.
+  auto code2 = index.GetCode(2, module.ctx);
+  ASSERT_TRUE(code2.has_value());
+  ASSERT_EQ(1u, (*code2)->locals.size());
+  EXPECT_EQ(1u, (*code2)->locals[0]->count);
+  EXPECT_EQ(VT_I32, (*code2)->locals[0]->type);
+  EXPECT_EQ("\x01\x0b"_su8, (*code2)->body->data);
+
+  auto code1 = index.GetCode(1, module.ctx);
+  ASSERT_TRUE(code1.has_value());
+  EXPECT_TRUE((*code1)->locals.empty());
+  EXPECT_EQ("\x0b"_su8, (*code1)->body->data);
+
+  EXPECT_EQ(nullopt, index.GetCode(0, module.ctx));
+  EXPECT_EQ(nullopt, index.GetCode(3, module.ctx));
+  EXPECT_EQ(0u, module.ctx.code_count);
+  ExpectNoErrors(errors);
+}
+
+TEST(BinaryModuleIndexTest, WriteRead) {
+  Features features;
+  TestErrors errors;
+  auto module = ReadLazyModule(GetModuleData(), features, errors);
+  auto expected = IndexModule(module);
+
+  Buffer buffer;
+  WriteModuleIndex(expected, module.data, buffer);
+  auto actual = ReadModuleIndex(buffer, module);
+  ASSERT_TRUE(actual.has_value());
+
+  ASSERT_EQ(expected.sections.size(), actual->sections.size());
+  for (size_t i = 0; i < expected.sections.size(); ++i) {
+    EXPECT_EQ(expected.sections[i].loc(), actual->sections[i].loc());
+    EXPECT_EQ(expected.sections[i]->id(), actual->sections[i]->id());
+    EXPECT_EQ(expected.sections[i]->data(), actual->sections[i]->data());
+  }
+  EXPECT_EQ(expected.imported_function_count, actual->imported_function_count);
+  EXPECT_EQ(expected.defined_function_count, actual->defined_function_count);
+  EXPECT_EQ(expected.codes, actual->codes);
+  EXPECT_EQ(expected.function_names, actual->function_names);
+  EXPECT_EQ(1u, actual->FindFunction("export"));
+
+  auto code = actual->GetCode(2, module.ctx);
+  ASSERT_TRUE(code.has_value());
+  EXPECT_EQ("\x01\x0b"_su8, (*code)->body->data);
+  ExpectNoErrors(errors);
+}
+
+TEST(BinaryModuleIndexTest, ReadRejectsOtherModule) {
+  Features features;
+  TestErrors errors;
+  auto module = ReadLazyModule(GetModuleData(), features, errors);
+
+  Buffer buffer;
+  WriteModuleIndex(IndexModule(module), module.data, buffer);
+
+  // Same size, different contents.
+  Buffer other_data{module.data.begin(), module.data.end()};
+  other_data.back() ^= 1;
+  auto other = ReadLazyModule(other_data, features, errors);
+  EXPECT_EQ(nullopt, ReadModuleIndex(buffer, other));
+  ExpectNoErrors(errors);
+}
+
+TEST(BinaryModuleIndexTest, ReadRejectsMalformedIndex) {
+  Features features;
+  TestErrors errors;
+  auto module = ReadLazyModule(GetModuleData(), features, errors);
+
+  Buffer buffer;
+  WriteModuleIndex(IndexModule(module), module.data, buffer);
+
+  for (size_t size = 0; size < buffer.size(); ++size) {
+    EXPECT_EQ(nullopt, ReadModuleIndex(SpanU8{buffer}.first(size), module))
+        << "size: " << size;
+  }
+
+  // Point the last function name past the end of the module.
+  Buffer bad{buffer};
+  u32 offset = static_cast<u32>(module.data.size());
+  memcpy(bad.data() + bad.size() - 8, &offset, sizeof(offset));
+  EXPECT_EQ(nullopt, ReadModuleIndex(bad, module));
+  ExpectNoErrors(errors);
+}
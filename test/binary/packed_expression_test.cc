@@ -0,0 +1,208 @@
+//
+// Copyright 2020 WebAssembly Community Group participants
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//     http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+//
+
+#include "wasp/binary/packed_expression.h"
+
+#include <limits>
+#include <vector>
+
+#include "gtest/gtest.h"
+#include "test/test_utils.h"
+#include "wasp/binary/lazy_expression.h"
+#include "wasp/binary/read/read_ctx.h"
+
+using namespace ::wasp;
+using namespace ::wasp::binary;
+using namespace ::wasp::test;
+
+using O = Opcode;
+using K = InstructionKind;
+
+namespace {
+
+// Reads `data` with both ReadExpression and ReadPackedExpression, and checks
+// that they decode the same opcodes and report the same errors.
+void ExpectSameAsLazy(SpanU8 data, const Features& features = Features{}) {
+  TestErrors lazy_errors;
+  ReadCtx lazy_ctx{features, lazy_errors};
+  std::vector<Opcode> lazy_opcodes;
+  for (const auto& instr : ReadExpression(data, lazy_ctx)) {
+    lazy_opcodes.push_back(instr->opcode);
+  }
+
+  TestErrors packed_errors;
+  ReadCtx packed_ctx{features, packed_errors};
+  PackedExpression expr;
+  bool ok = ReadPackedExpression(data, packed_ctx, &expr);
+  EXPECT_EQ(lazy_errors.errors.empty(), ok);
+
+  std::vector<Opcode> packed_opcodes;
+  for (const auto& instr : expr.instructions) {
+    packed_opcodes.push_back(instr.opcode());
+  }
+  EXPECT_EQ(lazy_opcodes, packed_opcodes);
+  ExpectErrors(lazy_errors.errors, packed_errors);
+}
+
+}  // namespace
+
+TEST(BinaryPackedExprTest, SimpleFunction) {
+  TestErrors errors;
+  ReadCtx ctx{errors};
+  PackedExpression expr;
+  // local.get 0
+  // local.get 1
+  // i32.add
+  // end
+  ASSERT_TRUE(ReadPackedExpression("\x20\x00\x20\x01\x6a\x0b"_su8, ctx, &expr,
+                                   RecordOffsets::Yes));
+  ExpectNoErrors(errors);
+  ASSERT_EQ(4u, expr.instructions.size());
+  EXPECT_EQ(O::LocalGet, expr.instructions[0].opcode());
+  EXPECT_EQ(K::Index, expr.instructions[0].kind);
+  EXPECT_EQ(0u, expr.instructions[0].index_immediate());
+  EXPECT_EQ(O::LocalGet, expr.instructions[1].opcode());
+  EXPECT_EQ(1u, expr.instructions[1].index_immediate());
+  EXPECT_EQ(O::I32Add, expr.instructions[2].opcode());
+  EXPECT_EQ(K::None, expr.instructions[2].kind);
+  EXPECT_EQ(O::End, expr.instructions[3].opcode());
+  EXPECT_EQ((std::vector<u32>{0, 2, 4, 5}), expr.offsets);
+}
+
+TEST(BinaryPackedExprTest, Constants) {
+  TestErrors errors;
+  ReadCtx ctx{errors};
+  PackedExpression expr;
+  // i32.const -1
+  // i64.const -0x8000_0000_0000_0000
+  // f32.const 1.0
+  // f64.const -2.0
+  ASSERT_TRUE(ReadPackedExpression(
+      "\x41\x7f"
+      "\x42\x80\x80\x80\x80\x80\x80\x80\x80\x80\x7f"
+      "\x43\x00\x00\x80\x3f"
+      "\x44\x00\x00\x00\x00\x00\x00\x00\xc0"_su8,
+      ctx, &expr));
+  ExpectNoErrors(errors);
+  ASSERT_EQ(4u, expr.instructions.size());
+  EXPECT_EQ(K::S32, expr.instructions[0].kind);
+  EXPECT_EQ(-1, expr.instructions[0].s32_immediate());
+  EXPECT_EQ(K::S64, expr.instructions[1].kind);
+  EXPECT_EQ(std::numeric_limits<s64>::min(),
+            expr.instructions[1].s64_immediate());
+  EXPECT_EQ(K::F32, expr.instructions[2].kind);
+  EXPECT_EQ(1.0f, expr.instructions[2].f32_immediate());
+  EXPECT_EQ(K::F64, expr.instructions[3].kind);
+  EXPECT_EQ(-2.0, expr.instructions[3].f64_immediate());
+  EXPECT_TRUE(expr.offsets.empty());
+}
+
+TEST(BinaryPackedExprTest, BrTable) {
+  TestErrors errors;
+  ReadCtx ctx{errors};
+  PackedExpression expr;
+  // br_table 3 4 5
+  ASSERT_TRUE(ReadPackedExpression("\x0e\x02\x03\x04\x05"_su8, ctx, &expr));
+  ExpectNoErrors(errors);
+  ASSERT_EQ(1u, expr.instructions.size());
+  const auto& instr = expr.instructions[0];
+  EXPECT_EQ(K::BrTable, instr.kind);
+  EXPECT_EQ(0u, instr.immediate[0]);
+  EXPECT_EQ(2u, instr.immediate[1]);
+  EXPECT_EQ((std::vector<Index>{3, 4, 5}), expr.br_table_targets);
+}
+
+TEST(BinaryPackedExprTest, SelectT) {
+  TestErrors errors;
+  Features features;
+  features.enable_reference_types();
+  ReadCtx ctx{features, errors};
+  PackedExpression expr;
+  // select (result i32)
+  ASSERT_TRUE(ReadPackedExpression("\x1c\x01\x7f"_su8, ctx, &expr));
+  ExpectNoErrors(errors);
+  ASSERT_EQ(1u, expr.instructions.size());
+  EXPECT_EQ(K::Select, expr.instructions[0].kind);
+  EXPECT_EQ(1u, expr.instructions[0].immediate[1]);
+  ASSERT_EQ(1u, expr.value_types.size());
+  ASSERT_TRUE(expr.value_types[0].is_numeric_type());
+  EXPECT_EQ(NumericType::I32, expr.value_types[0].numeric_type());
+}
+
+TEST(BinaryPackedExprTest, MemArg) {
+  TestErrors errors;
+  ReadCtx ctx{errors};
+  PackedExpression expr;
+  // i32.load align=4 offset=8
+  ASSERT_TRUE(ReadPackedExpression("\x28\x02\x08"_su8, ctx, &expr));
+  ExpectNoErrors(errors);
+  ASSERT_EQ(1u, expr.instructions.size());
+  const auto& instr = expr.instructions[0];
+  EXPECT_EQ(K::MemArg, instr.kind);
+  EXPECT_EQ(2u, instr.immediate[0]);
+  EXPECT_EQ(8u, instr.immediate[1]);
+  EXPECT_FALSE(instr.has_memory_index());
+}
+
+TEST(BinaryPackedExprTest, ReuseClearsSideTables) {
+  TestErrors errors;
+  ReadCtx ctx{errors};
+  PackedExpression expr;
+  ASSERT_TRUE(ReadPackedExpression("\x0e\x01\x00\x01"_su8, ctx, &expr));
+  ASSERT_TRUE(ReadPackedExpression("\x01"_su8, ctx, &expr));
+  EXPECT_EQ(1u, expr.instructions.size());
+  EXPECT_TRUE(expr.br_table_targets.empty());
+}
+
+TEST(BinaryPackedExprTest, MatchesLazyExpression) {
+  ExpectSameAsLazy("\x02\x40\x0e\x01\x00\x01\x0b\x0b"_su8);
+  ExpectSameAsLazy("\x41\x01\x41\x02\x1b\x1a\x0b"_su8);
+  ExpectSameAsLazy(
+      "\x3f\x00\x28\x02\x00\x42\x01\x37\x03\x08\x10\x00\x0b"_su8);
+
+  Features features;
+  features.enable_reference_types();
+  ExpectSameAsLazy("\x41\x01\x41\x02\x41\x00\x1c\x01\x7f\x1a\x0b"_su8,
+                   features);
+}
+
+TEST(BinaryPackedExprTest, MatchesLazyExpressionErrors) {
+  // Truncated immediates.
+  ExpectSameAsLazy("\x20"_su8);
+  ExpectSameAsLazy("\x41\x80"_su8);
+  ExpectSameAsLazy("\x42\x80\x80"_su8);
+  ExpectSameAsLazy("\x43\x00\x00"_su8);
+  ExpectSameAsLazy("\x44\x00\x00\x00"_su8);
+  ExpectSameAsLazy("\x28\x02"_su8);
+  // Non-zero reserved byte.
+  ExpectSameAsLazy("\x3f\x01"_su8);
+  // Instruction after the final end.
+  ExpectSameAsLazy("\x0b\x01"_su8);
+  ExpectSameAsLazy("\x0b\x20\x00"_su8);
+  // Truncated br_table targets.
+  ExpectSameAsLazy("\x0e\x02\x00"_su8);
+  // Missing br_table default target.
+  ExpectSameAsLazy("\x0e\x01\x00"_su8);
+  // select t* without the reference types feature.
+  ExpectSameAsLazy("\x1c\x01\x7f"_su8);
+
+  Features features;
+  features.enable_reference_types();
+  // Truncated select types.
+  ExpectSameAsLazy("\x1c\x02\x7f"_su8, features);
+  // Instruction after the final end.
+  ExpectSameAsLazy("\x0b\x0e\x00\x00"_su8, features);
+}
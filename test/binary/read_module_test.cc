@@ -17,6 +17,7 @@
 #include "wasp/binary/read.h"
 
 #include "gtest/gtest.h"
+#include "wasp/binary/packed_module.h"
 #include "test/binary/constants.h"
 #include "test/binary/test_utils.h"
 #include "test/test_utils.h"
@@ -30,10 +31,13 @@ using namespace ::wasp::binary::test;
 class BinaryReadModuleTest : public ::testing::Test {
  protected:
   void OK(const Module& expected, SpanU8 data) {
-    auto actual = ReadModule(data, ctx);
-    ExpectNoErrors(errors);
-    ASSERT_TRUE(actual.has_value());
-    EXPECT_EQ(expected, actual.value());
+    for (Index num_threads : {1, 4}) {
+      ReadCtx ctx{errors};
+      auto actual = ReadModule(data, ctx, num_threads);
+      ExpectNoErrors(errors);
+      ASSERT_TRUE(actual.has_value());
+      EXPECT_EQ(expected, actual.value()) << "num_threads: " << num_threads;
+    }
   }
 
   void Fail(const ExpectedError& error, SpanU8 data) {
@@ -151,3 +155,122 @@ TEST_F(BinaryReadModuleTest, BadTypeSection) {
        "\x01\x00"_su8  // Empty type section.
   );
 }
+
+TEST_F(BinaryReadModuleTest, PackedModule) {
+  auto data =
+      "\0asm\x01\0\0\0"
+      // type: (func (result i32))
+      "\x01\x05\x01\x60\x00\x01\x7f"
+      // func: (func (type 0)) (func (type 0))
+      "\x03\x03\x02\x00\x00"
+      // code: (func (type 0) i32.const 42)
+      //       (func (type 0) (local i32) local.get 0)
+      "\x0a\x0d\x02\x04\x00\x41\x2a\x0b\x06\x01\x01\x7f\x20\x00\x0b"_su8;
+  auto actual = ReadPackedModule(data, ctx, RecordOffsets::Yes);
+  ExpectNoErrors(errors);
+  ASSERT_TRUE(actual.has_value());
+  EXPECT_EQ(1u, actual->types.size());
+  EXPECT_EQ(2u, actual->functions.size());
+  ASSERT_EQ(2u, actual->codes.size());
+
+  const auto& code0 = *actual->codes[0];
+  EXPECT_EQ("\x41\x2a\x0b"_su8, code0.body);
+  EXPECT_EQ(0u, code0.locals_count);
+  EXPECT_EQ(0u, code0.first_instruction);
+  EXPECT_EQ(2u, code0.instruction_count);
+
+  const auto& code1 = *actual->codes[1];
+  EXPECT_EQ(0u, code1.first_locals);
+  EXPECT_EQ(1u, code1.locals_count);
+  EXPECT_EQ(2u, code1.first_instruction);
+  EXPECT_EQ(2u, code1.instruction_count);
+
+  ASSERT_EQ(1u, actual->locals.size());
+  EXPECT_EQ(1u, actual->locals[0]->count);
+
+  const auto& instrs = actual->code.instructions;
+  ASSERT_EQ(4u, instrs.size());
+  EXPECT_EQ(Opcode::I32Const, instrs[0].opcode());
+  EXPECT_EQ(42, instrs[0].s32_immediate());
+  EXPECT_EQ(Opcode::End, instrs[1].opcode());
+  EXPECT_EQ(Opcode::LocalGet, instrs[2].opcode());
+  EXPECT_EQ(0u, instrs[2].index_immediate());
+  EXPECT_EQ(Opcode::End, instrs[3].opcode());
+  EXPECT_EQ((std::vector<u32>{0, 2, 0, 2}), actual->code.offsets);
+}
+
+TEST_F(BinaryReadModuleTest, PackedModuleErrorsMatch) {
+  auto data =
+      "\0asm\x01\0\0\0"
+      "\x01\x04\x01\x60\x00\x00"
+      "\x03\x03\x02\x00\x00"
+      // code: (func i32.const <truncated>) (func br_table <truncated>)
+      "\x0a\x09\x02\x03\x00\x41\x80\x03\x00\x0e\x01"_su8;
+  auto expected = ReadModule(data, ctx);
+  EXPECT_FALSE(expected.has_value());
+  auto expected_errors = errors.errors;
+  errors.Clear();
+
+  auto actual = ReadPackedModule(data, ctx);
+  EXPECT_FALSE(actual.has_value());
+  ExpectErrors(expected_errors, errors);
+}
+
+TEST_F(BinaryReadModuleTest, ParallelModule) {
+  auto data =
+      "\0asm\x01\0\0\0"
+      "\x01\x05\x01\x60\x00\x01\x7f"
+      "\x03\x05\x04\x00\x00\x00\x00"
+      // code: (func i32.const 42)
+      //       (func (local i32) local.get 0)
+      //       (func block (result i32) i32.const 1 end)
+      //       (func i32.const 0 i32.eqz)
+      "\x0a\x1b\x04"
+      "\x04\x00\x41\x2a\x0b"
+      "\x06\x01\x01\x7f\x20\x00\x0b"
+      "\x07\x00\x02\x7f\x41\x01\x0b\x0b"
+      "\x05\x00\x41\x00\x45\x0b"_su8;
+  auto expected = ReadModule(data, ctx);
+  ExpectNoErrors(errors);
+  ASSERT_TRUE(expected.has_value());
+
+  auto actual = ReadModule(data, ctx, 4);
+  ExpectNoErrors(errors);
+  ASSERT_TRUE(actual.has_value());
+  ASSERT_EQ(4u, actual->codes.size());
+  EXPECT_EQ(*expected, *actual);
+}
+
+TEST_F(BinaryReadModuleTest, ParallelModuleErrorsMatch) {
+  auto data =
+      "\0asm\x01\0\0\0"
+      "\x01\x04\x01\x60\x00\x00"
+      "\x03\x03\x02\x00\x00"
+      // code: (func i32.const <truncated>) (func br_table <truncated>)
+      "\x0a\x09\x02\x03\x00\x41\x80\x03\x00\x0e\x01"_su8;
+  auto expected = ReadModule(data, ctx);
+  EXPECT_FALSE(expected.has_value());
+  auto expected_errors = errors.errors;
+  errors.Clear();
+
+  auto actual = ReadModule(data, ctx, 4);
+  EXPECT_FALSE(actual.has_value());
+  ExpectErrors(expected_errors, errors);
+}
+
+TEST_F(BinaryReadModuleTest, ParallelModuleLocalsErrorsMatch) {
+  auto data =
+      "\0asm\x01\0\0\0"
+      "\x01\x04\x01\x60\x00\x00"
+      "\x03\x03\x02\x00\x00"
+      // code: (func i32.const <truncated>) (func (local <truncated>))
+      "\x0a\x08\x02\x03\x00\x41\x80\x02\x01\x05"_su8;
+  auto expected = ReadModule(data, ctx);
+  EXPECT_FALSE(expected.has_value());
+  auto expected_errors = errors.errors;
+  errors.Clear();
+
+  auto actual = ReadModule(data, ctx, 4);
+  EXPECT_FALSE(actual.has_value());
+  ExpectErrors(expected_errors, errors);
+}
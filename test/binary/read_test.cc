@@ -28,6 +28,7 @@
 #include "wasp/binary/read/read_ctx.h"
 #include "wasp/binary/read/read_vector.h"
 
+#include "wasp/base/buffer.h"
 #include "wasp/base/concat.h"
 
 using namespace ::wasp;
@@ -3914,6 +3915,56 @@ TEST_F(BinaryReadTest, U32_PastEnd) {
        "\xf0\xf0\xf0\xf0"_su8);
 }
 
+TEST_F(BinaryReadTest, VarInt_TrailingData) {
+  // With at least 8 bytes available the reader takes a word-at-a-time path,
+  // so check that it stops at the right byte and matches the byte-wise path.
+  auto check = [&](auto&& func, auto expected, SpanU8 encoding) {
+    Buffer buffer{encoding.begin(), encoding.end()};
+    buffer.insert(buffer.end(), 8, 0xff);
+    SpanU8 data{buffer};
+    auto actual = func(&data, ctx);
+    ExpectNoErrors(errors);
+    ASSERT_TRUE(actual.has_value());
+    EXPECT_EQ(expected, **actual);
+    EXPECT_EQ(8u, data.size());
+    EXPECT_EQ(encoding.size(), actual->loc().size());
+  };
+
+  check(Read<u32>, 32u, "\x20"_su8);
+  check(Read<u32>, 448u, "\xc0\x03"_su8);
+  check(Read<u32>, 33360u, "\xd0\x84\x02"_su8);
+  check(Read<u32>, 101718048u, "\xa0\xb0\xc0\x30"_su8);
+  check(Read<u32>, 1042036848u, "\xf0\xf0\xf0\xf0\x03"_su8);
+  check(Read<u32>, 0u, "\x80\x80\x80\x00"_su8);
+
+  check(Read<s32>, -16, "\x70"_su8);
+  check(Read<s32>, -3648, "\xc0\x63"_su8);
+  check(Read<s32>, -753072, "\xd0\x84\x52"_su8);
+  check(Read<s32>, -32499680, "\xa0\xb0\xc0\x70"_su8);
+  check(Read<s32>, -837011344, "\xf0\xf0\xf0\xf0\x7c"_su8);
+
+  check(Read<s64>, 13893120096, "\xe0\xe0\xe0\xe0\x33"_su8);
+  check(Read<s64>, -12413554592, "\xe0\xe0\xe0\xe0\x51"_su8);
+  check(Read<s64>, 139105536057408, "\xc0\xc0\xc0\xc0\xc0\xd0\x1f"_su8);
+  check(Read<s64>, -12172681868045014,
+        "\xaa\xaa\xaa\xaa\xaa\xa0\xb0\x6a"_su8);
+  check(Read<s64>, -3540960223848057090,
+        "\xfe\xed\xfe\xed\xfe\xed\xfe\xed\x4e"_su8);
+}
+
+TEST_F(BinaryReadTest, VarInt_TooLongTrailingData) {
+  Fail(Read<u32>,
+       {{0, "u32"},
+        {4, "Last byte of u32 must be zero extension: expected 0x2, got 0x12"}},
+       "\xf0\xf0\xf0\xf0\x12\x00\x00\x00"_su8);
+  Fail(Read<s32>,
+       {{0, "s32"},
+        {4,
+         "Last byte of s32 must be sign extension: expected "
+         "0x5 or 0x7d, got 0x15"}},
+       "\xf0\xf0\xf0\xf0\x15\x00\x00\x00"_su8);
+}
+
 TEST_F(BinaryReadTest, U8) {
   OK(Read<u8>, 32, "\x20"_su8);
   Fail(Read<u8>, {{0, "Unable to read u8"}}, ""_su8);
@@ -0,0 +1,227 @@
+//
+// Copyright 2020 WebAssembly Community Group participants
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//     http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+//
+
+#include "wasp/binary/visit_stream.h"
+
+#include <algorithm>
+#include <string>
+#include <vector>
+
+#include "gtest/gtest.h"
+#include "test/test_utils.h"
+#include "wasp/base/concat.h"
+#include "wasp/base/features.h"
+#include "wasp/binary/formatters.h"
+#include "wasp/binary/lazy_module.h"
+#include "wasp/binary/visitor.h"
+
+using namespace ::wasp;
+using namespace ::wasp::binary;
+using namespace ::wasp::test;
+
+namespace {
+
+// Same module as in visitor_test.cc.
+const u8 kTestModule[] = {
+    0x00, 0x61, 0x73, 0x6d, 0x01, 0x00, 0x00, 0x00, 0x01, 0x0e, 0x03, 0x60,
+    0x01, 0x7f, 0x01, 0x7f, 0x60, 0x01, 0x7d, 0x01, 0x7d, 0x60, 0x00, 0x00,
+    0x02, 0x0b, 0x01, 0x03, 0x66, 0x6f, 0x6f, 0x03, 0x62, 0x61, 0x72, 0x00,
+    0x00, 0x03, 0x03, 0x02, 0x01, 0x02, 0x04, 0x05, 0x01, 0x70, 0x01, 0x01,
+    0x02, 0x05, 0x03, 0x01, 0x00, 0x01, 0x06, 0x06, 0x01, 0x7f, 0x00, 0x41,
+    0x01, 0x0b, 0x07, 0x08, 0x01, 0x04, 0x71, 0x75, 0x75, 0x78, 0x00, 0x01,
+    0x08, 0x01, 0x02, 0x09, 0x08, 0x01, 0x00, 0x41, 0x00, 0x0b, 0x02, 0x00,
+    0x01, 0x0a, 0x0c, 0x02, 0x07, 0x00, 0x43, 0x00, 0x00, 0x28, 0x42, 0x0b,
+    0x02, 0x00, 0x0b, 0x0b, 0x0b, 0x01, 0x00, 0x41, 0x02, 0x0b, 0x05, 0x68,
+    0x65, 0x6c, 0x6c, 0x6f,
+};
+
+// kTestModule with a data count section before the code section. Its id
+// (0x0c) comes after the code section's (0x0a), even though the section comes
+// before it.
+std::vector<u8> MakeDataCountModule() {
+  std::vector<u8> data{std::begin(kTestModule), std::end(kTestModule)};
+  const u8 data_count[] = {0x0c, 0x01, 0x01};
+  data.insert(data.begin() + 85, std::begin(data_count), std::end(data_count));
+  return data;
+}
+
+// Records every callback. The code section's OnSection is recorded without
+// its contents, since Stream doesn't have them yet.
+struct RecordingVisitor : visit::Visitor {
+  using Result = visit::Result;
+
+  Result BeginModule(LazyModule&) { return Log("BeginModule"); }
+  Result EndModule(LazyModule&) { return Log("EndModule"); }
+  Result OnSection(At<Section> section) {
+    if (section->is_known()) {
+      return Log(concat("OnSection ", section->known()->id));
+    }
+    return Log(concat("OnSection ", section->custom()->name));
+  }
+  Result BeginTypeSection(LazyTypeSection) { return Log("BeginTypeSection"); }
+  Result OnType(const At<DefinedType>& x) { return Log(concat("OnType ", x)); }
+  Result OnImport(const At<Import>& x) { return Log(concat("OnImport ", x)); }
+  Result OnFunction(const At<Function>& x) {
+    return Log(concat("OnFunction ", x));
+  }
+  Result OnTable(const At<Table>& x) { return Log(concat("OnTable ", x)); }
+  Result OnMemory(const At<Memory>& x) { return Log(concat("OnMemory ", x)); }
+  Result OnGlobal(const At<Global>& x) { return Log(concat("OnGlobal ", x)); }
+  Result OnExport(const At<Export>& x) { return Log(concat("OnExport ", x)); }
+  Result OnStart(const At<Start>& x) { return Log(concat("OnStart ", x)); }
+  Result OnElement(const At<ElementSegment>& x) {
+    return Log(concat("OnElement ", x));
+  }
+  Result OnDataCount(const At<DataCount>& x) {
+    return Log(concat("OnDataCount ", x));
+  }
+  Result BeginCodeSection(LazyCodeSection sec) {
+    Log(concat("BeginCodeSection ", sec.count.value_or(0)));
+    return code_section_result;
+  }
+  Result BeginCode(const At<Code>& x) { return Log(concat("BeginCode ", x)); }
+  Result OnInstruction(const At<Instruction>& x) {
+    return Log(concat("OnInstruction ", x));
+  }
+  Result EndCode(const At<Code>&) { return Log("EndCode"); }
+  Result EndCodeSection(LazyCodeSection) { return Log("EndCodeSection"); }
+  Result OnData(const At<DataSegment>& x) { return Log(concat("OnData ", x)); }
+
+  Result Log(std::string str) {
+    log.push_back(str);
+    return Result::Ok;
+  }
+
+  Result code_section_result = Result::Ok;
+  std::vector<std::string> log;
+};
+
+std::vector<std::string> VisitWhole(SpanU8 data,
+                                    visit::Result code_section_result) {
+  Features features;
+  TestErrors errors;
+  RecordingVisitor visitor;
+  visitor.code_section_result = code_section_result;
+  auto module = ReadLazyModule(data, features, errors);
+  EXPECT_EQ(visit::Result::Ok, visit::Visit(module, visitor));
+  ExpectNoErrors(errors);
+  return visitor.log;
+}
+
+// Appends `data` to a Stream in chunks of `chunk_size` bytes, then finishes.
+visit::Result VisitChunked(SpanU8 data,
+                           size_t chunk_size,
+                           Errors& errors,
+                           RecordingVisitor& visitor) {
+  Features features;
+  visit::Stream<RecordingVisitor> stream{features, errors, visitor};
+  while (!data.empty()) {
+    auto chunk = data.first(std::min(data.size(), chunk_size));
+    data.remove_prefix(chunk.size());
+    if (stream.Append(chunk) == visit::Result::Fail) {
+      return visit::Result::Fail;
+    }
+  }
+  return stream.Finish();
+}
+
+}  // namespace
+
+TEST(BinaryVisitStreamTest, MatchesVisit) {
+  auto expected = VisitWhole(SpanU8{kTestModule}, visit::Result::Ok);
+  for (size_t chunk_size : {1, 2, 3, 7, 16, int(sizeof(kTestModule))}) {
+    SCOPED_TRACE(concat("chunk size ", chunk_size));
+    TestErrors errors;
+    RecordingVisitor visitor;
+    EXPECT_EQ(visit::Result::Ok,
+              VisitChunked(SpanU8{kTestModule}, chunk_size, errors, visitor));
+    ExpectNoErrors(errors);
+    EXPECT_EQ(expected, visitor.log);
+  }
+}
+
+TEST(BinaryVisitStreamTest, SkipCodeSection) {
+  auto expected = VisitWhole(SpanU8{kTestModule}, visit::Result::Skip);
+  for (size_t chunk_size : {1, 5, int(sizeof(kTestModule))}) {
+    SCOPED_TRACE(concat("chunk size ", chunk_size));
+    TestErrors errors;
+    RecordingVisitor visitor;
+    visitor.code_section_result = visit::Result::Skip;
+    EXPECT_EQ(visit::Result::Ok,
+              VisitChunked(SpanU8{kTestModule}, chunk_size, errors, visitor));
+    ExpectNoErrors(errors);
+    EXPECT_EQ(expected, visitor.log);
+  }
+}
+
+TEST(BinaryVisitStreamTest, Truncated) {
+  // Cut the module off in the header, in the middle of a section, and in the
+  // middle of a function body.
+  for (size_t size : {4, 30, 94}) {
+    SCOPED_TRACE(concat("size ", size));
+    TestErrors errors;
+    RecordingVisitor visitor;
+    EXPECT_EQ(visit::Result::Fail,
+              VisitChunked(SpanU8{kTestModule, size}, 3, errors, visitor));
+    EXPECT_FALSE(errors.errors.empty());
+    EXPECT_TRUE(visitor.log.empty() || visitor.log.back() != "EndModule");
+  }
+}
+
+TEST(BinaryVisitStreamTest, CodeCountMismatch) {
+  // The code section claims 3 bodies, but only has 2.
+  std::vector<u8> data{std::begin(kTestModule), std::end(kTestModule)};
+  data[87] = 0x03;
+  TestErrors errors;
+  RecordingVisitor visitor;
+  EXPECT_EQ(visit::Result::Ok, VisitChunked(data, 4, errors, visitor));
+  ASSERT_EQ(1u, errors.errors.size());
+  EXPECT_EQ("Expected code section to have count 3, got 2",
+            errors.errors[0].back().message);
+}
+
+TEST(BinaryVisitStreamTest, DataCount) {
+  auto data = MakeDataCountModule();
+  auto expected = VisitWhole(data, visit::Result::Ok);
+  for (size_t chunk_size : {1, 2, 3, 7, 16, int(data.size())}) {
+    SCOPED_TRACE(concat("chunk size ", chunk_size));
+    TestErrors errors;
+    RecordingVisitor visitor;
+    EXPECT_EQ(visit::Result::Ok,
+              VisitChunked(data, chunk_size, errors, visitor));
+    ExpectNoErrors(errors);
+    EXPECT_EQ(expected, visitor.log);
+  }
+}
+
+TEST(BinaryVisitStreamTest, CodeBeforeEndOfSection) {
+  // Stop in the middle of the second function body; the first body must
+  // already have been visited.
+  Features features;
+  TestErrors errors;
+  RecordingVisitor visitor;
+  visit::Stream<RecordingVisitor> stream{features, errors, visitor};
+  EXPECT_EQ(visit::Result::Ok, stream.Append(SpanU8{kTestModule, 97}));
+  ExpectNoErrors(errors);
+  EXPECT_EQ(1, std::count(visitor.log.begin(), visitor.log.end(), "EndCode"));
+  EXPECT_EQ(visitor.log.end(), std::find(visitor.log.begin(), visitor.log.end(),
+                                         "EndCodeSection"));
+
+  EXPECT_EQ(visit::Result::Ok, stream.Append(SpanU8{kTestModule}.subspan(97)));
+  EXPECT_EQ(visit::Result::Ok, stream.Finish());
+  ExpectNoErrors(errors);
+  EXPECT_EQ(VisitWhole(SpanU8{kTestModule}, visit::Result::Ok), visitor.log);
+}
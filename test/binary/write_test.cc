@@ -47,6 +47,18 @@ void ExpectWrite(SpanU8 expected, const T& value) {
   EXPECT_EQ(expected, SpanU8{result});
 }
 
+// Also checks that WriteModule produces the same result, with and without
+// threads.
+void ExpectWrite(SpanU8 expected, const Module& value) {
+  ExpectWrite<Module>(expected, value);
+
+  for (Index num_threads : {1, 4}) {
+    Buffer result;
+    WriteModule(value, result, CompactSizes::Yes, num_threads);
+    EXPECT_EQ(expected, SpanU8{result}) << num_threads << " threads";
+  }
+}
+
 }  // namespace
 
 TEST(BinaryWriteTest, ArrayType) {
@@ -1383,6 +1395,63 @@ TEST(BinaryWriteTest, Module_Code) {
       module);
 }
 
+TEST(BinaryWriteTest, Module_Code_PaddedSizes) {
+  Module module;
+  module.codes.push_back(
+      UnpackedCode{LocalsList{}, UnpackedExpression{InstructionList{
+                                     Instruction{Opcode::End},
+                                 }}});
+
+  Buffer result;
+  WriteModule(module, result, CompactSizes::No);
+  EXPECT_EQ(
+      "\x00\x61\x73\x6d\x01\x00\x00\x00"  // magic/version
+      "\x0a"                              // code section
+      "\x88\x80\x80\x80\x00"              // section length
+      "\x01"                              // code count
+      "\x82\x80\x80\x80\x00"              // code 0 size
+      "\x00"                              // no locals
+      "\x0b"_su8,                         // end
+      SpanU8{result});
+}
+
+TEST(BinaryWriteTest, Module_Code_CompactLargeSizes) {
+  // Large enough that the compacted section and body sizes need more than one
+  // byte, and the section shrinks by the bytes saved in each body.
+  Module module;
+  InstructionList instructions(200, Instruction{Opcode::Nop});
+  instructions.push_back(Instruction{Opcode::End});
+  for (int i = 0; i < 3; ++i) {
+    module.codes.push_back(
+        UnpackedCode{LocalsList{}, UnpackedExpression{instructions}});
+  }
+
+  Buffer expected;
+  Write(module, std::back_inserter(expected));
+  Buffer result;
+  WriteModule(module, result);
+  EXPECT_EQ(SpanU8{expected}, SpanU8{result});
+}
+
+TEST(BinaryWriteTest, Module_Code_Parallel) {
+  Module module;
+  for (int i = 0; i < 100; ++i) {
+    InstructionList instructions(i * 3, Instruction{Opcode::Nop});
+    instructions.push_back(Instruction{Opcode::End});
+    module.codes.push_back(
+        UnpackedCode{LocalsList(i % 3, Locals{1, VT_I32}),
+                     UnpackedExpression{instructions}});
+  }
+
+  for (auto compact_sizes : {CompactSizes::No, CompactSizes::Yes}) {
+    Buffer expected;
+    WriteModule(module, expected, compact_sizes);
+    Buffer result;
+    WriteModule(module, result, compact_sizes, 4);
+    EXPECT_EQ(SpanU8{expected}, SpanU8{result});
+  }
+}
+
 TEST(BinaryWriteTest, Module_Data) {
   Module module;
   module.data_segments.push_back(DataSegment{"hi"_su8});
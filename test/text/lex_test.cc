@@ -17,6 +17,7 @@
 #include "wasp/text/read/lex.h"
 
 #include <algorithm>
+#include <string>
 #include <vector>
 
 #include "gtest/gtest.h"
@@ -144,6 +145,9 @@ TEST(LexTest, Reserved) {
   ExpectLex({8, TT::Reserved}, "23skidoo"_su8);
   ExpectLex({8, TT::Reserved}, "i32.addd"_su8);
   ExpectLex({5, TT::Reserved}, "32.5x"_su8);
+  ExpectLex({6, TT::Reserved}, "+infxy"_su8);
+  ExpectLex({5, TT::Reserved}, "nanxy"_su8);
+  ExpectLex({7, TT::Reserved}, "nan:0xg"_su8);
 }
 
 TEST(LexTest, Whitespace) {
@@ -157,6 +161,34 @@ TEST(LexTest, Whitespace) {
   ExpectLex({9, TT::Whitespace}, " \n\t \n\t \n\t"_su8);
 }
 
+TEST(LexTest, LongRuns) {
+  // Whitespace, comments and text are scanned 16 bytes at a time, so end each
+  // run at every offset around those blocks.
+  auto lex = [](const std::string& str, ExpectedToken et) {
+    ExpectLex(et, SpanU8{reinterpret_cast<const u8*>(str.data()), str.size()});
+  };
+  auto text = [](const std::string& str, span_extent_t size, u32 byte_size) {
+    return Text{string_view{str}.substr(0, size), byte_size};
+  };
+  for (u32 n = 0; n < 40; ++n) {
+    std::string run(n, 'a');
+    lex(std::string(n + 1, ' ') + "x", {n + 1, TT::Whitespace});
+    lex(std::string(n + 1, '\n') + "\t x", {n + 3, TT::Whitespace});
+    lex(";;" + run + "\nx", {n + 3, TT::LineComment});
+    lex(";;" + run, {n + 2, TT::InvalidLineComment});
+    lex("(;" + run + ";)x", {n + 4, TT::BlockComment});
+    lex("(;" + run + "(;;)" + run + ";)x", {2 * n + 8, TT::BlockComment});
+    lex("(;" + run, {n + 2, TT::InvalidBlockComment});
+    lex("\"" + run + "\n\"x", {n + 3, TT::InvalidText});
+    lex("\"" + run, {n + 1, TT::InvalidText});
+
+    std::string str = "\"" + run + "\"x";
+    lex(str, {n + 2, TT::Text, text(str, n + 2, n)});
+    str = "\"" + run + "\\n" + run + "\"x";
+    lex(str, {2 * n + 4, TT::Text, text(str, 2 * n + 4, 2 * n + 1)});
+  }
+}
+
 TEST(LexTest, AlignEqNat) {
   ExpectLex({9, TT::AlignEqNat, LI::Nat(HU::No)}, "align=123"_su8);
   ExpectLex({11, TT::AlignEqNat, LI::Nat(HU::Yes)}, "align=1_234"_su8);
@@ -1077,6 +1109,38 @@ TEST(LexTest, Text) {
   }
 }
 
+TEST(LexTest, Text_Utf8) {
+  struct {
+    SpanU8 span;
+    HasEscapes has_escapes;
+    Utf8Validity utf8;
+  } tests[] = {
+      {R"("")"_su8, HasEscapes::No, Utf8Validity::Valid},
+      {"\"caf\xc3\xa9\""_su8, HasEscapes::No, Utf8Validity::Valid},
+      {"\"caf\xc3\""_su8, HasEscapes::No, Utf8Validity::Invalid},
+      {"\"\xff\""_su8, HasEscapes::No, Utf8Validity::Invalid},
+      {R"("a\tb")"_su8, HasEscapes::Yes, Utf8Validity::Valid},
+      {R"("\ee\b8\96")"_su8, HasEscapes::Yes, Utf8Validity::Valid},
+      {R"("\80")"_su8, HasEscapes::Yes, Utf8Validity::Invalid},
+      {R"("\c3")"_su8, HasEscapes::Yes, Utf8Validity::Invalid},
+      {R"("\c3\n")"_su8, HasEscapes::Yes, Utf8Validity::Invalid},
+
+      // A sequence can be split between escapes and unescaped bytes.
+      {"\"\\e6\x97\xa5\""_su8, HasEscapes::Yes, Utf8Validity::Valid},
+      {"\"\xe6\\97\xa5\""_su8, HasEscapes::Yes, Utf8Validity::Valid},
+      {"\"\xe6\x97\\a5\""_su8, HasEscapes::Yes, Utf8Validity::Valid},
+      {"\"\xe6\\97\""_su8, HasEscapes::Yes, Utf8Validity::Invalid},
+  };
+  for (auto test : tests) {
+    SpanU8 data = test.span;
+    auto token = Lex(&data);
+    ASSERT_EQ(TokenType::Text, token.type) << ToStringView(test.span);
+    EXPECT_EQ(test.has_escapes, token.text().has_escapes)
+        << ToStringView(test.span);
+    EXPECT_EQ(test.utf8, token.text().utf8) << ToStringView(test.span);
+  }
+}
+
 TEST(LexTest, NumericType) {
   struct {
     SpanU8 span;
@@ -128,3 +128,39 @@ TEST(TextNameMapTest, LetBindings) {
   ExpectGet(map, "$a"_sv, 0);
   ExpectGet(map, "$c"_sv, 2);
 }
+
+TEST(TextNameMapTest, PopRestoresShadowedNames) {
+  NameMap map;
+  map.NewBound("$a"_sv);
+  map.Push();
+  map.Push();  // Empty scope.
+  map.NewBound("$a"_sv);
+  map.NewBound("$b"_sv);
+  EXPECT_TRUE(map.HasSinceLastPush("$a"_sv));
+  ExpectGet(map, "$a"_sv, 0);
+  ExpectGet(map, "$b"_sv, 1);
+
+  map.Pop();
+  EXPECT_FALSE(map.HasSinceLastPush("$a"_sv));
+  EXPECT_FALSE(map.Has("$b"_sv));
+  ExpectGet(map, "$a"_sv, 0);
+  EXPECT_TRUE(map.NewBound("$a"_sv));
+  ExpectGet(map, "$a"_sv, 0);
+
+  map.Pop();
+  ExpectGet(map, "$a"_sv, 0);
+  EXPECT_FALSE(map.Has("$b"_sv));
+}
+
+TEST(TextNameMapTest, Reset) {
+  NameMap map;
+  map.NewBound("$a"_sv);
+  map.Push();
+  map.NewBound("$b"_sv);
+  map.Reset();
+  EXPECT_FALSE(map.Has("$a"_sv));
+  EXPECT_FALSE(map.Has("$b"_sv));
+  EXPECT_EQ(0u, map.Size());
+  EXPECT_TRUE(map.NewBound("$b"_sv));
+  ExpectGet(map, "$b"_sv, 0);
+}
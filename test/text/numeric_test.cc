@@ -16,8 +16,12 @@
 
 #include "wasp/text/numeric.h"
 
+#include <cmath>
 #include <cstring>
+#include <random>
+#include <string>
 
+#include "absl/strings/numbers.h"
 #include "gtest/gtest.h"
 #include "wasp/base/bitcast.h"
 
@@ -527,6 +531,153 @@ TEST(TextNumericTest, StrToFloat_f64_OutOfRange) {
 }
 
 
+TEST(TextNumericTest, StrToFloat_Ties) {
+  const auto none = LI::Number(Sign::None, HU::No);
+  const auto hex_none = LI::HexNumber(Sign::None, HU::No);
+
+  // Halfway cases round to even. Digits past the first 19 can break the tie.
+  ExpectFloat<f64, u64>("9007199254740993"_su8, none, 0x43400000'00000000ull);
+  ExpectFloat<f64, u64>("9007199254740995"_su8, none, 0x43400000'00000002ull);
+  ExpectFloat<f64, u64>("9007199254740993.0000000000000000001"_su8, none,
+                        0x43400000'00000001ull);
+  ExpectFloat<f64, u64>("9007199254740992.9999999999999999999"_su8, none,
+                        0x43400000'00000000ull);
+  ExpectFloat<f32, u32>("16777217"_su8, none, 0x4b800000);
+  ExpectFloat<f32, u32>("16777219"_su8, none, 0x4b800002);
+  ExpectFloat<f32, u32>("16777217.000000001"_su8, none, 0x4b800001);
+
+  ExpectFloat<f32, u32>("0x1.000001p0"_su8, hex_none, 0x3f800000);
+  ExpectFloat<f32, u32>("0x1.0000011p0"_su8, hex_none, 0x3f800001);
+  ExpectFloat<f32, u32>("0x1.000003p0"_su8, hex_none, 0x3f800002);
+  ExpectFloat<f32, u32>("0x1p-150"_su8, hex_none, 0x00000000);
+  ExpectFloat<f32, u32>("0x1.000001p-150"_su8, hex_none, 0x00000001);
+  ExpectFloat<f32, u32>("0x1.8p-149"_su8, hex_none, 0x00000002);
+  ExpectFloat<f32, u32>("0x1.fffffefffffffffffffp127"_su8, hex_none,
+                        0x7f7fffff);
+}
+
+namespace {
+
+// How StrToFloat used to parse normal literals: copy them without
+// underscores, then use Abseil.
+bool SimpleAto(const std::string& str, f32* value) {
+  return absl::SimpleAtof(str, value);
+}
+
+bool SimpleAto(const std::string& str, f64* value) {
+  return absl::SimpleAtod(str, value);
+}
+
+template <typename T>
+auto ReferenceStrToFloat(string_view str) -> optional<T> {
+  std::string copy;
+  for (char c : str) {
+    if (c != '_') {
+      copy += c;
+    }
+  }
+  T value;
+  if (!SimpleAto(copy, &value) || std::isinf(value)) {
+    return nullopt;
+  }
+  return value;
+}
+
+LiteralInfo FloatLiteralInfo(string_view str) {
+  auto sign = Sign::None;
+  if (str[0] == '-' || str[0] == '+') {
+    sign = str[0] == '-' ? Sign::Minus : Sign::Plus;
+    str.remove_prefix(1);
+  }
+  auto underscores = str.find('_') != string_view::npos ? HU::Yes : HU::No;
+  return str.substr(0, 2) == "0x" ? LI::HexNumber(sign, underscores)
+                                  : LI::Number(sign, underscores);
+}
+
+template <typename T>
+void ExpectSameAsReference(string_view str) {
+  using Int = typename FloatTraits<T>::Int;
+  auto span = SpanU8{reinterpret_cast<const u8*>(str.data()), str.size()};
+  auto expected = ReferenceStrToFloat<T>(str);
+  auto actual = StrToFloat<T>(FloatLiteralInfo(str), span);
+  ASSERT_EQ(expected.has_value(), actual.has_value()) << str;
+  if (expected) {
+    EXPECT_EQ(Bitcast<Int>(*expected), Bitcast<Int>(*actual)) << str;
+  }
+}
+
+// Every value written by FloatToStr must be read back exactly.
+template <typename T>
+void ExpectRoundTrip(typename FloatTraits<T>::Int bits) {
+  using Int = typename FloatTraits<T>::Int;
+  T value = Bitcast<T>(bits);
+  if (!std::isfinite(value)) {
+    return;
+  }
+  for (auto base : {Base::Decimal, Base::Hex}) {
+    auto str = FloatToStr(value, base);
+    auto span = SpanU8{reinterpret_cast<const u8*>(str.data()), str.size()};
+    auto actual = StrToFloat<T>(FloatLiteralInfo(str), span);
+    ASSERT_TRUE(actual.has_value()) << str;
+    EXPECT_EQ(bits, Bitcast<Int>(*actual)) << str;
+    ExpectSameAsReference<T>(str);
+  }
+}
+
+// A random literal with up to `max_digits` digits, underscores and an
+// exponent.
+std::string RandomFloatLiteral(std::mt19937_64& rng,
+                               bool hex,
+                               int max_digits) {
+  const char* digits = hex ? "0123456789abcdefABCDEF" : "0123456789";
+  int num_digits = hex ? 22 : 10;
+  std::string str = hex ? "0x" : "";
+  int count = 1 + rng() % max_digits;
+  int dot = rng() % 2 ? rng() % count : -1;
+  for (int i = 0; i < count; ++i) {
+    // Leading zeroes are common in fractions, e.g. 0.000123.
+    str += digits[rng() % 3 == 0 ? 0 : rng() % num_digits];
+    if (i == dot) {
+      str += '.';
+    } else if (i + 1 < count && rng() % 8 == 0) {
+      str += '_';
+    }
+  }
+  if (rng() % 4 != 0) {
+    int exp = hex ? int(rng() % 2400) - 1200 : int(rng() % 800) - 400;
+    str += (hex ? "p" : "e") + std::to_string(exp);
+  }
+  return str;
+}
+
+}  // namespace
+
+TEST(TextNumericTest, StrToFloat_f32_RoundTrip) {
+  // Every 4099th bit pattern, which covers every exponent.
+  for (u64 bits = 0; bits <= 0xffff'ffff; bits += 4099) {
+    ExpectRoundTrip<f32>(static_cast<u32>(bits));
+  }
+}
+
+TEST(TextNumericTest, StrToFloat_f64_RoundTrip) {
+  std::mt19937_64 rng{0};
+  for (int i = 0; i < 100000; ++i) {
+    ExpectRoundTrip<f64>(rng());
+  }
+}
+
+TEST(TextNumericTest, StrToFloat_SameAsReference) {
+  std::mt19937_64 rng{0};
+  for (int i = 0; i < 100000; ++i) {
+    for (bool hex : {false, true}) {
+      auto str = RandomFloatLiteral(rng, hex, 30);
+      ExpectSameAsReference<f32>(str);
+      ExpectSameAsReference<f64>(str);
+    }
+  }
+}
+
+
 TEST(TextNumericTest, NatToStr_u8) {
   struct {
     string_view result;
@@ -682,6 +833,8 @@ TEST(TextNumericTest, FloatToStr_f32) {
       {"3.40282347e+38", Base::Decimal, 0x7f7fffff},
       {"-3.40282347e+38", Base::Decimal, 0xff7fffff},
 
+      {"0x0p0", Base::Hex, 0x00000000},
+      {"-0x0p0", Base::Hex, 0x80000000},
       {"0x15p-4", Base::Hex, 0x3fa80000},
       {"-0x15p-4", Base::Hex, 0xbfa80000},
       {"0x9a5p-1", Base::Hex, 0x449a5000},
@@ -732,6 +885,8 @@ TEST(TextNumericTest, FloatToStr_f64) {
       {"1.7976931348623157e+308", Base::Decimal, 0x7fefffff'ffffffffull},
       {"-1.7976931348623157e+308", Base::Decimal, 0xffefffff'ffffffffull},
 
+      {"0x0p0", Base::Hex, 0x00000000'00000000ull},
+      {"-0x0p0", Base::Hex, 0x80000000'00000000ull},
       {"0x15p-4", Base::Hex, 0x3ff50000'00000000ull},
       {"-0x15p-4", Base::Hex, 0xbff50000'00000000ull},
       {"0x9a5p-1", Base::Hex, 0x40934a00'00000000ull},
@@ -168,6 +168,10 @@ TEST_F(TextReadTest, Text) {
 TEST_F(TextReadTest, Utf8Text) {
   OK(ReadUtf8Text, Text{"\"\\ee\\b8\\96\""_sv, 3}, "\"\\ee\\b8\\96\""_su8);
   Fail(ReadUtf8Text, {{0, "Invalid UTF-8 encoding"}}, "\"\\80\""_su8);
+
+  // Without escapes.
+  OK(ReadUtf8Text, Text{"\"\xee\xb8\x96\""_sv, 3}, "\"\xee\xb8\x96\""_su8);
+  Fail(ReadUtf8Text, {{0, "Invalid UTF-8 encoding"}}, "\"\x80\""_su8);
 }
 
 TEST_F(TextReadTest, TextList) {
@@ -242,6 +242,56 @@ TEST_F(TextResolveTest, FunctionTypeUse_DeferType) {
       defined_types[0]);
 }
 
+TEST_F(TextResolveTest, FunctionTypeUse_FirstMatch) {
+  FunctionTypeMap& ftm = ctx.function_type_map;
+
+  ftm.SkipIndex();
+  ftm.Define(BoundFunctionType{{BVT{nullopt, VT_I32}}, {}});
+  ftm.Define(BoundFunctionType{{BVT{"$a"_sv, VT_I32}}, {}});
+  ftm.Define(BoundFunctionType{{}, {VT_I32}});
+
+  EXPECT_EQ(1u, ftm.Use(FunctionType{{VT_I32}, {}}));
+  EXPECT_EQ(3u, ftm.Use(FunctionType{{}, {VT_I32}}));
+
+  // Same hash bucket candidates that differ only in params vs. results, or in
+  // reference types.
+  EXPECT_EQ(4u, ftm.Use(FunctionType{{VT_I32, VT_I32}, {}}));
+  EXPECT_EQ(5u, ftm.Use(FunctionType{{VT_I32}, {VT_I32}}));
+  EXPECT_EQ(6u, ftm.Use(FunctionType{{VT_Funcref}, {}}));
+  EXPECT_EQ(7u, ftm.Use(FunctionType{{VT_Externref}, {}}));
+  EXPECT_EQ(5u, ftm.Use(FunctionType{{VT_I32}, {VT_I32}}));
+  EXPECT_EQ(7u, ftm.Use(FunctionType{{VT_Externref}, {}}));
+
+  ftm.EndModule();
+  ASSERT_EQ(8u, ftm.Size());
+  EXPECT_EQ(6u, ftm.Use(FunctionType{{VT_Funcref}, {}}));
+  EXPECT_EQ(8u, ftm.Use(FunctionType{{VT_F64}, {}}));
+}
+
+TEST_F(TextResolveTest, FunctionTypeUse_ManyTypes) {
+  FunctionTypeMap& ftm = ctx.function_type_map;
+  const ValueType results[] = {VT_I32, VT_I64, VT_F32, VT_F64};
+
+  // Type i has i / 4 i32 params, and one result.
+  auto make = [&](Index i) {
+    return FunctionType{ValueTypeList(i / 4, At{VT_I32}), {results[i % 4]}};
+  };
+
+  const Index count = 400;
+  for (Index i = 0; i < count; ++i) {
+    EXPECT_EQ(i, ftm.Use(make(i)));
+  }
+  for (Index i = 0; i < count; ++i) {
+    EXPECT_EQ(i, ftm.Use(make(i)));
+  }
+
+  ftm.EndModule();
+  ASSERT_EQ(count, ftm.Size());
+  for (Index i = 0; i < count; ++i) {
+    EXPECT_EQ(i, ftm.Use(make(i)));
+  }
+}
+
 TEST_F(TextResolveTest, FunctionTypeUse_NoFunctionTypeInContext) {
   FunctionTypeUse type_use;
   Resolve(ctx, type_use);
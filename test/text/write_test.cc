@@ -14,12 +14,14 @@
 // limitations under the License.
 //
 
+#include <string>
 #include <vector>
 
 #include "gtest/gtest.h"
 
 #include "test/text/constants.h"
 #include "test/write_test_utils.h"
+#include "wasp/base/buffer.h"
 #include "wasp/base/errors.h"
 #include "wasp/text/formatters.h"
 #include "wasp/text/write.h"
@@ -1560,3 +1562,38 @@ TEST(TextWriteTest, Script) {
                               Text{"\"msg\"", 3}}}},
       });
 }
+
+TEST(TextWriteTest, Function_DeepIndent) {
+  // Deeper than the precomputed indentation.
+  const int kDepth = 40;
+  InstructionList instrs;
+  std::string expected = "(func";
+  for (int i = 0; i < kDepth; ++i) {
+    instrs.push_back(I{O::Block, BlockImmediate{}});
+    expected += "\n" + std::string(2 * (i + 1), ' ') + "block";
+  }
+  instrs.push_back(I{O::Nop});
+  expected += "\n" + std::string(2 * (kDepth + 1), ' ') + "nop";
+  for (int i = kDepth; i > 0; --i) {
+    instrs.push_back(I{O::End});
+    expected += "\n" + std::string(2 * i, ' ') + "end";
+  }
+  // The function's own end is not written.
+  instrs.push_back(I{O::End});
+  expected += ")";
+  ExpectWrite(expected, Function{{}, {}, instrs, {}});
+}
+
+TEST(TextWriteTest, BufferInserter) {
+  WriteCtx ctx;
+  Buffer buffer;
+  Write(ctx,
+        Function{{},
+                 {},
+                 InstructionList{I{O::Block, BlockImmediate{}}, I{O::Nop},
+                                 I{O::End}, I{O::I32Const, s32{-1}}},
+                 {}},
+        BufferInserter{buffer});
+  EXPECT_EQ("(func\n  block\n    nop\n  end\n  i32.const -1)",
+            ToStringView(buffer));
+}
@@ -300,6 +300,24 @@ TEST_F(ValidateInstructionTest, Block_MultiResult) {
   ExpectNoErrors(errors);
 }
 
+TEST_F(ValidateInstructionTest, Block_MultiResult_MoreTypesAdded) {
+  // The block's label refers to the cached stack types of type `index`, so
+  // they must stay valid when more types are cached.
+  auto index = AddFunctionType(FunctionType{{}, {VT_I32, VT_F32}});
+  Ok(I{O::Block, BlockType(index)});
+  for (int i = 0; i < 100; ++i) {
+    auto other = AddFunctionType(FunctionType{{}, {VT_I64}});
+    Ok(I{O::Block, BlockType(other)});
+    Ok(I{O::I64Const, s64{}});
+    Ok(I{O::End});
+    Ok(I{O::Drop});
+  }
+  Ok(I{O::I32Const, s32{}});
+  Ok(I{O::F32Const, s32{}});
+  Ok(I{O::End});
+  ExpectNoErrors(errors);
+}
+
 TEST_F(ValidateInstructionTest, Block_RefType) {
   auto index = AddFunctionType(FunctionType{{VT_Ref0}, {}});
 
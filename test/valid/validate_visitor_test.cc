@@ -0,0 +1,163 @@
+//
+// Copyright 2020 WebAssembly Community Group participants
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//     http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+//
+
+#include "wasp/valid/validate_visitor.h"
+
+#include <algorithm>
+#include <string>
+#include <vector>
+
+#include "gtest/gtest.h"
+#include "test/test_utils.h"
+#include "wasp/base/features.h"
+#include "wasp/binary/lazy_module.h"
+#include "wasp/binary/visit_stream.h"
+#include "wasp/binary/visitor.h"
+
+using namespace ::wasp;
+using namespace ::wasp::binary;
+using namespace ::wasp::valid;
+using namespace ::wasp::test;
+
+namespace {
+
+visit::Result ValidateModule(SpanU8 data, TestErrors& errors, Index threads) {
+  Features features;
+  auto module = ReadLazyModule(data, features, errors);
+  ValidateVisitor visitor{features, errors, threads};
+  return visit::Visit(module, visitor);
+}
+
+// Streams `data` in chunks of `chunk_size` bytes, so each function body is
+// gone before the end of the code section.
+visit::Result StreamModule(SpanU8 data,
+                           size_t chunk_size,
+                           TestErrors& errors,
+                           Index threads,
+                           size_t max_pending_copy_size = 4 * 1024 * 1024) {
+  Features features;
+  ValidateVisitor visitor{features, errors, threads};
+  visitor.max_pending_copy_size = max_pending_copy_size;
+  visit::Stream<ValidateVisitor> stream{features, errors, visitor};
+  while (!data.empty()) {
+    auto chunk = data.first(std::min(data.size(), chunk_size));
+    data.remove_prefix(chunk.size());
+    if (stream.Append(chunk) == visit::Result::Fail) {
+      return visit::Result::Fail;
+    }
+  }
+  return stream.Finish();
+}
+
+std::vector<std::string> Messages(const TestErrors& errors) {
+  std::vector<std::string> messages;
+  for (auto&& error : errors.errors) {
+    messages.push_back(error.back().message);
+  }
+  return messages;
+}
+
+// (type (func))
+// (func) (func) (func) ...
+const SpanU8 kValidModule =
+    "\0asm\x01\0\0\0"
+    "\x01\x04\x01\x60\0\0"
+    "\x03\x05\x04\0\0\0\0"
+    "\x0a\x11\x04"
+    "\x02\0\x0b"
+    "\x05\0\x41\x01\x1a\x0b"
+    "\x02\0\x0b"
+    "\x03\0\x01\x0b"_su8;
+
+// Same as above, but the second and fourth functions are invalid.
+const SpanU8 kInvalidModule =
+    "\0asm\x01\0\0\0"
+    "\x01\x04\x01\x60\0\0"
+    "\x03\x05\x04\0\0\0\0"
+    "\x0a\x10\x04"
+    "\x02\0\x0b"
+    "\x04\0\x41\x01\x0b"
+    "\x02\0\x0b"
+    "\x03\0\x1a\x0b"_su8;
+
+}  // namespace
+
+TEST(ValidateVisitorTest, Parallel) {
+  for (Index threads : {1, 2, 4}) {
+    TestErrors errors;
+    EXPECT_EQ(visit::Result::Ok, ValidateModule(kValidModule, errors, threads));
+    ExpectNoErrors(errors);
+  }
+}
+
+TEST(ValidateVisitorTest, Parallel_SameErrorsAsSequential) {
+  TestErrors expected;
+  EXPECT_EQ(visit::Result::Fail, ValidateModule(kInvalidModule, expected, 1));
+  ASSERT_FALSE(expected.errors.empty());
+
+  for (Index threads : {2, 4}) {
+    TestErrors errors;
+    EXPECT_EQ(visit::Result::Fail,
+              ValidateModule(kInvalidModule, errors, threads));
+    ExpectErrors(expected.errors, errors);
+  }
+}
+
+TEST(ValidateVisitorTest, Parallel_Stream) {
+  for (Index threads : {2, 4}) {
+    for (size_t chunk_size : {1, 3, 8}) {
+      TestErrors errors;
+      EXPECT_EQ(visit::Result::Ok,
+                StreamModule(kValidModule, chunk_size, errors, threads));
+      ExpectNoErrors(errors);
+    }
+  }
+}
+
+TEST(ValidateVisitorTest, Parallel_Stream_SameErrorsAsSequential) {
+  TestErrors expected;
+  EXPECT_EQ(visit::Result::Fail, StreamModule(kInvalidModule, 1, expected, 1));
+  ASSERT_FALSE(expected.errors.empty());
+
+  for (Index threads : {2, 4}) {
+    for (size_t chunk_size : {1, 3, 8}) {
+      TestErrors errors;
+      EXPECT_EQ(visit::Result::Fail,
+                StreamModule(kInvalidModule, chunk_size, errors, threads));
+      EXPECT_EQ(Messages(expected), Messages(errors));
+    }
+  }
+}
+
+TEST(ValidateVisitorTest, Parallel_Stream_Batches) {
+  TestErrors expected;
+  EXPECT_EQ(visit::Result::Fail, StreamModule(kInvalidModule, 1, expected, 1));
+  ASSERT_FALSE(expected.errors.empty());
+
+  // Validate the copied bodies every one or two functions, instead of at the
+  // end of the code section.
+  for (size_t max_size : {1, 8}) {
+    TestErrors errors;
+    EXPECT_EQ(visit::Result::Ok,
+              StreamModule(kValidModule, 3, errors, 2, max_size));
+    ExpectNoErrors(errors);
+
+    errors.Clear();
+    EXPECT_EQ(visit::Result::Fail,
+              StreamModule(kInvalidModule, 3, errors, 2, max_size));
+    EXPECT_EQ(Messages(expected), Messages(errors));
+  }
+}